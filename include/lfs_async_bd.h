@@ -0,0 +1,432 @@
+/***************************************************************************//**
+ * \file lfs_async_bd.h
+ *
+ * \brief
+ * Implements an asynchronous block device that runs the operations of another
+ * block device in a dedicated worker thread.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_async_bd Asynchronous Block Device
+ * \{
+ * * Runs the operations of a block device populated by
+ * \ref lfs_spi_flash_bd_create() or \ref lfs_sd_bd_create() in a dedicated
+ * worker thread that owns the device.
+ * * Requests are submitted with \ref lfs_async_bd_submit() and completed in
+ * the worker thread. Several requests can be submitted before the first one
+ * completes. Completion is reported through an optional callback, and the
+ * submitter can wait for a request with \ref lfs_async_bd_wait().
+ * * The order in which requests are executed is selected by
+ * \ref lfs_async_bd_order_t.
+ * * The lfs_config structure populated by \ref lfs_async_bd_create() submits
+ * each littlefs operation and waits for it, so littlefs and direct submitters
+ * can share the device.
+ * * With \ref LFS_ASYNC_BD_ORDER_PRIORITY, each request carries a priority
+ * class. Latency-sensitive reads can go first while bulk erases and
+ * compaction writes wait. A request passed \ref LFS_ASYNC_BD_AGING_LIMIT times
+ * is executed next, so low priority requests are not starved. The latency
+ * from submission to completion is recorded per class.
+ *
+ * The following sequence reads a block while the calling task continues:
+ * \code
+ * lfs_async_bd_request_init(&request);
+ * request.op = LFS_ASYNC_BD_OP_READ;
+ * request.block = 5U;
+ * request.off = 0U;
+ * request.buffer = data;
+ * request.size = sizeof(data);
+ * lfs_async_bd_submit(&async_cfg, &request);
+ * do_other_work();
+ * lfs_async_bd_wait(&request, CY_RTOS_NEVER_TIMEOUT);
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * Requires an RTOS: add COMPONENTS=RTOS_AWARE or DEFINES=LFS_THREADSAFE in
+ * the Makefile.
+ * * A request is owned by the driver from \ref lfs_async_bd_submit() until
+ * \ref lfs_async_bd_wait() returns CY_RSLT_SUCCESS or
+ * \ref lfs_async_bd_is_done() returns true, and must not be modified or
+ * released in the meantime. The callback runs in the worker thread before the
+ * request completes and must not release the request either.
+ * * The backing device must not be used directly while the asynchronous
+ * block device exists.
+ * * Scheduling applies to queued requests. An erase that has started is not
+ * interrupted.
+ */
+
+#ifndef LFS_ASYNC_BD_H            /* Guard against multiple inclusion */
+#define LFS_ASYNC_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+#include "cyabs_rtos.h"
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_async_bd_unlock and lfs_async_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',5,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Enable trace for this driver by defining this macro. You must also define the
+ * global trace enable macro LFS_YES_TRACE.
+ */
+#ifdef LFS_ASYNC_BD_YES_TRACE
+#define LFS_ASYNC_BD_TRACE(...) LFS_TRACE(__VA_ARGS__)
+#else
+#define LFS_ASYNC_BD_TRACE(...)
+#endif
+
+/** Maximum number of pending requests of direct submitters. The request of
+ * littlefs has a reserved slot on top of these.
+ */
+#ifndef LFS_ASYNC_BD_MAX_PENDING
+#define LFS_ASYNC_BD_MAX_PENDING                (32UL)
+#endif /* #ifndef LFS_ASYNC_BD_MAX_PENDING */
+
+/** The request was not queued because \ref LFS_ASYNC_BD_MAX_PENDING requests
+ * are pending.
+ */
+#define LFS_ASYNC_BD_RSLT_ERR_QUEUE_FULL        \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0400U)
+
+/** Number of times a request can be passed by requests of a higher priority
+ * before it is executed next.
+ */
+#ifndef LFS_ASYNC_BD_AGING_LIMIT
+#define LFS_ASYNC_BD_AGING_LIMIT                (8UL)
+#endif /* #ifndef LFS_ASYNC_BD_AGING_LIMIT */
+
+/** Number of priority classes. */
+#define LFS_ASYNC_BD_PRIORITIES                 (3UL)
+
+/** Priority class of a request. */
+typedef enum
+{
+    LFS_ASYNC_BD_PRIORITY_LOW,              /**< Bulk work, for example erases of littlefs */
+    LFS_ASYNC_BD_PRIORITY_NORMAL,           /**< Default; programs and syncs of littlefs */
+    LFS_ASYNC_BD_PRIORITY_HIGH              /**< Latency-sensitive work; reads of littlefs */
+} lfs_async_bd_priority_t;
+
+/** Returns a free-running time stamp, for example in microseconds. */
+typedef uint32_t (*lfs_async_bd_time_fn_t)(void);
+
+/** Latency statistics of a priority class. */
+typedef struct
+{
+    uint32_t count;                         /**< Number of completed requests */
+    uint64_t total_latency;                 /**< Sum of the times from submission to completion */
+    uint32_t max_latency;                   /**< Longest time from submission to completion */
+} lfs_async_bd_class_stats_t;
+
+/** Scheduler statistics. */
+typedef struct
+{
+    lfs_async_bd_class_stats_t classes[LFS_ASYNC_BD_PRIORITIES];    /**< Indexed by \ref lfs_async_bd_priority_t */
+    uint32_t reordered;                     /**< Number of requests executed before an earlier one */
+    uint32_t aged;                          /**< Number of requests that reached \ref LFS_ASYNC_BD_AGING_LIMIT */
+} lfs_async_bd_stats_t;
+
+/** Operation of a request. */
+typedef enum
+{
+    LFS_ASYNC_BD_OP_READ,                   /**< Reads size bytes into buffer */
+    LFS_ASYNC_BD_OP_PROG,                   /**< Programs size bytes from data */
+    LFS_ASYNC_BD_OP_ERASE,                  /**< Erases the block */
+    LFS_ASYNC_BD_OP_SYNC                    /**< Syncs the device */
+} lfs_async_bd_op_t;
+
+/** Order in which the worker thread executes the requests. */
+typedef enum
+{
+    /** Requests are executed in submission order. */
+    LFS_ASYNC_BD_ORDER_STRICT,
+    /** A read is executed before earlier program, erase and sync requests,
+     * unless one of them targets the same block. Requests other than reads
+     * keep their order.
+     */
+    LFS_ASYNC_BD_ORDER_READS_FIRST,
+    /** The request of the highest priority is executed first, unless it
+     * conflicts with an earlier request. Reads may pass each other; programs
+     * and erases do not pass requests on the same block, and syncs do not pass
+     * programs and erases, nor are passed by them.
+     */
+    LFS_ASYNC_BD_ORDER_PRIORITY
+} lfs_async_bd_order_t;
+
+/** Request of the asynchronous block device. */
+typedef struct lfs_async_bd_request lfs_async_bd_request_t;
+
+/** Called in the worker thread when a request completes. */
+typedef void (*lfs_async_bd_callback_t)(lfs_async_bd_request_t *request, void *arg);
+
+/** Request of the asynchronous block device. */
+struct lfs_async_bd_request
+{
+    lfs_async_bd_op_t op;                   /**< Operation */
+    lfs_block_t block;                      /**< Block number; not used by sync */
+    lfs_off_t off;                          /**< Offset in the block; used by read and prog */
+    void *buffer;                           /**< Destination of a read */
+    const void *data;                       /**< Source of a prog */
+    lfs_size_t size;                        /**< Number of bytes; used by read and prog */
+    lfs_async_bd_callback_t callback;       /**< Completion callback. Can be NULL. */
+    void *arg;                              /**< Argument of the callback */
+    /** Priority class; used by \ref LFS_ASYNC_BD_ORDER_PRIORITY. Set to
+     * \ref LFS_ASYNC_BD_PRIORITY_NORMAL by \ref lfs_async_bd_request_init().
+     */
+    lfs_async_bd_priority_t priority;
+    /** Result of the operation, valid after completion. */
+    volatile int result;
+
+    /** \cond INTERNAL */
+    volatile bool done;
+    cy_semaphore_t done_sema;
+    struct lfs_async_bd_request *next;
+    uint32_t submit_time;
+    uint32_t passed;
+    /** \endcond */
+};
+
+/** Configuration of an asynchronous block device. */
+typedef struct
+{
+    /** lfs_config structure of the backing device. */
+    const struct lfs_config *backing;
+    /** Execution order of the requests. */
+    lfs_async_bd_order_t order;
+    /** Stack of the worker thread. Can be NULL to let the RTOS allocate it. */
+    void *stack;
+    /** Size of the stack of the worker thread in bytes. */
+    uint32_t stack_size;
+    /** Priority of the worker thread. */
+    cy_thread_priority_t priority;
+    /** Time source used to measure the latency. Can be NULL. */
+    lfs_async_bd_time_fn_t get_time;
+} lfs_async_bd_config_t;
+
+/**
+ * Asynchronous block device object. The content of this structure is for
+ * internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    lfs_async_bd_config_t config;
+    cy_thread_t thread;
+    cy_mutex_t list_mutex;
+    cy_semaphore_t pending_sema;
+    lfs_async_bd_request_t *head;
+    lfs_async_bd_request_t *tail;
+    uint32_t pending;
+    lfs_async_bd_request_t lfs_request;
+    lfs_async_bd_stats_t stats;
+    volatile bool stop;
+    /** \endcond */
+} lfs_async_bd_t;
+
+/**
+ * \brief Initializes the asynchronous block device, starts the worker thread
+ * and populates the lfs_config structure with the values of the backing
+ * device.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param async Pointer to the asynchronous block device object.
+ * \param config Pointer to the configuration.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful; an error code
+ *          of the RTOS abstraction otherwise. On failure, the objects created
+ *          so far are deleted.
+ */
+cy_rslt_t lfs_async_bd_create(struct lfs_config *lfs_cfg, lfs_async_bd_t *async,
+        const lfs_async_bd_config_t *config);
+
+/**
+ * \brief Completes the submitted requests, stops the worker thread and
+ * de-initializes the asynchronous block device. The backing device is not
+ * destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_async_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Initializes a request. Must be called once before the request is
+ * submitted for the first time.
+ * \param request Pointer to the request.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful; an error code
+ *          of the RTOS abstraction otherwise.
+ */
+cy_rslt_t lfs_async_bd_request_init(lfs_async_bd_request_t *request);
+
+/**
+ * \brief De-initializes a request that is not pending.
+ * \param request Pointer to the request.
+ */
+void lfs_async_bd_request_deinit(lfs_async_bd_request_t *request);
+
+/**
+ * \brief Queues a request for the worker thread. Must not be called from an
+ * interrupt.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param request Pointer to an initialized request that is not pending.
+ * \returns CY_RSLT_SUCCESS if the request was queued;
+ *          \ref LFS_ASYNC_BD_RSLT_ERR_QUEUE_FULL or an error code of the RTOS
+ *          abstraction otherwise.
+ */
+cy_rslt_t lfs_async_bd_submit(const struct lfs_config *lfs_cfg, lfs_async_bd_request_t *request);
+
+/**
+ * \brief Waits until a submitted request completes.
+ * \param request Pointer to the request.
+ * \param timeout_ms Maximum time to wait in milliseconds, or
+ *        CY_RTOS_NEVER_TIMEOUT.
+ * \returns CY_RSLT_SUCCESS if the request completed; an error code of the
+ *          RTOS abstraction otherwise.
+ */
+cy_rslt_t lfs_async_bd_wait(lfs_async_bd_request_t *request, cy_time_t timeout_ms);
+
+/**
+ * \brief Checks whether a submitted request has completed.
+ * \param request Pointer to the request.
+ * \returns true if the request has completed; false otherwise.
+ */
+bool lfs_async_bd_is_done(const lfs_async_bd_request_t *request);
+
+/**
+ * \brief Returns the scheduler statistics.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param stats Pointer to the structure to store the statistics.
+ */
+void lfs_async_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_async_bd_stats_t *stats);
+
+/**
+ * \brief Resets the scheduler statistics to zero.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_async_bd_reset_stats(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Reads data through the worker thread and waits for the result.
+ * The request has the priority \ref LFS_ASYNC_BD_PRIORITY_HIGH.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns The result of the backing device; -1 if the request could not be
+ *          queued.
+ */
+int lfs_async_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data through the worker thread and waits for the result.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns The result of the backing device; -1 if the request could not be
+ *          queued.
+ */
+int lfs_async_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block through the worker thread and waits for the result.
+ * The request has the priority \ref LFS_ASYNC_BD_PRIORITY_LOW.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns The result of the backing device; -1 if the request could not be
+ *          queued.
+ */
+int lfs_async_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Syncs the device through the worker thread and waits for the result.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns The result of the backing device; -1 if the request could not be
+ *          queued.
+ */
+int lfs_async_bd_sync(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_async_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_async_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_async_bd */
@@ -0,0 +1,857 @@
+/***************************************************************************//**
+ * \file lfs_bd_compose.hpp
+ *
+ * \brief
+ * Implements a header-only C++ layer that composes block devices, caches,
+ * statistics and locking at compile time.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_bd_compose C++ Block Device Composition
+ * \{
+ * * Implements a header-only C++ layer that stacks caches, statistics and
+ * locking on the block devices of this library, resolved at compile time.
+ * * A stack is declared as a \ref lfs_compose::BlockDevice "BlockDevice" with
+ * a backend and a list of policies. Each policy wraps the layers listed
+ * before it, so the last policy is the one that littlefs calls.
+ * * The lfs_config callbacks are generated for the stack: littlefs calls one
+ * function per operation, in which all layers are inlined. A layer that is
+ * not listed is not compiled in, and a layer that does not handle an
+ * operation forwards it without code.
+ * * Backends:
+ *   - \ref lfs_compose::SpiFlashBackend "SpiFlashBackend":
+ *     \ref lfs_spi_flash_bd_create(), when the device has a SMIF block
+ *   - \ref lfs_compose::SdBackend "SdBackend": \ref lfs_sd_bd_create(), when
+ *     the device has an SDHC block
+ *   - \ref lfs_compose::RamBackend "RamBackend": \ref lfs_ram_bd_create()
+ *   - \ref lfs_compose::ConfigBackend "ConfigBackend": any lfs_config that is
+ *     already created, such as an \ref group_lfs_mirror_bd, called through
+ *     its function pointers
+ * * Policies:
+ *   - \ref lfs_compose::LineCache "LineCache<LineSize, Lines>": a
+ *     direct-mapped read cache of Lines lines of LineSize bytes
+ *   - \ref lfs_compose::Stats "Stats": counts the calls and bytes that reach
+ *     its position in the stack
+ *   - \ref lfs_compose::RtosLock "RtosLock": provides the lock of littlefs
+ *     with a recursive mutex of the layer, when COMPONENT_RTOS_AWARE or
+ *     LFS_THREADSAFE is defined
+ * * A policy is a class with a member alias template layer<Next> that
+ * derives from Next and hides the operations it handles: create(),
+ * destroy(), read(), prog(), erase(), sync(), and lock() and unlock() when
+ * LFS_THREADSAFE is defined. Applications can define their own policies in
+ * the same way.
+ *
+ * \code
+ * typedef lfs_compose::BlockDevice<lfs_compose::SpiFlashBackend,
+ *         lfs_compose::LineCache<256U, 16U>, lfs_compose::Stats,
+ *         lfs_compose::RtosLock> flash_bd_t;
+ *
+ * static flash_bd_t flash_bd;
+ *
+ * flash_bd.create(&serial_memory_obj);
+ * lfs_mount(&lfs, flash_bd.config());
+ * ...
+ * printf("%u reads, %u cache hits\n", (unsigned)flash_bd.stats().reads,
+ *        (unsigned)flash_bd.hits());
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * Requires C++11. No exceptions, RTTI or heap are used.
+ * * Define LFS_BD_COMPOSE_NO_HAL to use the header without the HAL, for
+ * example in a host tool. Only the RAM and lfs_config backends are then
+ * available.
+ * * The layers are members of the stack object, so a stack with a
+ * \ref lfs_compose::LineCache "LineCache" must be allocated statically or on
+ * a stack that is large enough for its lines.
+ * * The object must not be moved or copied after create(), because its
+ * lfs_config points to it.
+ */
+
+#ifndef LFS_BD_COMPOSE_HPP            /* Guard against multiple inclusion */
+#define LFS_BD_COMPOSE_HPP
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_ram_bd.h"
+#include "cy_result.h"
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if !defined(LFS_BD_COMPOSE_NO_HAL)
+#include "lfs_spi_flash_bd.h"
+#include "lfs_sd_bd.h"
+#endif /* #if !defined(LFS_BD_COMPOSE_NO_HAL) */
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+#include "cyabs_rtos.h"
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
+
+/** The block size of the backing device is not a multiple of the line size of
+ * a \ref lfs_compose::LineCache "LineCache", or the line size is not a
+ * multiple of its read size.
+ */
+#define LFS_BD_COMPOSE_RSLT_ERR_LINE_SIZE       \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0800U)
+
+/** Timeout in milliseconds to get the mutex of a
+ * \ref lfs_compose::RtosLock "RtosLock".
+ */
+#ifndef LFS_BD_COMPOSE_GET_MUTEX_TIMEOUT_MS
+#define LFS_BD_COMPOSE_GET_MUTEX_TIMEOUT_MS     (500U)
+#endif /* #ifndef LFS_BD_COMPOSE_GET_MUTEX_TIMEOUT_MS */
+
+/** Block device composition. */
+namespace lfs_compose
+{
+
+/** \cond INTERNAL */
+namespace detail
+{
+
+template <class Base, class... Policies>
+struct Stack;
+
+template <class Base>
+struct Stack<Base>
+{
+    typedef Base type;
+};
+
+/* Each policy wraps the layers before it. */
+template <class Base, class Policy, class... Rest>
+struct Stack<Base, Policy, Rest...>
+{
+    typedef typename Stack<typename Policy::template layer<Base>, Rest...>::type type;
+};
+
+} /* namespace detail */
+/** \endcond */
+
+/**
+ * Backend that calls the functions of a C driver directly. Driver is a traits
+ * class that names the object and the functions of the driver.
+ */
+template <class Driver>
+class DriverBackend
+{
+public:
+    /**
+     * \brief Creates the driver.
+     * \param args Arguments of the create function of the driver after the
+     *        lfs_config structure.
+     * \returns The result of the create function of the driver.
+     */
+    template <class... Args>
+    cy_rslt_t create(Args&&... args)
+    {
+        return Driver::create(&backing_, std::forward<Args>(args)...);
+    }
+
+    /** \brief Destroys the driver. */
+    void destroy()
+    {
+        Driver::destroy(&backing_);
+    }
+
+    /** \brief Reads data. \returns The result of the driver. */
+    int read(lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
+    {
+        return Driver::read(&backing_, block, off, buffer, size);
+    }
+
+    /** \brief Programs data. \returns The result of the driver. */
+    int prog(lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
+    {
+        return Driver::prog(&backing_, block, off, buffer, size);
+    }
+
+    /** \brief Erases a block. \returns The result of the driver. */
+    int erase(lfs_block_t block)
+    {
+        return Driver::erase(&backing_, block);
+    }
+
+    /** \brief Syncs the driver. \returns The result of the driver. */
+    int sync()
+    {
+        return Driver::sync(&backing_);
+    }
+
+#if defined(LFS_THREADSAFE)
+    /** \brief Locks the driver. \returns The result of the driver. */
+    int lock()
+    {
+        return Driver::lock(&backing_);
+    }
+
+    /** \brief Unlocks the driver. \returns The result of the driver. */
+    int unlock()
+    {
+        return Driver::unlock(&backing_);
+    }
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /** \brief Returns the lfs_config structure populated by the driver. */
+    const struct lfs_config &backing_config() const
+    {
+        return backing_;
+    }
+
+private:
+    struct lfs_config backing_;
+};
+
+/** \cond INTERNAL */
+namespace detail
+{
+
+struct RamDriver
+{
+    static cy_rslt_t create(struct lfs_config *lfs_cfg, lfs_ram_bd_t *ram,
+            const lfs_ram_bd_config_t *config)
+    {
+        return lfs_ram_bd_create(lfs_cfg, ram, config);
+    }
+    static void destroy(const struct lfs_config *lfs_cfg) { lfs_ram_bd_destroy(lfs_cfg); }
+    static int read(const struct lfs_config *lfs_cfg, lfs_block_t block, lfs_off_t off,
+            void *buffer, lfs_size_t size) { return lfs_ram_bd_read(lfs_cfg, block, off, buffer, size); }
+    static int prog(const struct lfs_config *lfs_cfg, lfs_block_t block, lfs_off_t off,
+            const void *buffer, lfs_size_t size) { return lfs_ram_bd_prog(lfs_cfg, block, off, buffer, size); }
+    static int erase(const struct lfs_config *lfs_cfg, lfs_block_t block) { return lfs_ram_bd_erase(lfs_cfg, block); }
+    static int sync(const struct lfs_config *lfs_cfg) { return lfs_ram_bd_sync(lfs_cfg); }
+#if defined(LFS_THREADSAFE)
+    static int lock(const struct lfs_config *lfs_cfg) { return lfs_ram_bd_lock(lfs_cfg); }
+    static int unlock(const struct lfs_config *lfs_cfg) { return lfs_ram_bd_unlock(lfs_cfg); }
+#endif /* #if defined(LFS_THREADSAFE) */
+};
+
+#if defined(CY_IP_MXSMIF) && !defined(LFS_BD_COMPOSE_NO_HAL)
+struct SpiFlashDriver
+{
+    static cy_rslt_t create(struct lfs_config *lfs_cfg, mtb_serial_memory_t *serial_memory_obj)
+    {
+        return lfs_spi_flash_bd_create(lfs_cfg, serial_memory_obj);
+    }
+    static void destroy(const struct lfs_config *lfs_cfg) { lfs_spi_flash_bd_destroy(lfs_cfg); }
+    static int read(const struct lfs_config *lfs_cfg, lfs_block_t block, lfs_off_t off,
+            void *buffer, lfs_size_t size) { return lfs_spi_flash_bd_read(lfs_cfg, block, off, buffer, size); }
+    static int prog(const struct lfs_config *lfs_cfg, lfs_block_t block, lfs_off_t off,
+            const void *buffer, lfs_size_t size) { return lfs_spi_flash_bd_prog(lfs_cfg, block, off, buffer, size); }
+    static int erase(const struct lfs_config *lfs_cfg, lfs_block_t block) { return lfs_spi_flash_bd_erase(lfs_cfg, block); }
+    static int sync(const struct lfs_config *lfs_cfg) { return lfs_spi_flash_bd_sync(lfs_cfg); }
+#if defined(LFS_THREADSAFE)
+    static int lock(const struct lfs_config *lfs_cfg) { return lfs_spi_flash_bd_lock(lfs_cfg); }
+    static int unlock(const struct lfs_config *lfs_cfg) { return lfs_spi_flash_bd_unlock(lfs_cfg); }
+#endif /* #if defined(LFS_THREADSAFE) */
+};
+#endif /* #if defined(CY_IP_MXSMIF) && !defined(LFS_BD_COMPOSE_NO_HAL) */
+
+#if defined(CY_IP_MXSDHC) && !defined(LFS_BD_COMPOSE_NO_HAL)
+struct SdDriver
+{
+    static cy_rslt_t create(struct lfs_config *lfs_cfg, const mtb_hal_sdhc_t *sdhc_obj)
+    {
+        return lfs_sd_bd_create(lfs_cfg, sdhc_obj);
+    }
+    static void destroy(const struct lfs_config *lfs_cfg) { lfs_sd_bd_destroy(lfs_cfg); }
+    static int read(const struct lfs_config *lfs_cfg, lfs_block_t block, lfs_off_t off,
+            void *buffer, lfs_size_t size) { return lfs_sd_bd_read(lfs_cfg, block, off, buffer, size); }
+    static int prog(const struct lfs_config *lfs_cfg, lfs_block_t block, lfs_off_t off,
+            const void *buffer, lfs_size_t size) { return lfs_sd_bd_prog(lfs_cfg, block, off, buffer, size); }
+    static int erase(const struct lfs_config *lfs_cfg, lfs_block_t block) { return lfs_sd_bd_erase(lfs_cfg, block); }
+    static int sync(const struct lfs_config *lfs_cfg) { return lfs_sd_bd_sync(lfs_cfg); }
+#if defined(LFS_THREADSAFE)
+    static int lock(const struct lfs_config *lfs_cfg) { return lfs_sd_bd_lock(lfs_cfg); }
+    static int unlock(const struct lfs_config *lfs_cfg) { return lfs_sd_bd_unlock(lfs_cfg); }
+#endif /* #if defined(LFS_THREADSAFE) */
+};
+#endif /* #if defined(CY_IP_MXSDHC) && !defined(LFS_BD_COMPOSE_NO_HAL) */
+
+} /* namespace detail */
+/** \endcond */
+
+/**
+ * RAM backend. create() takes a pointer to an \ref lfs_ram_bd_config_t.
+ */
+class RamBackend : public DriverBackend<detail::RamDriver>
+{
+public:
+    /**
+     * \brief Creates the RAM block device.
+     * \param config Pointer to the configuration.
+     * \returns The result of \ref lfs_ram_bd_create().
+     */
+    cy_rslt_t create(const lfs_ram_bd_config_t *config)
+    {
+        return DriverBackend<detail::RamDriver>::create(&ram_, config);
+    }
+
+private:
+    lfs_ram_bd_t ram_;
+};
+
+#if defined(CY_IP_MXSMIF) && !defined(LFS_BD_COMPOSE_NO_HAL)
+/**
+ * SPI flash backend. create() takes a pointer to the initialized serial
+ * memory object, as \ref lfs_spi_flash_bd_create().
+ */
+typedef DriverBackend<detail::SpiFlashDriver> SpiFlashBackend;
+#endif /* #if defined(CY_IP_MXSMIF) && !defined(LFS_BD_COMPOSE_NO_HAL) */
+
+#if defined(CY_IP_MXSDHC) && !defined(LFS_BD_COMPOSE_NO_HAL)
+/**
+ * SD card backend. create() takes a pointer to the initialized SDHC object,
+ * as \ref lfs_sd_bd_create().
+ */
+typedef DriverBackend<detail::SdDriver> SdBackend;
+#endif /* #if defined(CY_IP_MXSDHC) && !defined(LFS_BD_COMPOSE_NO_HAL) */
+
+/**
+ * Backend over an lfs_config structure that is already created. Its functions
+ * are called through the function pointers.
+ */
+class ConfigBackend
+{
+public:
+    /**
+     * \brief Sets the lfs_config structure of the backing device.
+     * \param backing Pointer to the lfs_config structure of the backing
+     *        device, used until destroy().
+     * \returns CY_RSLT_SUCCESS.
+     */
+    cy_rslt_t create(const struct lfs_config *backing)
+    {
+        LFS_ASSERT(NULL != backing);
+
+        backing_ = backing;
+        return CY_RSLT_SUCCESS;
+    }
+
+    /** \brief Releases the backing device. It is not destroyed. */
+    void destroy()
+    {
+        backing_ = NULL;
+    }
+
+    /** \brief Reads data. \returns The result of the backing device. */
+    int read(lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
+    {
+        return backing_->read(backing_, block, off, buffer, size);
+    }
+
+    /** \brief Programs data. \returns The result of the backing device. */
+    int prog(lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
+    {
+        return backing_->prog(backing_, block, off, buffer, size);
+    }
+
+    /** \brief Erases a block. \returns The result of the backing device. */
+    int erase(lfs_block_t block)
+    {
+        return backing_->erase(backing_, block);
+    }
+
+    /** \brief Syncs the backing device. \returns The result of the backing device. */
+    int sync()
+    {
+        return backing_->sync(backing_);
+    }
+
+#if defined(LFS_THREADSAFE)
+    /** \brief Locks the backing device. \returns The result of the backing device. */
+    int lock()
+    {
+        return backing_->lock(backing_);
+    }
+
+    /** \brief Unlocks the backing device. \returns The result of the backing device. */
+    int unlock()
+    {
+        return backing_->unlock(backing_);
+    }
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /** \brief Returns the lfs_config structure of the backing device. */
+    const struct lfs_config &backing_config() const
+    {
+        return *backing_;
+    }
+
+private:
+    const struct lfs_config *backing_;
+};
+
+/** Layer of a \ref LineCache. */
+template <class Next, lfs_size_t LineSize, uint32_t Lines>
+class LineCacheLayer : public Next
+{
+    static_assert((LineSize > 0U) && (0U == (LineSize & (LineSize - 1U))),
+            "The line size must be a power of two");
+    static_assert(Lines > 0U, "The cache must have at least one line");
+
+public:
+    /**
+     * \brief Creates the lower layers and empties the cache.
+     * \returns The result of the lower layers, or
+     *          \ref LFS_BD_COMPOSE_RSLT_ERR_LINE_SIZE.
+     */
+    template <class... Args>
+    cy_rslt_t create(Args&&... args)
+    {
+        cy_rslt_t result = Next::create(std::forward<Args>(args)...);
+
+        if(CY_RSLT_SUCCESS == result)
+        {
+            const struct lfs_config &backing = Next::backing_config();
+
+            if((0U != (backing.block_size % LineSize)) || (0U != (LineSize % backing.read_size)))
+            {
+                Next::destroy();
+                result = LFS_BD_COMPOSE_RSLT_ERR_LINE_SIZE;
+            }
+            else
+            {
+                lines_per_block_ = backing.block_size / LineSize;
+                hits_ = 0U;
+                misses_ = 0U;
+                invalidate_all();
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * \brief Reads data. Whole aligned lines are read from the lower layers
+     * without going through the cache, so large reads do not evict it.
+     * \returns The result of the lower layers.
+     */
+    int read(lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
+    {
+        uint8_t *out = static_cast<uint8_t *>(buffer);
+        int res = 0;
+
+        while((0U != size) && (0 == res))
+        {
+            lfs_off_t line_off = off & ~(LineSize - 1U);
+            lfs_size_t n;
+
+            if((off == line_off) && (size >= LineSize))
+            {
+                n = size & ~(LineSize - 1U);
+                res = Next::read(block, off, out, n);
+            }
+            else
+            {
+                uint32_t line = index(block, line_off);
+
+                n = LineSize - (off - line_off);
+                n = (n < size) ? n : size;
+
+                if((tags_[line].block == block) && (tags_[line].off == line_off))
+                {
+                    hits_++;
+                }
+                else
+                {
+                    misses_++;
+                    tags_[line].block = invalid_block;
+                    res = Next::read(block, line_off, data_[line], LineSize);
+                    if(0 == res)
+                    {
+                        tags_[line].block = block;
+                        tags_[line].off = line_off;
+                    }
+                }
+
+                if(0 == res)
+                {
+                    (void)memcpy(out, &data_[line][off - line_off], n);
+                }
+            }
+
+            out += n;
+            off += n;
+            size -= n;
+        }
+
+        return res;
+    }
+
+    /**
+     * \brief Programs data and drops the cached lines that it overlaps.
+     * \returns The result of the lower layers.
+     */
+    int prog(lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
+    {
+        for(uint32_t line = 0U; line < Lines; line++)
+        {
+            if((tags_[line].block == block) && (tags_[line].off < (off + size)) &&
+               ((tags_[line].off + LineSize) > off))
+            {
+                tags_[line].block = invalid_block;
+            }
+        }
+
+        return Next::prog(block, off, buffer, size);
+    }
+
+    /**
+     * \brief Erases a block and drops its cached lines.
+     * \returns The result of the lower layers.
+     */
+    int erase(lfs_block_t block)
+    {
+        for(uint32_t line = 0U; line < Lines; line++)
+        {
+            if(tags_[line].block == block)
+            {
+                tags_[line].block = invalid_block;
+            }
+        }
+
+        return Next::erase(block);
+    }
+
+    /** \brief Returns the number of reads served from the cache. */
+    uint32_t hits() const
+    {
+        return hits_;
+    }
+
+    /** \brief Returns the number of lines read from the lower layers. */
+    uint32_t misses() const
+    {
+        return misses_;
+    }
+
+    /** \brief Empties the cache, for example after the memory was changed by
+     * another master.
+     */
+    void invalidate_all()
+    {
+        for(uint32_t line = 0U; line < Lines; line++)
+        {
+            tags_[line].block = invalid_block;
+        }
+    }
+
+private:
+    static const lfs_block_t invalid_block = UINT32_MAX;
+
+    struct Tag
+    {
+        lfs_block_t block;
+        lfs_off_t off;
+    };
+
+    uint32_t index(lfs_block_t block, lfs_off_t line_off) const
+    {
+        return ((block * lines_per_block_) + (line_off / LineSize)) % Lines;
+    }
+
+    uint8_t data_[Lines][LineSize];
+    Tag tags_[Lines];
+    uint32_t lines_per_block_;
+    uint32_t hits_;
+    uint32_t misses_;
+};
+
+/**
+ * Policy of a direct-mapped read cache of Lines lines of LineSize bytes.
+ * LineSize must be a power of two, a multiple of the read size and a divisor
+ * of the block size of the backend.
+ */
+template <lfs_size_t LineSize, uint32_t Lines>
+struct LineCache
+{
+    /** Layer over Next. */
+    template <class Next>
+    using layer = LineCacheLayer<Next, LineSize, Lines>;
+};
+
+/** Counters of a \ref Stats layer. */
+struct StatsCounters
+{
+    uint32_t reads;                         /**< Number of reads */
+    uint32_t read_bytes;                    /**< Number of bytes read */
+    uint32_t progs;                         /**< Number of programs */
+    uint32_t prog_bytes;                    /**< Number of bytes programmed */
+    uint32_t erases;                        /**< Number of erases */
+    uint32_t syncs;                         /**< Number of syncs */
+};
+
+/** Layer of a \ref Stats. */
+template <class Next>
+class StatsLayer : public Next
+{
+public:
+    /** \brief Creates the lower layers and clears the counters.
+     * \returns The result of the lower layers.
+     */
+    template <class... Args>
+    cy_rslt_t create(Args&&... args)
+    {
+        reset_stats();
+        return Next::create(std::forward<Args>(args)...);
+    }
+
+    /** \brief Counts and forwards a read. \returns The result of the lower layers. */
+    int read(lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size)
+    {
+        counters_.reads++;
+        counters_.read_bytes += size;
+        return Next::read(block, off, buffer, size);
+    }
+
+    /** \brief Counts and forwards a program. \returns The result of the lower layers. */
+    int prog(lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size)
+    {
+        counters_.progs++;
+        counters_.prog_bytes += size;
+        return Next::prog(block, off, buffer, size);
+    }
+
+    /** \brief Counts and forwards an erase. \returns The result of the lower layers. */
+    int erase(lfs_block_t block)
+    {
+        counters_.erases++;
+        return Next::erase(block);
+    }
+
+    /** \brief Counts and forwards a sync. \returns The result of the lower layers. */
+    int sync()
+    {
+        counters_.syncs++;
+        return Next::sync();
+    }
+
+    /** \brief Returns the counters. */
+    const StatsCounters &stats() const
+    {
+        return counters_;
+    }
+
+    /** \brief Clears the counters. */
+    void reset_stats()
+    {
+        (void)memset(&counters_, 0, sizeof(counters_));
+    }
+
+private:
+    StatsCounters counters_;
+};
+
+/** Policy that counts the calls and bytes that reach its position. */
+struct Stats
+{
+    /** Layer over Next. */
+    template <class Next>
+    using layer = StatsLayer<Next>;
+};
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+/** Layer of an \ref RtosLock. */
+template <class Next>
+class RtosLockLayer : public Next
+{
+public:
+    /** \brief Creates the lower layers and the mutex.
+     * \returns The result of the lower layers or of cy_rtos_init_mutex().
+     */
+    template <class... Args>
+    cy_rslt_t create(Args&&... args)
+    {
+        cy_rslt_t result = Next::create(std::forward<Args>(args)...);
+
+        if(CY_RSLT_SUCCESS == result)
+        {
+            result = cy_rtos_init_mutex(&mutex_);
+            if(CY_RSLT_SUCCESS != result)
+            {
+                Next::destroy();
+            }
+        }
+
+        return result;
+    }
+
+    /** \brief Destroys the mutex and the lower layers. */
+    void destroy()
+    {
+        (void)cy_rtos_deinit_mutex(&mutex_);
+        Next::destroy();
+    }
+
+    /** \brief Gets the mutex. \returns 0 if successful; -1 otherwise. */
+    int lock()
+    {
+        return (CY_RSLT_SUCCESS == cy_rtos_get_mutex(&mutex_, LFS_BD_COMPOSE_GET_MUTEX_TIMEOUT_MS)) ? 0 : -1;
+    }
+
+    /** \brief Releases the mutex. \returns 0 if successful; -1 otherwise. */
+    int unlock()
+    {
+        return (CY_RSLT_SUCCESS == cy_rtos_set_mutex(&mutex_)) ? 0 : -1;
+    }
+
+private:
+    cy_mutex_t mutex_;
+};
+
+/**
+ * Policy that locks with a recursive mutex of the layer instead of the lock
+ * of the layers below.
+ */
+struct RtosLock
+{
+    /** Layer over Next. */
+    template <class Next>
+    using layer = RtosLockLayer<Next>;
+};
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
+
+/**
+ * Block device made of a backend and a list of policies, with an lfs_config
+ * structure whose callbacks call the stack.
+ */
+template <class Backend, class... Policies>
+class BlockDevice : public detail::Stack<Backend, Policies...>::type
+{
+    typedef typename detail::Stack<Backend, Policies...>::type stack_t;
+
+public:
+    /**
+     * \brief Creates all layers and populates the lfs_config structure with
+     * the geometry and tuning of the backend.
+     * \param args Arguments of create() of the backend.
+     * \returns CY_RSLT_SUCCESS if the creation was successful; the result of
+     *          the first layer that failed otherwise.
+     */
+    template <class... Args>
+    cy_rslt_t create(Args&&... args)
+    {
+        cy_rslt_t result = stack_t::create(std::forward<Args>(args)...);
+
+        if(CY_RSLT_SUCCESS == result)
+        {
+            const struct lfs_config &backing = stack_t::backing_config();
+
+            (void)memset(&lfs_cfg_, 0, sizeof(lfs_cfg_));
+            lfs_cfg_.context     = this;
+
+            /* Block device operations */
+            lfs_cfg_.read        = read_cb;
+            lfs_cfg_.prog        = prog_cb;
+            lfs_cfg_.erase       = erase_cb;
+            lfs_cfg_.sync        = sync_cb;
+
+#if defined(LFS_THREADSAFE)
+            lfs_cfg_.lock        = lock_cb;
+            lfs_cfg_.unlock      = unlock_cb;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+            /* Block device configuration */
+            lfs_cfg_.read_size      = backing.read_size;
+            lfs_cfg_.prog_size      = backing.prog_size;
+            lfs_cfg_.block_size     = backing.block_size;
+            lfs_cfg_.block_count    = backing.block_count;
+            lfs_cfg_.block_cycles   = backing.block_cycles;
+            lfs_cfg_.cache_size     = backing.cache_size;
+            lfs_cfg_.lookahead_size = backing.lookahead_size;
+        }
+
+        return result;
+    }
+
+    /**
+     * \brief Returns the lfs_config structure to pass to littlefs. The tuning
+     * fields can be changed before the filesystem is mounted.
+     */
+    struct lfs_config *config()
+    {
+        return &lfs_cfg_;
+    }
+
+private:
+    static stack_t *self(const struct lfs_config *lfs_cfg)
+    {
+        return static_cast<BlockDevice *>(lfs_cfg->context);
+    }
+
+    static int read_cb(const struct lfs_config *lfs_cfg, lfs_block_t block,
+            lfs_off_t off, void *buffer, lfs_size_t size)
+    {
+        return self(lfs_cfg)->read(block, off, buffer, size);
+    }
+
+    static int prog_cb(const struct lfs_config *lfs_cfg, lfs_block_t block,
+            lfs_off_t off, const void *buffer, lfs_size_t size)
+    {
+        return self(lfs_cfg)->prog(block, off, buffer, size);
+    }
+
+    static int erase_cb(const struct lfs_config *lfs_cfg, lfs_block_t block)
+    {
+        return self(lfs_cfg)->erase(block);
+    }
+
+    static int sync_cb(const struct lfs_config *lfs_cfg)
+    {
+        return self(lfs_cfg)->sync();
+    }
+
+#if defined(LFS_THREADSAFE)
+    static int lock_cb(const struct lfs_config *lfs_cfg)
+    {
+        return self(lfs_cfg)->lock();
+    }
+
+    static int unlock_cb(const struct lfs_config *lfs_cfg)
+    {
+        return self(lfs_cfg)->unlock();
+    }
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    struct lfs_config lfs_cfg_;
+};
+
+} /* namespace lfs_compose */
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_bd_compose */
@@ -0,0 +1,101 @@
+/***************************************************************************//**
+ * \file lfs_bd_geometry.h
+ *
+ * \brief
+ * Geometry of the lfs_config structure derived by the block device drivers
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_bd_geometry Block Device Geometry
+ * \{
+ * * Populates the geometry and the littlefs tuning fields of the lfs_config
+ * structure from the parameters of the memory. \ref lfs_spi_flash_bd_create()
+ * and \ref lfs_sd_bd_create() use these functions, so the result is the
+ * configuration that the drivers derive on the device.
+ * * The functions depend only on littlefs. Host tools use them to build
+ * filesystem images that match the device, for example the image builder in
+ * the tools/lfs_image directory.
+ */
+
+#ifndef LFS_BD_GEOMETRY_H            /* Guard against multiple inclusion */
+#define LFS_BD_GEOMETRY_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Number of program pages in the cache_size set by
+ * \ref lfs_spi_flash_bd_create. If the block size is not a multiple of the
+ * resulting size, the largest smaller number of pages that divides the block
+ * size is used.
+ */
+#ifndef LFS_SPI_FLASH_BD_CACHE_PAGES
+#define LFS_SPI_FLASH_BD_CACHE_PAGES            (1UL)
+#endif /* #ifndef LFS_SPI_FLASH_BD_CACHE_PAGES */
+
+/** Size in bytes of the blocks used by \ref lfs_sd_bd_create(). */
+#define LFS_SD_BD_BLOCK_SIZE                    (512UL)
+
+/**
+ * \brief Populates the geometry and tuning fields of the lfs_config structure
+ * as \ref lfs_spi_flash_bd_create() does.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param prog_size Program (page) size of the memory in bytes.
+ * \param block_size Erase (sector) size of the memory in bytes.
+ * \param block_count Number of blocks of the region used by littlefs.
+ */
+void lfs_spi_flash_bd_set_geometry(struct lfs_config *lfs_cfg, lfs_size_t prog_size,
+        lfs_size_t block_size, lfs_size_t block_count);
+
+/**
+ * \brief Populates the geometry and tuning fields of the lfs_config structure
+ * as \ref lfs_sd_bd_create() does.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block_count Number of \ref LFS_SD_BD_BLOCK_SIZE blocks of the card.
+ */
+void lfs_sd_bd_set_geometry(struct lfs_config *lfs_cfg, lfs_size_t block_count);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_bd_geometry */
@@ -0,0 +1,321 @@
+/***************************************************************************//**
+ * \file lfs_bd_stack.h
+ *
+ * \brief
+ * Implements a convention to stack block device layers at run time and an
+ * adapter that turns a stack into an lfs_config structure.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_bd_stack Block Device Stack
+ * \{
+ * * Implements a convention to stack block device layers at run time, and an
+ * adapter that turns a stack into an lfs_config structure for littlefs.
+ * * A layer is an \ref lfs_bd_layer_t: a table of operations of type
+ * \ref lfs_bd_ops_t, the context of the layer and the layer below it. All
+ * layers use the same table, so a cache, statistics or remapping layer can be
+ * inserted over any other layer.
+ * * A NULL operation in the table passes the call to the layer below. A layer
+ * implements only the operations it changes, and forwards to the layer below
+ * with \ref lfs_bd_stack_layer_read() and the other dispatch functions.
+ * * The bottom layer is made from an lfs_config structure that is already
+ * created with \ref lfs_bd_stack_base(): the one populated by
+ * \ref lfs_spi_flash_bd_create() or \ref lfs_sd_bd_create(), or any of the
+ * block devices of this library that wrap them.
+ * * The geometry and the littlefs tuning are copied from the layer below when
+ * a layer is pushed. A layer that changes them, for example to reserve
+ * blocks, sets its fields after \ref lfs_bd_stack_push().
+ * * \ref lfs_bd_stack_create() populates an lfs_config structure that calls
+ * the top of the stack. It can be passed to littlefs or used as the backing
+ * device of another block device of this library.
+ *
+ * The following layer counts the erases and passes the other operations to the
+ * SPI flash:
+ * \code
+ * static int count_erase(const lfs_bd_layer_t *layer, lfs_block_t block)
+ * {
+ *     uint32_t *erases = layer->context;
+ *
+ *     (*erases)++;
+ *     return lfs_bd_stack_layer_erase(layer->lower, block);
+ * }
+ *
+ * static const lfs_bd_ops_t count_ops = { .erase = count_erase };
+ *
+ * lfs_spi_flash_bd_create(&flash_cfg, &serial_memory_obj);
+ * lfs_bd_stack_base(&flash_layer, &flash_cfg);
+ * lfs_bd_stack_push(&count_layer, &count_ops, &erases, &flash_layer);
+ * lfs_bd_stack_create(&lfs_cfg, &count_layer);
+ * lfs_mount(&lfs, &lfs_cfg);
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * The layers and their contexts are not copied; they must stay valid while
+ * the stack is used.
+ * * When LFS_THREADSAFE is defined, the lock of littlefs is the lock of the
+ * highest layer that implements it, which is the lock of the base layer if
+ * no other layer does.
+ */
+
+#ifndef LFS_BD_STACK_H            /* Guard against multiple inclusion */
+#define LFS_BD_STACK_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_bd_stack_unlock and lfs_bd_stack_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',18,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',12,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Layer of a block device stack. */
+typedef struct lfs_bd_layer lfs_bd_layer_t;
+
+/**
+ * Operations of a layer. The functions have the semantics of the functions of
+ * the lfs_config structure and receive the layer. A NULL function passes the
+ * call to the layer below.
+ */
+typedef struct
+{
+    /** Reads data. */
+    int (*read)(const lfs_bd_layer_t *layer, lfs_block_t block, lfs_off_t off,
+            void *buffer, lfs_size_t size);
+    /** Programs data. */
+    int (*prog)(const lfs_bd_layer_t *layer, lfs_block_t block, lfs_off_t off,
+            const void *buffer, lfs_size_t size);
+    /** Erases a block. */
+    int (*erase)(const lfs_bd_layer_t *layer, lfs_block_t block);
+    /** Syncs the layer. */
+    int (*sync)(const lfs_bd_layer_t *layer);
+#if defined(LFS_THREADSAFE)
+    /** Locks the layer. */
+    int (*lock)(const lfs_bd_layer_t *layer);
+    /** Unlocks the layer. */
+    int (*unlock)(const lfs_bd_layer_t *layer);
+#endif /* #if defined(LFS_THREADSAFE) */
+} lfs_bd_ops_t;
+
+/** Layer of a block device stack. */
+struct lfs_bd_layer
+{
+    const lfs_bd_ops_t *ops;                /**< Operations of the layer */
+    void *context;                          /**< Context of the layer, for its operations */
+    const lfs_bd_layer_t *lower;            /**< Layer below; NULL for the base layer */
+    lfs_size_t read_size;                   /**< Minimum size of a read */
+    lfs_size_t prog_size;                   /**< Minimum size of a program */
+    lfs_size_t block_size;                  /**< Size of an erasable block */
+    lfs_size_t block_count;                 /**< Number of erasable blocks */
+    int32_t block_cycles;                   /**< littlefs block_cycles */
+    lfs_size_t cache_size;                  /**< littlefs cache_size */
+    lfs_size_t lookahead_size;              /**< littlefs lookahead_size */
+};
+
+/**
+ * \brief Makes the base layer of a stack from a created lfs_config structure.
+ * The operations call the functions of the lfs_config structure, and the
+ * geometry and tuning are copied from it.
+ * \param layer Pointer to the layer.
+ * \param lfs_cfg Pointer to the lfs_config structure, used while the stack is
+ *        used.
+ */
+void lfs_bd_stack_base(lfs_bd_layer_t *layer, const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Places a layer over another one and copies its geometry and tuning.
+ * \param layer Pointer to the layer.
+ * \param ops Pointer to the operations of the layer.
+ * \param context Context of the layer.
+ * \param lower Pointer to the layer below.
+ */
+void lfs_bd_stack_push(lfs_bd_layer_t *layer, const lfs_bd_ops_t *ops, void *context,
+        const lfs_bd_layer_t *lower);
+
+/**
+ * \brief Reads data with the first layer that implements it, from the given
+ * layer down.
+ * \param layer Pointer to the layer.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns The result of the layer.
+ */
+int lfs_bd_stack_layer_read(const lfs_bd_layer_t *layer, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data with the first layer that implements it, from the
+ * given layer down.
+ * \param layer Pointer to the layer.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns The result of the layer.
+ */
+int lfs_bd_stack_layer_prog(const lfs_bd_layer_t *layer, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block with the first layer that implements it, from the
+ * given layer down.
+ * \param layer Pointer to the layer.
+ * \param block Block number to be erased.
+ * \returns The result of the layer.
+ */
+int lfs_bd_stack_layer_erase(const lfs_bd_layer_t *layer, lfs_block_t block);
+
+/**
+ * \brief Syncs with the first layer that implements it, from the given layer
+ * down.
+ * \param layer Pointer to the layer.
+ * \returns The result of the layer.
+ */
+int lfs_bd_stack_layer_sync(const lfs_bd_layer_t *layer);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks with the first layer that implements it, from the given layer
+ * down.
+ * \param layer Pointer to the layer.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_bd_stack_layer_lock(const lfs_bd_layer_t *layer);
+
+/**
+ * \brief Unlocks with the first layer that implements it, from the given
+ * layer down.
+ * \param layer Pointer to the layer.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_bd_stack_layer_unlock(const lfs_bd_layer_t *layer);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ * \brief Populates an lfs_config structure that calls the top layer of a
+ * stack, with the geometry and tuning of that layer.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param top Pointer to the top layer.
+ * \returns CY_RSLT_SUCCESS.
+ */
+cy_rslt_t lfs_bd_stack_create(struct lfs_config *lfs_cfg, const lfs_bd_layer_t *top);
+
+/**
+ * \brief Reads data from the top layer.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns The result of the stack.
+ */
+int lfs_bd_stack_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data on the top layer.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns The result of the stack.
+ */
+int lfs_bd_stack_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block of the top layer.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns The result of the stack.
+ */
+int lfs_bd_stack_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Syncs the top layer.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns The result of the stack.
+ */
+int lfs_bd_stack_sync(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the stack.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_bd_stack_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the stack.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_bd_stack_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_bd_stack */
@@ -0,0 +1,291 @@
+/***************************************************************************//**
+ * \file lfs_crypt_bd.h
+ *
+ * \brief
+ * Encryption block device
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_crypt_bd Encryption Block Device
+ * \{
+ * * Implements a block device that encrypts the data of another block device
+ * populated by \ref lfs_spi_flash_bd_create() or \ref lfs_sd_bd_create().
+ * * The data is encrypted with AES-XTS as specified by IEEE 1619. The data
+ * unit is the program size of the backing device, and at least 16 bytes. The
+ * data unit number is built from the position of the data unit on the device
+ * and the nonce of the volume. The read and program sizes of the layer are the
+ * data unit size, so littlefs always reads and programs whole data units.
+ * * Reads are decrypted in place in the buffer of littlefs. Programs are
+ * encrypted into a buffer of \ref LFS_CRYPT_BD_BUFFER_SIZE bytes that is
+ * programmed piece by piece, because littlefs compares the programmed data
+ * with its cache when LFS_VALIDATE is enabled.
+ * * The AES-XTS operation is done by a function of type
+ * \ref lfs_crypt_bd_xts_fn_t, so a crypto accelerator can be used. When no
+ * function is provided, a software AES-128-XTS implementation is used. Define
+ * LFS_CRYPT_BD_NO_SOFTWARE_AES to remove it when a function is always
+ * provided.
+ *
+ * The following function uses the MbedTLS AES-XTS API, which runs on the
+ * crypto accelerator when hardware acceleration is enabled for the device.
+ * MbedTLS needs a context per direction:
+ * \code
+ * static mbedtls_aes_xts_context xts_context[2];
+ *
+ * static int hw_xts(void *context, bool encrypt, const uint8_t data_unit[LFS_CRYPT_BD_AES_BLOCK_SIZE],
+ *         const uint8_t *input, uint8_t *output, lfs_size_t size)
+ * {
+ *     mbedtls_aes_xts_context *xts = (mbedtls_aes_xts_context *)context;
+ *
+ *     return mbedtls_aes_crypt_xts(&xts[encrypt ? 1 : 0], encrypt ? MBEDTLS_AES_ENCRYPT : MBEDTLS_AES_DECRYPT,
+ *             size, data_unit, input, output);
+ * }
+ *
+ * mbedtls_aes_xts_setkey_dec(&xts_context[0], key, 8U * LFS_CRYPT_BD_KEY_SIZE);
+ * mbedtls_aes_xts_setkey_enc(&xts_context[1], key, 8U * LFS_CRYPT_BD_KEY_SIZE);
+ * crypt_config.backing = &flash_cfg;
+ * crypt_config.xts = hw_xts;
+ * crypt_config.xts_context = xts_context;
+ * lfs_crypt_bd_create(&crypt_cfg, &crypt, &crypt_config);
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * The layer keeps the data confidential when the memory is read out. It does
+ * not authenticate the data: littlefs detects random corruption with its CRCs
+ * but not deliberate changes.
+ * * XTS does not use a key stream, so two versions of a data unit captured
+ * before and after a rewrite do not reveal each other. A data unit programmed
+ * again with the same content gives the same ciphertext, so an attacker that
+ * captures the memory contents more than once can see which data units did
+ * not change. Use a different nonce for each volume, and a different key for
+ * each device.
+ * * Erased areas are read as random data rather than the erased value of the
+ * memory. littlefs does not depend on the erased value.
+ */
+
+#ifndef LFS_CRYPT_BD_H            /* Guard against multiple inclusion */
+#define LFS_CRYPT_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_crypt_bd_unlock and lfs_crypt_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',5,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Size in bytes of an AES block and of the data unit number. */
+#define LFS_CRYPT_BD_AES_BLOCK_SIZE             (16U)
+
+/** Size in bytes of the key of the software AES-128-XTS implementation: the
+ * AES-128 key of the data followed by the AES-128 key of the tweak.
+ */
+#define LFS_CRYPT_BD_KEY_SIZE                   (32U)
+
+/** Size in bytes of the nonce of the volume. */
+#define LFS_CRYPT_BD_NONCE_SIZE                 (8U)
+
+/** Size in bytes of the buffer for encrypted program data. Must be a multiple
+ * of the data unit size.
+ */
+#ifndef LFS_CRYPT_BD_BUFFER_SIZE
+#define LFS_CRYPT_BD_BUFFER_SIZE                (256UL)
+#endif /* #ifndef LFS_CRYPT_BD_BUFFER_SIZE */
+
+/** The program size of the backing device cannot be used as the data unit:
+ * it is not a multiple of 16 bytes and of the read size, or the cache size of
+ * the backing device or \ref LFS_CRYPT_BD_BUFFER_SIZE is not a multiple of the
+ * data unit size.
+ */
+#define LFS_CRYPT_BD_RSLT_ERR_PROG_SIZE         \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0500U)
+
+/**
+ * Encrypts or decrypts one data unit of size bytes in AES-XTS mode. size is a
+ * multiple of 16 bytes. The data unit number is a 128-bit little-endian value,
+ * as passed to mbedtls_aes_crypt_xts(). The input and output can be the same
+ * buffer. Returns 0 if successful; a negative error code otherwise.
+ */
+typedef int (*lfs_crypt_bd_xts_fn_t)(void *context, bool encrypt,
+        const uint8_t data_unit[LFS_CRYPT_BD_AES_BLOCK_SIZE],
+        const uint8_t *input, uint8_t *output, lfs_size_t size);
+
+/** Configuration of an encryption block device. */
+typedef struct
+{
+    /** lfs_config structure of the backing device. */
+    const struct lfs_config *backing;
+    /** AES-128-XTS key of \ref LFS_CRYPT_BD_KEY_SIZE bytes for the software
+     * implementation. Not used when xts is set.
+     */
+    const uint8_t *key;
+    /** Nonce of the volume, placed in the last bytes of every data unit
+     * number.
+     */
+    uint8_t nonce[LFS_CRYPT_BD_NONCE_SIZE];
+    /** AES-XTS function, for example on a crypto accelerator. Can be NULL to
+     * use the software implementation.
+     */
+    lfs_crypt_bd_xts_fn_t xts;
+    /** Context passed to the AES-XTS function. */
+    void *xts_context;
+} lfs_crypt_bd_config_t;
+
+/**
+ * Encryption block device object. The content of this structure is for
+ * internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const struct lfs_config *backing;
+    uint8_t nonce[LFS_CRYPT_BD_NONCE_SIZE];
+    lfs_size_t unit_size;
+    lfs_crypt_bd_xts_fn_t xts;
+    void *xts_context;
+#if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES)
+    uint8_t data_round_keys[11U * LFS_CRYPT_BD_AES_BLOCK_SIZE];
+    uint8_t tweak_round_keys[11U * LFS_CRYPT_BD_AES_BLOCK_SIZE];
+#endif /* #if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES) */
+    uint8_t buffer[LFS_CRYPT_BD_BUFFER_SIZE];
+    /** \endcond */
+} lfs_crypt_bd_t;
+
+/**
+ * \brief Initializes the encryption block device and populates the lfs_config
+ * structure with the values of the backing device. The read and program sizes
+ * are set to the data unit size.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param crypt Pointer to the encryption block device object.
+ * \param config Pointer to the configuration. Not used after the call.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful;
+ *          \ref LFS_CRYPT_BD_RSLT_ERR_PROG_SIZE otherwise.
+ */
+cy_rslt_t lfs_crypt_bd_create(struct lfs_config *lfs_cfg, lfs_crypt_bd_t *crypt,
+        const lfs_crypt_bd_config_t *config);
+
+/**
+ * \brief De-initializes the encryption block device and clears the key
+ * material. The backing device is not destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_crypt_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Reads data from the backing device and decrypts it in place.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns The result of the backing device or of the AES-XTS function.
+ */
+int lfs_crypt_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Encrypts data and programs it on the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns The result of the backing device or of the AES-XTS function.
+ */
+int lfs_crypt_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block of the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns The result of the backing device.
+ */
+int lfs_crypt_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Syncs the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns The result of the backing device.
+ */
+int lfs_crypt_bd_sync(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_crypt_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_crypt_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_crypt_bd */
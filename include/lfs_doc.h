@@ -225,6 +225,23 @@
 * The driver configuration details are described in the relevant section:
 * - \ref group_lfs_spi_flash_bd
 * - \ref group_lfs_sd_bd
+* - \ref group_lfs_ram_bd
+* - \ref group_lfs_bd_geometry
+* - \ref group_lfs_bd_stack
+* - \ref group_lfs_mirror_bd
+* - \ref group_lfs_tiered_bd
+* - \ref group_lfs_powercut_bd
+* - \ref group_lfs_stats_bd
+* - \ref group_lfs_wa_bd
+* - \ref group_lfs_maint_bd
+* - \ref group_lfs_async_bd
+* - \ref group_lfs_crypt_bd
+* - \ref group_lfs_rw
+* - \ref group_lfs_zlog
+* - \ref group_lfs_ring_log
+* - \ref group_lfs_snapshot
+* - \ref group_lfs_svc
+* - \ref group_lfs_bd_compose
 *
 * \note The source files under *\<littlefs_path\>/bd* are ignored from
 * auto-discovery. Therefore, they will be excluded from compilation because some
@@ -0,0 +1,280 @@
+/***************************************************************************//**
+ * \file lfs_maint_bd.h
+ *
+ * \brief
+ * Implements a block device that erases free blocks of another block device
+ * while it is idle.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_maint_bd Idle-Time Maintenance Block Device
+ * \{
+ * * Implements a block device that moves maintenance work of littlefs out of
+ * the foreground writes into idle time, for another block device populated by
+ * \ref lfs_spi_flash_bd_create().
+ * * The longest stalls of a write on a NOR flash are block erases, which
+ * littlefs runs when it allocates a block for new data or compacts a metadata
+ * pair. \ref lfs_maint_bd_run() erases free blocks ahead of time, and an
+ * erase requested by littlefs later is skipped if the block has not been
+ * programmed since.
+ * * \ref lfs_maint_bd_run() does nothing unless the device has been idle for
+ * the configured time. It finds the free blocks with lfs_fs_traverse(),
+ * which is repeated only after the filesystem has changed, and erases them
+ * until the time budget is used up. With littlefs 2.8 or later, it first
+ * calls lfs_fs_gc(), which refills the lookahead buffer of the allocator and,
+ * from littlefs 2.9, compacts the metadata pairs that exceed compact_thresh.
+ * * \ref lfs_maint_bd_get_stats() returns the number of erases avoided in the
+ * foreground, that is, the stalls avoided.
+ * * The state of each block is kept in a bitmap provided by the application;
+ * nothing is stored on the memory. After a reset all blocks are treated as
+ * not erased.
+ *
+ * The following task runs the maintenance with a budget of 50 ms after 200 ms
+ * without I/O:
+ * \code
+ * lfs_maint_bd_config_t maint_config = {
+ *     .backing = &flash_cfg, .bitmap = bitmap, .get_time_ms = get_time_ms, .idle_ms = 200U
+ * };
+ * lfs_maint_bd_create(&maint_cfg, &maint, &maint_config);
+ * lfs_mount(&lfs, &maint_cfg);
+ *
+ * for(;;)
+ * {
+ *     (void)lfs_maint_bd_run(&maint_cfg, &lfs, 50U);
+ *     cy_rtos_delay_milliseconds(100U);
+ * }
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * \ref lfs_maint_bd_run() must not run at the same time as another
+ * operation on the filesystem. When LFS_THREADSAFE is defined, it holds the
+ * lock of the block device for the whole run, so it can be called from its
+ * own task; the lock of the backing device must then be recursive, as the
+ * mutexes of the RTOS abstraction are.
+ * * The budget is checked between erases, so a run can exceed it by the time
+ * of one erase, of lfs_fs_gc() and of lfs_fs_traverse().
+ * * Blocks erased ahead of time are not erased again when littlefs uses them,
+ * so the wear is not increased. A block is erased ahead of time only once
+ * until it is programmed.
+ */
+
+#ifndef LFS_MAINT_BD_H            /* Guard against multiple inclusion */
+#define LFS_MAINT_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_maint_bd_unlock and lfs_maint_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',5,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Size in bytes of the bitmap for a device of block_count blocks. */
+#define LFS_MAINT_BD_BITMAP_SIZE(block_count)   (2UL * (((block_count) + 7UL) / 8UL))
+
+/** Returns a free-running time stamp in milliseconds. */
+typedef uint32_t (*lfs_maint_bd_time_fn_t)(void);
+
+/** Configuration of a maintenance block device. */
+typedef struct
+{
+    /** lfs_config structure of the backing device. */
+    const struct lfs_config *backing;
+    /** Bitmap of \ref LFS_MAINT_BD_BITMAP_SIZE bytes for the block count of the
+     * backing device.
+     */
+    uint8_t *bitmap;
+    /** Time source. */
+    lfs_maint_bd_time_fn_t get_time_ms;
+    /** Time without I/O in milliseconds after which the device is idle. */
+    uint32_t idle_ms;
+} lfs_maint_bd_config_t;
+
+/** Counters of a maintenance block device. */
+typedef struct
+{
+    uint32_t runs;                  /**< Number of runs that found the device idle */
+    uint32_t gc_calls;              /**< Number of lfs_fs_gc() calls */
+    uint32_t traversals;            /**< Number of lfs_fs_traverse() calls */
+    uint32_t pre_erases;            /**< Number of blocks erased ahead of time */
+    uint32_t erases_avoided;        /**< Number of foreground erases skipped */
+    uint32_t foreground_erases;     /**< Number of foreground erases run */
+    uint32_t pre_erase_ms;          /**< Total time of the erases ahead of time */
+} lfs_maint_bd_stats_t;
+
+/**
+ * Maintenance block device object. The content of this structure is for
+ * internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const struct lfs_config *backing;
+    uint8_t *erased;
+    uint8_t *in_use;
+    lfs_maint_bd_time_fn_t get_time_ms;
+    uint32_t idle_ms;
+    uint32_t last_io;
+    bool map_valid;
+    bool running;
+    lfs_block_t cursor;
+    lfs_maint_bd_stats_t stats;
+    /** \endcond */
+} lfs_maint_bd_t;
+
+/**
+ * \brief Initializes the maintenance block device and populates the
+ * lfs_config structure with the values of the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param maint Pointer to the maintenance block device object.
+ * \param config Pointer to the configuration. Not used after the call.
+ * \returns CY_RSLT_SUCCESS.
+ */
+cy_rslt_t lfs_maint_bd_create(struct lfs_config *lfs_cfg, lfs_maint_bd_t *maint,
+        const lfs_maint_bd_config_t *config);
+
+/**
+ * \brief De-initializes the maintenance block device. The backing device is
+ * not destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_maint_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Runs the maintenance if the device is idle.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param lfs Pointer to the filesystem mounted on the device.
+ * \param budget_ms Time in milliseconds after which no more blocks are erased.
+ * \returns The number of blocks erased ahead of time; a littlefs error code
+ *          otherwise.
+ */
+int lfs_maint_bd_run(const struct lfs_config *lfs_cfg, lfs_t *lfs, uint32_t budget_ms);
+
+/**
+ * \brief Returns the counters of the device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param stats Pointer to the structure to store the counters.
+ */
+void lfs_maint_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_maint_bd_stats_t *stats);
+
+/**
+ * \brief Reads data from the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns The result of the backing device.
+ */
+int lfs_maint_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data on the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns The result of the backing device.
+ */
+int lfs_maint_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block of the backing device, unless it was erased ahead of
+ * time and not programmed since.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns 0 if the erase was skipped; the result of the backing device
+ *          otherwise.
+ */
+int lfs_maint_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Syncs the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns The result of the backing device.
+ */
+int lfs_maint_bd_sync(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_maint_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_maint_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_maint_bd */
@@ -0,0 +1,327 @@
+/***************************************************************************//**
+ * \file lfs_mirror_bd.h
+ *
+ * \brief
+ * Implements a mirrored block device for use with the littlefs API. Writes
+ * are duplicated to two member block devices and reads alternate between
+ * them.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_mirror_bd Mirrored Block Device
+ * \{
+ * * Implements a RAID-1 style block device on top of two lfs_config structures
+ * that were populated by \ref lfs_spi_flash_bd_create() or
+ * \ref lfs_sd_bd_create().
+ * * Program and erase operations are applied to the primary member first and
+ * then to the secondary member.
+ * * Every read is served by one member only. littlefs issues one operation at
+ * a time, so there is no queue to balance: the in-sync members serve reads in
+ * turn (round-robin). When a read fails, it is retried on the other member.
+ * * When a program or erase fails on one member only, the operation succeeds
+ * and the affected block is recorded as diverged on the failed member. Reads of
+ * a diverged block are served by the in-sync member until
+ * \ref lfs_mirror_bd_resync() restores it.
+ * * Provides read distribution statistics through
+ * \ref lfs_mirror_bd_get_stats().
+ *
+ * <b>Note:</b>
+ * * Only two independent block device instances of equal geometry are
+ * supported. Both members must have the same block size. The read and program
+ * sizes of the mirror are the larger of the member values; the block count is
+ * the smaller of the member values.
+ * * The members may be populated by the same driver as long as they refer to
+ * different devices, that is, their lfs_config structures have different
+ * contexts. \ref lfs_mirror_bd_create() returns
+ * \ref LFS_MIRROR_BD_RSLT_ERR_SAME_DEVICE when both members are the same
+ * device. \ref lfs_spi_flash_bd_create() and \ref lfs_sd_bd_create() keep their
+ * mutex in a file scope variable, and the SPI flash driver also its memory
+ * region, read cache and erase-wait settings. Two instances of these drivers
+ * therefore share these settings, and the mirror takes the shared mutex once
+ * per member, which the recursive mutex created by cy_rtos_init_mutex()
+ * allows.
+ * * Divergence is tracked per block when a resync map is provided in
+ * \ref lfs_mirror_bd_config_t. Otherwise, a failed operation marks the whole
+ * member as diverged.
+ * * Divergence caused by a power loss between the primary and the secondary
+ * write cannot be tracked in RAM. Call \ref lfs_mirror_bd_verify() after an
+ * unexpected reset to detect and repair it. The primary member is always
+ * written first and is therefore used as the reference.
+ */
+
+#ifndef LFS_MIRROR_BD_H            /* Guard against multiple inclusion */
+#define LFS_MIRROR_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_mirror_bd_unlock and lfs_mirror_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',8,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Enable trace for this driver by defining this macro. You must also define the
+ * global trace enable macro LFS_YES_TRACE.
+ */
+#ifdef LFS_MIRROR_BD_YES_TRACE
+#define LFS_MIRROR_BD_TRACE(...) LFS_TRACE(__VA_ARGS__)
+#else
+#define LFS_MIRROR_BD_TRACE(...)
+#endif
+
+/** Number of member block devices in a mirror. */
+#define LFS_MIRROR_BD_MEMBER_COUNT              (2U)
+
+/** Index of the primary member. The primary member is always written first. */
+#define LFS_MIRROR_BD_PRIMARY                   (0U)
+
+/** Index of the secondary member. */
+#define LFS_MIRROR_BD_SECONDARY                 (1U)
+
+/** Size in bytes of the resync map required for a given block count. Two bits
+ * are used per block, one for each member.
+ */
+#define LFS_MIRROR_BD_RESYNC_MAP_SIZE(block_count)  ((((block_count) * LFS_MIRROR_BD_MEMBER_COUNT) + 7UL) / 8UL)
+
+/** The members have incompatible geometry. */
+#define LFS_MIRROR_BD_RSLT_ERR_GEOMETRY         \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0100U)
+
+/** The resync map provided is too small for the block count of the mirror. */
+#define LFS_MIRROR_BD_RSLT_ERR_RESYNC_MAP       \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0101U)
+
+/** Both members are the same device: the same lfs_config structure, or two
+ * structures of the same driver with the same context.
+ */
+#define LFS_MIRROR_BD_RSLT_ERR_SAME_DEVICE      \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0102U)
+
+/** Configuration of a mirrored block device. */
+typedef struct
+{
+    /** lfs_config structures of the members, populated by
+     * \ref lfs_spi_flash_bd_create() or \ref lfs_sd_bd_create(). Index
+     * \ref LFS_MIRROR_BD_PRIMARY is the primary member.
+     */
+    const struct lfs_config *member[LFS_MIRROR_BD_MEMBER_COUNT];
+    /** Optional buffer for per-block divergence tracking of
+     * \ref LFS_MIRROR_BD_RESYNC_MAP_SIZE bytes. Set to NULL to track divergence
+     * per member only.
+     */
+    uint8_t *resync_map;
+    /** Size of resync_map in bytes. */
+    lfs_size_t resync_map_size;
+} lfs_mirror_bd_config_t;
+
+/** Read distribution and divergence statistics of a mirrored block device. */
+typedef struct
+{
+    uint32_t read_count[LFS_MIRROR_BD_MEMBER_COUNT];  /**< Number of reads served by each member */
+    uint32_t read_bytes[LFS_MIRROR_BD_MEMBER_COUNT];  /**< Number of bytes read from each member */
+    uint32_t read_failovers;    /**< Number of reads retried on the other member after an error */
+    uint32_t degraded_writes;   /**< Number of program or erase operations that succeeded on one member only */
+    uint32_t resynced_blocks;   /**< Number of blocks copied by \ref lfs_mirror_bd_resync() or \ref lfs_mirror_bd_verify() */
+} lfs_mirror_bd_stats_t;
+
+/**
+ * Mirrored block device object. The content of this structure is for internal
+ * use only. The object must stay allocated while the mirror is in use.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const struct lfs_config *member[LFS_MIRROR_BD_MEMBER_COUNT];
+    bool diverged[LFS_MIRROR_BD_MEMBER_COUNT];
+    uint8_t *resync_map;
+    uint32_t next_member;
+    lfs_mirror_bd_stats_t stats;
+    /** \endcond */
+} lfs_mirror_bd_t;
+
+/**
+ * \brief Initializes the mirrored block device and populates the lfs_config
+ * structure with the default values derived from the members.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param mirror Pointer to the mirrored block device object.
+ * \param config Pointer to the mirror configuration.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful; an error code
+ *          otherwise.
+ */
+cy_rslt_t lfs_mirror_bd_create(struct lfs_config *lfs_cfg, lfs_mirror_bd_t *mirror,
+        const lfs_mirror_bd_config_t *config);
+
+/**
+ * \brief De-initializes the mirrored block device. The members are not
+ * destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_mirror_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Reads the data starting from a given block and offset from the next
+ * in-sync member in turn.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns 0 if the read was successful; -1 otherwise.
+ */
+int lfs_mirror_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs the data starting from a given block and offset on both
+ * members.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns 0 if the write was successful on at least one member; -1 otherwise.
+ */
+int lfs_mirror_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a given block on both members. A successful erase on both
+ * members clears the divergence recorded for the block.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns 0 if the erase was successful on at least one member; -1 otherwise.
+ */
+int lfs_mirror_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Flushes the write cache of both members.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if the sync was successful; -1 otherwise.
+ */
+int lfs_mirror_bd_sync(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Copies every diverged block from the in-sync member to the diverged
+ * member.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param buffer Pointer to a work buffer. The size must be a multiple of the
+ *        program size and must divide the block size.
+ * \param buffer_size Size of the work buffer in bytes.
+ * \returns 0 if all diverged blocks were restored; -1 otherwise.
+ */
+int lfs_mirror_bd_resync(const struct lfs_config *lfs_cfg, void *buffer, lfs_size_t buffer_size);
+
+/**
+ * \brief Compares all blocks of both members and optionally copies the blocks
+ * that differ from the primary to the secondary member. Intended to be called
+ * before mounting after an unexpected reset.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param buffer Pointer to a work buffer. Half of the size must be a multiple
+ *        of the program size and must divide the block size.
+ * \param buffer_size Size of the work buffer in bytes.
+ * \param repair True to copy the differing blocks to the secondary member.
+ * \param diverged Pointer to store the number of differing blocks found. Can be
+ *        NULL.
+ * \returns 0 if the verification (and repair) was successful; -1 otherwise.
+ */
+int lfs_mirror_bd_verify(const struct lfs_config *lfs_cfg, void *buffer, lfs_size_t buffer_size,
+        bool repair, lfs_block_t *diverged);
+
+/**
+ * \brief Returns the read distribution and divergence statistics.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param stats Pointer to the structure to store the statistics.
+ */
+void lfs_mirror_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_mirror_bd_stats_t *stats);
+
+/**
+ * \brief Resets the statistics to zero.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_mirror_bd_reset_stats(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks both members, primary first.
+ * This function is internally called by the littlefs APIs when
+ * LFS_THREADSAFE is defined.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_mirror_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks both members, secondary first.
+ * This function is internally called by the littlefs APIs when
+ * LFS_THREADSAFE is defined.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_mirror_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_mirror_bd */
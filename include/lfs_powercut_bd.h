@@ -0,0 +1,337 @@
+/***************************************************************************//**
+ * \file lfs_powercut_bd.h
+ *
+ * \brief
+ * Implements a block device that injects power losses in front of another
+ * block device and measures the cost of the recovery that follows.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_powercut_bd Power-Loss Injection Block Device
+ * \{
+ * * Implements a block device that simulates a power loss in front of a block
+ * device populated by \ref lfs_spi_flash_bd_create() or \ref lfs_sd_bd_create().
+ * * The power is cut when a given number of program and erase operations has
+ * been issued. The number is either fixed or drawn from a seeded pseudo-random
+ * sequence, so a failing run can be reproduced from its seed.
+ * * The interrupted program can be torn, that is, only a prefix of the data
+ * is programmed. After the cut, every operation fails until
+ * \ref lfs_powercut_bd_power_on() is called.
+ * * Measures the recovery after each power-on: the number of block device
+ * calls and bytes, and the elapsed time between
+ * \ref lfs_powercut_bd_power_on() and \ref lfs_powercut_bd_recovery_done().
+ * The distribution of the recovery time is kept as a power-of-two histogram.
+ *
+ * The following loop remounts the filesystem after each injected power loss
+ * and records the mount cost. The filesystem is formatted once before the
+ * loop; a mount failure after a power loss is a failure of the test, not a
+ * reason to format. The consistency check and the workload are application
+ * specific. tools/lfs_powercut runs such a loop on the host with
+ * lfs_ram_bd and checks the contents of the files after each recovery.
+ * \code
+ * for(uint32_t cycle = 0U; cycle < CYCLES; cycle++)
+ * {
+ *     lfs_powercut_bd_power_on(&cut_cfg);
+ *     lfs_spi_flash_bd_create(&flash_cfg, &serial_memory_obj);
+ *     int err = lfs_mount(&lfs, &cut_cfg);
+ *     lfs_powercut_bd_recovery_done(&cut_cfg);
+ *     if(0 != err)
+ *     {
+ *         report_failure(cycle, err);     // The power loss corrupted the filesystem
+ *         break;
+ *     }
+ *     check_consistency(&lfs);
+ *     lfs_powercut_bd_arm(&cut_cfg);
+ *     run_workload(&lfs);             // Runs until the power is cut
+ *     lfs_unmount(&lfs);
+ *     lfs_spi_flash_bd_destroy(&flash_cfg);
+ * }
+ * lfs_powercut_bd_get_stats(&cut_cfg, &stats);
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * The wrapped lfs_config structure is referenced, not copied, so the
+ * backing driver can be destroyed and created again between cycles.
+ * * An interrupted erase is either not started or completed; partial erase
+ * cannot be produced through the block device interface.
+ */
+
+#ifndef LFS_POWERCUT_BD_H            /* Guard against multiple inclusion */
+#define LFS_POWERCUT_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_powercut_bd_unlock and lfs_powercut_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',4,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Enable trace for this driver by defining this macro. You must also define the
+ * global trace enable macro LFS_YES_TRACE.
+ */
+#ifdef LFS_POWERCUT_BD_YES_TRACE
+#define LFS_POWERCUT_BD_TRACE(...) LFS_TRACE(__VA_ARGS__)
+#else
+#define LFS_POWERCUT_BD_TRACE(...)
+#endif
+
+/** Number of buckets of the recovery time histogram. Bucket n counts the
+ * recoveries that took less than 2^n time units; the last bucket counts all
+ * longer recoveries.
+ */
+#ifndef LFS_POWERCUT_BD_HISTOGRAM_BUCKETS
+#define LFS_POWERCUT_BD_HISTOGRAM_BUCKETS       (24U)
+#endif /* #ifndef LFS_POWERCUT_BD_HISTOGRAM_BUCKETS */
+
+/** Returns a free-running time stamp, for example in microseconds. */
+typedef uint32_t (*lfs_powercut_bd_time_fn_t)(void);
+
+/** Configuration of a power-loss injection block device. */
+typedef struct
+{
+    /** lfs_config structure of the backing device. */
+    const struct lfs_config *backing;
+    /** Seed of the pseudo-random sequence. Zero selects a fixed cut point of
+     * max_ops operations.
+     */
+    uint32_t seed;
+    /** Upper bound of the number of program and erase operations issued
+     * before the power is cut. Must be greater than zero.
+     */
+    uint32_t max_ops;
+    /** True to program only a random prefix of the interrupted program. */
+    bool tear_prog;
+    /** Time source used to measure the recovery. Can be NULL. */
+    lfs_powercut_bd_time_fn_t get_time;
+} lfs_powercut_bd_config_t;
+
+/** Block device traffic counters. */
+typedef struct
+{
+    uint32_t read_count;    /**< Number of read calls */
+    uint32_t read_bytes;    /**< Number of bytes read */
+    uint32_t prog_count;    /**< Number of program calls */
+    uint32_t prog_bytes;    /**< Number of bytes programmed */
+    uint32_t erase_count;   /**< Number of erase calls */
+    uint32_t sync_count;    /**< Number of sync calls */
+} lfs_powercut_bd_counters_t;
+
+/** Statistics of the recoveries measured so far. */
+typedef struct
+{
+    uint32_t cuts;                              /**< Number of injected power losses */
+    uint32_t recoveries;                        /**< Number of completed recoveries */
+    uint32_t time_min;                          /**< Shortest recovery time */
+    uint32_t time_max;                          /**< Longest recovery time */
+    uint64_t time_total;                        /**< Sum of all recovery times */
+    lfs_powercut_bd_counters_t last;            /**< Traffic of the last recovery */
+    lfs_powercut_bd_counters_t worst;           /**< Traffic of the longest recovery */
+    lfs_powercut_bd_counters_t max;             /**< Largest value of each counter over all recoveries */
+    uint32_t histogram[LFS_POWERCUT_BD_HISTOGRAM_BUCKETS]; /**< Distribution of the recovery time */
+} lfs_powercut_bd_stats_t;
+
+/**
+ * Power-loss injection block device object. The content of this structure is
+ * for internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    lfs_powercut_bd_config_t config;
+    uint32_t rand_state;
+    uint32_t ops_left;
+    bool armed;
+    bool powered;
+    bool recovering;
+    uint32_t recovery_start;
+    lfs_powercut_bd_counters_t counters;
+    lfs_powercut_bd_stats_t stats;
+    /** \endcond */
+} lfs_powercut_bd_t;
+
+/**
+ * \brief Initializes the power-loss injection block device and populates the
+ * lfs_config structure with the values of the backing device. The device is
+ * powered and not armed.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param cut Pointer to the power-loss injection block device object.
+ * \param config Pointer to the configuration.
+ * \returns CY_RSLT_SUCCESS.
+ */
+cy_rslt_t lfs_powercut_bd_create(struct lfs_config *lfs_cfg, lfs_powercut_bd_t *cut,
+        const lfs_powercut_bd_config_t *config);
+
+/**
+ * \brief De-initializes the power-loss injection block device. The backing
+ * device is not destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_powercut_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Selects the next cut point and arms the power-loss injection.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_powercut_bd_arm(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Disarms the power-loss injection without cutting the power.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_powercut_bd_disarm(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Checks whether the power has been cut.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns true if the power is cut; false otherwise.
+ */
+bool lfs_powercut_bd_is_cut(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Restores the power and starts measuring a recovery.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_powercut_bd_power_on(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Ends the recovery measurement started by
+ * \ref lfs_powercut_bd_power_on() and adds it to the statistics. Typically
+ * called when lfs_mount() returns.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_powercut_bd_recovery_done(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Returns the recovery statistics.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param stats Pointer to the structure to store the statistics.
+ */
+void lfs_powercut_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_powercut_bd_stats_t *stats);
+
+/**
+ * \brief Reads data from the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns 0 if the read was successful; -1 if the power is cut;
+ *          the error of the backing device otherwise.
+ */
+int lfs_powercut_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data on the backing device, or cuts the power when the cut
+ * point is reached.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns 0 if the write was successful; -1 if the power is cut;
+ *          the error of the backing device otherwise.
+ */
+int lfs_powercut_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block of the backing device, or cuts the power when the cut
+ * point is reached.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns 0 if the erase was successful; -1 if the power is cut;
+ *          the error of the backing device otherwise.
+ */
+int lfs_powercut_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Syncs the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if the sync was successful; -1 if the power is cut;
+ *          the error of the backing device otherwise.
+ */
+int lfs_powercut_bd_sync(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_powercut_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_powercut_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_powercut_bd */
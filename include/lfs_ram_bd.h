@@ -0,0 +1,277 @@
+/***************************************************************************//**
+ * \file lfs_ram_bd.h
+ *
+ * \brief
+ * Implements the block device driver functions for a region of RAM for use
+ * with littlefs API.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_ram_bd RAM Block Device Driver
+ * \{
+ * * Implements the block device driver functions for a region of RAM, for
+ * scratch files that do not need to survive a reset and should not cost
+ * erase cycles of a flash memory.
+ * * Reads and programs are copies and erases fill the block with 0xFF, the
+ * erased value of a NOR flash.
+ * * The region is provided by the application. Set the retained field of
+ * \ref lfs_ram_bd_config_t for memory whose contents are kept across resets
+ * or low-power modes, such as retention RAM or a memory-mapped PSRAM. The
+ * contents are then left as they are by \ref lfs_ram_bd_create(), so the
+ * filesystem can be mounted again; otherwise the whole region is erased.
+ * * Set the check_nor field to make the driver enforce the rules of a NOR
+ * flash: a program must only target bytes that are erased. A violation is
+ * counted, reported by \ref lfs_ram_bd_get_violations(), and fails the
+ * program with LFS_ERR_IO. This catches, on the host or in RAM, layers that
+ * would corrupt a real flash memory.
+ * * Provides \ref lfs_ram_bd_lock() and \ref lfs_ram_bd_unlock() functions for
+ * use with lfs_config structure when LFS_THREADSAFE macro is defined. Each
+ * object has its own mutex.
+ *
+ * \code
+ * CY_SECTION(".cy_retained") static uint8_t scratch[32U * 4096U];
+ *
+ * lfs_ram_bd_config_t ram_config = {
+ *     .buffer = scratch, .prog_size = 16U, .block_size = 4096U,
+ *     .block_count = 32U, .retained = true, .check_nor = false
+ * };
+ * lfs_ram_bd_create(&ram_cfg, &ram, &ram_config);
+ * if(0 != lfs_mount(&lfs, &ram_cfg))
+ * {
+ *     (void)lfs_format(&lfs, &ram_cfg);
+ *     (void)lfs_mount(&lfs, &ram_cfg);
+ * }
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * Add DEFINE=LFS_THREADSAFE in the Makefile when thread-safety is required.
+ * * A retained region must be placed in a section that the startup code does
+ * not clear. littlefs detects a region that was not kept, for example after a
+ * power loss, and the mount fails.
+ * * Wear leveling is disabled because RAM does not wear out.
+ */
+
+#ifndef LFS_RAM_BD_H            /* Guard against multiple inclusion */
+#define LFS_RAM_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+#if defined(LFS_THREADSAFE)
+#include "cyabs_rtos.h"
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_ram_bd_unlock and lfs_ram_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',4,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Enable trace for this driver by defining this macro. You must also define the
+ * global trace enable macro LFS_YES_TRACE.
+ */
+#ifdef LFS_RAM_BD_YES_TRACE
+#define LFS_RAM_BD_TRACE(...) LFS_TRACE(__VA_ARGS__)
+#else
+#define LFS_RAM_BD_TRACE(...)
+#endif
+
+/** The geometry of the configuration is not valid: the block size is not a
+ * multiple of the program size, or a value is zero.
+ */
+#define LFS_RAM_BD_RSLT_ERR_GEOMETRY            \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0700U)
+
+/** Configuration of a RAM block device. */
+typedef struct
+{
+    /** Region of block_size * block_count bytes used by the filesystem. */
+    void *buffer;
+    /** Program and read size in bytes. Smaller values make littlefs use less
+     * of a block for small commits; 16 is a good default.
+     */
+    lfs_size_t prog_size;
+    /** Block size in bytes. Must be a multiple of prog_size. */
+    lfs_size_t block_size;
+    /** Number of blocks. */
+    lfs_size_t block_count;
+    /** true if the contents of the region are kept and must not be erased by
+     * \ref lfs_ram_bd_create().
+     */
+    bool retained;
+    /** true to fail programs of bytes that are not erased, as on a NOR flash. */
+    bool check_nor;
+} lfs_ram_bd_config_t;
+
+/**
+ * RAM block device object. The content of this structure is for internal use
+ * only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    uint8_t *buffer;
+    bool check_nor;
+    uint32_t violations;
+#if defined(LFS_THREADSAFE)
+    cy_mutex_t mutex;
+#endif /* #if defined(LFS_THREADSAFE) */
+    /** \endcond */
+} lfs_ram_bd_t;
+
+/**
+ * \brief Initializes the RAM block device and populates the lfs_config
+ * structure. The region is erased unless it is retained.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param ram Pointer to the RAM block device object.
+ * \param config Pointer to the configuration. Not used after the call.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful;
+ *          \ref LFS_RAM_BD_RSLT_ERR_GEOMETRY or an error code of the RTOS
+ *          abstraction otherwise.
+ */
+cy_rslt_t lfs_ram_bd_create(struct lfs_config *lfs_cfg, lfs_ram_bd_t *ram,
+        const lfs_ram_bd_config_t *config);
+
+/**
+ * \brief De-initializes the RAM block device. The region is left as it is.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_ram_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Reads data starting from a given block and offset.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns Always 0.
+ */
+int lfs_ram_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data starting from a given block and offset.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns 0 if the program was successful; LFS_ERR_IO if NOR checking is
+ *          enabled and a byte of the range is not erased.
+ */
+int lfs_ram_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a given block by filling it with 0xFF.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns Always 0.
+ */
+int lfs_ram_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Simply returns zero because the data is written by the program
+ * function.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns Always 0.
+ */
+int lfs_ram_bd_sync(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Returns the number of programs that targeted bytes that were not
+ * erased since the creation. Counted only when NOR checking is enabled.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns The number of violations.
+ */
+uint32_t lfs_ram_bd_get_violations(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks or gets the mutex associated with this block device.
+ * This function is internally called by the littlefs APIs when
+ * LFS_THREADSAFE is defined. User should call this function directly only if
+ * the other block device functions are directly called and thread-safety is
+ * required in that case.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_ram_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks or sets the mutex associated with this block device.
+ * This function is internally called by the littlefs APIs when
+ * LFS_THREADSAFE is defined. User should call this function directly only if
+ * the other block device functions are directly called and thread-safety is
+ * required in that case.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_ram_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_ram_bd */
@@ -0,0 +1,287 @@
+/***************************************************************************//**
+ * \file lfs_ring_log.h
+ *
+ * \brief
+ * Fixed-size circular record log on a reserved block range
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_ring_log Circular Record Log
+ * \{
+ * * Implements a fixed-size circular store of records for high-rate logging.
+ * The store runs directly on a block device such as \ref group_lfs_spi_flash_bd,
+ * in a contiguous range of blocks reserved for it and not used by littlefs,
+ * so appends do not pay for file metadata, CTZ skip-lists or compaction.
+ * * Records are packed back to back in pages of
+ * \ref lfs_ring_log_config_t::page_size bytes with a header of
+ * \ref LFS_RING_LOG_RECORD_OVERHEAD bytes: a tag byte, the record size and a
+ * 16-bit CRC of the tag, size and data.
+ * Each block starts with a header of \ref LFS_RING_LOG_BLOCK_HEADER_SIZE bytes
+ * that holds the sequence number of its first record. A page is programmed
+ * when it is full or when \ref lfs_ring_log_flush() is called.
+ * * Blocks are written in order and wrap at the end of the range. The blocks
+ * after the one being written are erased ahead of time, dropping the oldest
+ * records. With \ref lfs_ring_log_config_t::defer_erase set, these erases
+ * are left to \ref lfs_ring_log_maintain(), for example from an idle task, and
+ * an append only erases when no block is ready. An append then programs at
+ * most the pages it fills.
+ * * The RAM index holds the first sequence number of every block. A record
+ * is found by a binary search in the index followed by a scan of one block,
+ * so \ref lfs_ring_log_seek() to the tail or to any range is fast.
+ *
+ * \code
+ * static uint32_t index[64];
+ * static uint32_t buffer[LFS_RING_LOG_BUFFER_SIZE(256UL) / 4U];
+ * static const lfs_ring_log_config_t ring_cfg =
+ * {
+ *     .bd = &lfs_cfg, .first_block = 960U, .block_count = 64U, .page_size = 256U,
+ *     .erase_ahead = 1U, .defer_erase = true, .index = index, .buffer = buffer
+ * };
+ * lfs_ring_log_t ring;
+ * lfs_ring_log_cursor_t cursor;
+ * lfs_ring_log_info_t info;
+ *
+ * lfs_ring_log_open(&ring, &ring_cfg);
+ * lfs_ring_log_append(&ring, &sample, sizeof(sample));
+ *
+ * // Read the last 100 records.
+ * lfs_ring_log_get_info(&ring, &info);
+ * lfs_ring_log_seek(&ring, &cursor, info.next_seq - 100U);
+ * while(lfs_ring_log_next(&ring, &cursor, &sample, sizeof(sample)) > 0)
+ * {
+ *     ...
+ * }
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * Records appended since the last \ref lfs_ring_log_flush() are lost on
+ * power loss. A flush programs the partly filled page, and the next record
+ * starts on the next page, so frequent flushes use more memory.
+ * * \ref lfs_ring_log_open() finds the last record written. If the page after
+ * it is not erased, for example after a power loss during a program, writing
+ * continues in the next block. The records and pages need not read as 0xFF
+ * after an erase, so devices that erase to 0x00, such as some SD cards, can
+ * hold the log.
+ * * littlefs must not use the reserved range. Mount littlefs with a copy of
+ * the lfs_config of the block device whose block_count ends before the range,
+ * and pass the original to the log.
+ * * When LFS_THREADSAFE is defined, each function holds the lock of the block
+ * device while it runs.
+ */
+
+#ifndef LFS_RING_LOG_H            /* Guard against multiple inclusion */
+#define LFS_RING_LOG_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ */
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',5,\
+'The third-party defines the function interface with basic numeral type')
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Value of the magic field of a block header. */
+#define LFS_RING_LOG_MAGIC                      (0x474F4C52UL)
+
+/** Size in bytes of the header at the start of each block. */
+#define LFS_RING_LOG_BLOCK_HEADER_SIZE          (12UL)
+
+/** Size in bytes of the header of each record. */
+#define LFS_RING_LOG_RECORD_OVERHEAD            (5UL)
+
+/** Size in bytes of the buffer of \ref lfs_ring_log_config_t: one page to
+ * collect records and one page to cache reads.
+ */
+#define LFS_RING_LOG_BUFFER_SIZE(page_size)     (2UL * (page_size))
+
+/** Configuration of a circular log. */
+typedef struct
+{
+    const struct lfs_config *bd;        /**< Block device. Its read, prog, erase and sync functions and its geometry are used. */
+    lfs_block_t first_block;            /**< First block of the reserved range */
+    lfs_block_t block_count;            /**< Number of blocks in the range; at least erase_ahead + 2 */
+    lfs_size_t page_size;               /**< Size of a programmed page. A multiple of the program and read sizes that divides the block size; at least 16. */
+    lfs_block_t erase_ahead;            /**< Number of blocks kept erased after the one being written; at least 1 */
+    bool defer_erase;                   /**< If true, blocks are erased ahead by \ref lfs_ring_log_maintain() */
+    uint32_t *index;                    /**< Index of block_count words */
+    void *buffer;                       /**< Word-aligned buffer of \ref LFS_RING_LOG_BUFFER_SIZE bytes */
+} lfs_ring_log_config_t;
+
+/** State of a circular log. */
+typedef struct
+{
+    uint32_t first_seq;                 /**< Sequence number of the oldest record */
+    uint32_t next_seq;                  /**< Sequence number of the next record appended */
+    lfs_block_t used_blocks;            /**< Number of blocks that hold records */
+    lfs_block_t erased_blocks;          /**< Number of blocks erased ahead */
+    uint32_t programmed_pages;          /**< Number of pages programmed since the log was opened */
+    uint32_t append_erases;             /**< Number of erases done by \ref lfs_ring_log_append() since the log was opened */
+    uint32_t maintain_erases;           /**< Number of erases done by \ref lfs_ring_log_maintain() since the log was opened */
+} lfs_ring_log_info_t;
+
+/**
+ * Circular log object. The content of this structure is for internal use
+ * only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const lfs_ring_log_config_t *config;
+    uint8_t *page;
+    uint8_t *read_page;
+    lfs_block_t head;
+    lfs_off_t page_off;
+    lfs_off_t write_off;
+    lfs_block_t erased_ahead;
+    uint32_t next_seq;
+    lfs_block_t read_block;
+    lfs_off_t read_off;
+    uint32_t programmed_pages;
+    uint32_t append_erases;
+    uint32_t maintain_erases;
+    /** \endcond */
+} lfs_ring_log_t;
+
+/**
+ * Read position in a circular log. The content of this structure is for
+ * internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    uint32_t seq;
+    uint32_t block_seq;
+    lfs_block_t block;
+    lfs_off_t off;
+    /** \endcond */
+} lfs_ring_log_cursor_t;
+
+/**
+ * \brief Opens a circular log and rebuilds its index from the block headers.
+ * A range that holds no log is used as an empty log; its blocks are erased
+ * when they are needed.
+ * \param log Pointer to the log object.
+ * \param config Pointer to the configuration, used until the log is no longer
+ *        used.
+ * \returns 0 if successful; a block device error code otherwise.
+ */
+int lfs_ring_log_open(lfs_ring_log_t *log, const lfs_ring_log_config_t *config);
+
+/**
+ * \brief Appends a record. When the record does not fit in the current
+ * block, writing continues in the next block.
+ * \param log Pointer to the log object.
+ * \param data Pointer to the record.
+ * \param size Size of the record in bytes; not zero and at most 65535 and
+ *        the block size minus 17.
+ * \returns 0 if successful; a block device error code otherwise.
+ */
+int lfs_ring_log_append(lfs_ring_log_t *log, const void *data, lfs_size_t size);
+
+/**
+ * \brief Programs the partly filled page and syncs the block device.
+ * \param log Pointer to the log object.
+ * \returns 0 if successful; a block device error code otherwise.
+ */
+int lfs_ring_log_flush(lfs_ring_log_t *log);
+
+/**
+ * \brief Erases one block ahead of the block being written, if needed.
+ * Call it repeatedly when \ref lfs_ring_log_config_t::defer_erase is set.
+ * \param log Pointer to the log object.
+ * \returns The number of blocks that still need to be erased; a block
+ *          device error code otherwise.
+ */
+int lfs_ring_log_maintain(lfs_ring_log_t *log);
+
+/**
+ * \brief Sets a cursor to a record. A sequence number older than the oldest
+ * record sets the cursor to the oldest record, and one past the last record
+ * sets it to the end.
+ * \param log Pointer to the log object.
+ * \param cursor Pointer to the cursor.
+ * \param seq Sequence number of the record.
+ * \returns 0 if successful; LFS_ERR_CORRUPT if the block of the record is
+ *          damaged; a block device error code otherwise.
+ */
+int lfs_ring_log_seek(lfs_ring_log_t *log, lfs_ring_log_cursor_t *cursor, uint32_t seq);
+
+/**
+ * \brief Reads the record at a cursor and moves the cursor to the next one.
+ * \param log Pointer to the log object.
+ * \param cursor Pointer to a cursor set by \ref lfs_ring_log_seek().
+ * \param buffer Pointer to the buffer to store the record.
+ * \param size Size of the buffer in bytes.
+ * \returns The size of the record, zero at the end of the log;
+ *          LFS_ERR_NOENT if the record was dropped since the cursor was set;
+ *          LFS_ERR_NOSPC if the buffer is too small, and the cursor does not
+ *          move; LFS_ERR_CORRUPT if the record does not match its CRC, and the
+ *          cursor moves to the next block; a block device error code
+ *          otherwise.
+ */
+lfs_ssize_t lfs_ring_log_next(lfs_ring_log_t *log, lfs_ring_log_cursor_t *cursor, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Returns the state of a log.
+ * \param log Pointer to the log object.
+ * \param info Pointer to the structure to store the state.
+ */
+void lfs_ring_log_get_info(lfs_ring_log_t *log, lfs_ring_log_info_t *info);
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_ring_log */
@@ -0,0 +1,276 @@
+/***************************************************************************//**
+ * \file lfs_rw.h
+ *
+ * \brief
+ * Implements a shared/exclusive access wrapper for the littlefs API that lets
+ * read-only operations run concurrently.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_rw Shared/Exclusive Access Wrapper
+ * \{
+ * * Wraps a littlefs filesystem so that read-only operations run concurrently
+ * while operations that modify the filesystem run alone.
+ * * Read-only operations, such as \ref lfs_rw_stat(), \ref lfs_rw_read_file()
+ * and \ref lfs_rw_dir_foreach(), take a shared lock. Operations that modify
+ * the filesystem, such as \ref lfs_rw_write_file(), take an exclusive lock.
+ * A waiting writer blocks new readers, so writers are not starved.
+ * * littlefs keeps caches in the lfs_t structure, so a single instance cannot
+ * be used by two tasks at once. Each concurrent reader therefore uses its own
+ * read-only instance from a pool of \ref lfs_rw_reader_t provided by the
+ * application. A reader instance is mounted again after the filesystem has
+ * been modified.
+ * * The readers serialize only their block device reads; the processing of
+ * littlefs, such as path lookup and CRC calculation, runs in parallel.
+ * * Arbitrary operations can be run with \ref lfs_rw_shared() and
+ * \ref lfs_rw_exclusive().
+ *
+ * tools/lfs_rw_bench measures on the host how the read throughput scales
+ * with the number of reader threads, compared with a single mutex. On the
+ * target, each reader task calls read_config() in a loop for a fixed time,
+ * and the number of completed reads is compared for 1, 2, 4 and 8 tasks:
+ * \code
+ * static void read_config(void)
+ * {
+ *     uint8_t buffer[128];
+ *     (void)lfs_rw_read_file(&rw, "config.bin", buffer, sizeof(buffer));
+ *     reads_done++;
+ * }
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * Requires an RTOS: add COMPONENTS=RTOS_AWARE or DEFINES=LFS_THREADSAFE in
+ * the Makefile.
+ * * The buffers of the reader instances are allocated by littlefs, so the
+ * read_buffer, prog_buffer and lookahead_buffer fields of the lfs_config
+ * structure are not used by the readers, and LFS_NO_MALLOC must not be
+ * defined.
+ * * The filesystem must not be accessed other than through this wrapper while
+ * it is mounted.
+ */
+
+#ifndef LFS_RW_H            /* Guard against multiple inclusion */
+#define LFS_RW_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+#include "cyabs_rtos.h"
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ */
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',11,\
+'The third-party defines the function interface with basic numeral type')
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Operation run by \ref lfs_rw_shared() or \ref lfs_rw_exclusive(). Returns
+ * a littlefs error code.
+ */
+typedef int (*lfs_rw_fn_t)(lfs_t *lfs, void *arg);
+
+/** Called by \ref lfs_rw_dir_foreach() for each directory entry. Returns zero
+ * to continue, or a value that stops the iteration and is returned.
+ */
+typedef int (*lfs_rw_dir_fn_t)(const struct lfs_info *info, void *arg);
+
+/**
+ * Reader instance. The content of this structure is for internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    lfs_t lfs;
+    uint32_t generation;
+    bool mounted;
+    bool busy;
+    /** \endcond */
+} lfs_rw_reader_t;
+
+/**
+ * Shared/exclusive access wrapper object. The content of this structure is for
+ * internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const struct lfs_config *cfg;
+    struct lfs_config reader_cfg;
+    lfs_t writer;
+    lfs_rw_reader_t *readers;
+    uint32_t reader_count;
+    uint32_t generation;
+    uint32_t active_readers;
+    cy_semaphore_t turnstile;
+    cy_semaphore_t room_empty;
+    cy_semaphore_t free_readers;
+    cy_mutex_t state_mutex;
+    cy_mutex_t device_mutex;
+    /** \endcond */
+} lfs_rw_t;
+
+/**
+ * \brief Mounts the filesystem for use through the wrapper.
+ * \param rw Pointer to the wrapper object.
+ * \param cfg Pointer to the lfs_config structure of the filesystem.
+ * \param readers Pointer to an array of reader instances.
+ * \param reader_count Number of reader instances, that is, the maximum number
+ *        of concurrent read-only operations.
+ * \returns 0 if the mount was successful; a littlefs error code otherwise.
+ *          On failure, the RTOS objects of the wrapper are deleted and
+ *          \ref lfs_rw_unmount() must not be called.
+ */
+int lfs_rw_mount(lfs_rw_t *rw, const struct lfs_config *cfg,
+        lfs_rw_reader_t *readers, uint32_t reader_count);
+
+/**
+ * \brief Waits for the running operations and unmounts the filesystem.
+ * \param rw Pointer to the wrapper object.
+ * \returns 0 if the unmount was successful; a littlefs error code otherwise.
+ */
+int lfs_rw_unmount(lfs_rw_t *rw);
+
+/**
+ * \brief Runs a read-only operation under the shared lock. The operation must
+ * not modify the filesystem.
+ * \param rw Pointer to the wrapper object.
+ * \param fn Operation to run on a reader instance.
+ * \param arg Argument of the operation.
+ * \returns The result of the operation, or a littlefs error code if the
+ *          reader instance could not be mounted.
+ */
+int lfs_rw_shared(lfs_rw_t *rw, lfs_rw_fn_t fn, void *arg);
+
+/**
+ * \brief Runs an operation under the exclusive lock.
+ * \param rw Pointer to the wrapper object.
+ * \param fn Operation to run.
+ * \param arg Argument of the operation.
+ * \returns The result of the operation.
+ */
+int lfs_rw_exclusive(lfs_rw_t *rw, lfs_rw_fn_t fn, void *arg);
+
+/**
+ * \brief Finds information about a file or a directory under the shared lock.
+ * \param rw Pointer to the wrapper object.
+ * \param path Path of the file or directory.
+ * \param info Pointer to the structure to store the information.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_rw_stat(lfs_rw_t *rw, const char *path, struct lfs_info *info);
+
+/**
+ * \brief Reads the beginning of a file under the shared lock.
+ * \param rw Pointer to the wrapper object.
+ * \param path Path of the file.
+ * \param buffer Pointer to the buffer to store the data.
+ * \param size Size of the buffer in bytes.
+ * \returns The number of bytes read; a littlefs error code otherwise.
+ */
+lfs_ssize_t lfs_rw_read_file(lfs_rw_t *rw, const char *path, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Reads the entries of a directory under the shared lock.
+ * \param rw Pointer to the wrapper object.
+ * \param path Path of the directory.
+ * \param fn Function called for each entry.
+ * \param arg Argument of the function.
+ * \returns 0 if all entries were read; the non-zero value returned by the
+ *          function or a littlefs error code otherwise.
+ */
+int lfs_rw_dir_foreach(lfs_rw_t *rw, const char *path, lfs_rw_dir_fn_t fn, void *arg);
+
+/**
+ * \brief Replaces the content of a file, creating it when needed, under the
+ * exclusive lock.
+ * \param rw Pointer to the wrapper object.
+ * \param path Path of the file.
+ * \param data Pointer to the data to write.
+ * \param size Number of bytes to write.
+ * \returns The number of bytes written; a littlefs error code otherwise.
+ */
+lfs_ssize_t lfs_rw_write_file(lfs_rw_t *rw, const char *path, const void *data, lfs_size_t size);
+
+/**
+ * \brief Removes a file or an empty directory under the exclusive lock.
+ * \param rw Pointer to the wrapper object.
+ * \param path Path of the file or directory.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_rw_remove(lfs_rw_t *rw, const char *path);
+
+/**
+ * \brief Renames or moves a file or a directory under the exclusive lock.
+ * \param rw Pointer to the wrapper object.
+ * \param old_path Current path.
+ * \param new_path New path.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_rw_rename(lfs_rw_t *rw, const char *old_path, const char *new_path);
+
+/**
+ * \brief Creates a directory under the exclusive lock.
+ * \param rw Pointer to the wrapper object.
+ * \param path Path of the directory.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_rw_mkdir(lfs_rw_t *rw, const char *path);
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_rw */
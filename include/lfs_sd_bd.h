@@ -71,6 +71,7 @@
 
 #include "lfs.h"
 #include "lfs_util.h"
+#include "lfs_bd_geometry.h"
 #include "cy_result.h"
 #include "mtb_hal_sdhc.h"
 #include <stdbool.h>
@@ -0,0 +1,191 @@
+/***************************************************************************//**
+ * \file lfs_snapshot.h
+ *
+ * \brief
+ * Implements a block-level backup of a mounted filesystem that streams only
+ * the blocks in use.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_snapshot Filesystem Snapshot
+ * \{
+ * * Implements a block-level backup of a mounted filesystem that streams only
+ * the blocks in use.
+ * * \ref lfs_snapshot_export() finds the blocks in use with lfs_fs_traverse(),
+ * which reports the metadata and the data of all files and directories. It
+ * then reads the runs of consecutive blocks in use from the block device, in
+ * reads of up to a block and in batches of the size of the buffer, and passes
+ * the stream to a sink function. Free blocks are not read, so the time of a
+ * backup depends on the space in use, not on the capacity.
+ * * The stream holds a header, the runs of blocks and a trailer with a CRC, in
+ * the format described below. The tools/lfs_restore host tool turns it into a
+ * raw image of the region that can be programmed on a device.
+ *
+ * \code
+ * static uint8_t bitmap[LFS_SNAPSHOT_BITMAP_SIZE(BLOCK_COUNT)];
+ * static uint8_t buffer[8192];
+ *
+ * static int send(void *context, const void *data, lfs_size_t size)
+ * {
+ *     return (CY_RSLT_SUCCESS == uart_write(context, data, size)) ? 0 : LFS_ERR_IO;
+ * }
+ *
+ * lfs_snapshot_config_t config = { bitmap, buffer, sizeof(buffer), send, &uart };
+ * lfs_snapshot_stats_t stats;
+ * int err = lfs_snapshot_export(&lfs, &flash_cfg, &config, &stats);
+ * \endcode
+ *
+ * The stream is made of little-endian 32-bit words and block data:
+ * <table class="doxtable">
+ *   <tr><th>Part</th><th>Content</th></tr>
+ *   <tr>
+ *     <td>Header</td>
+ *     <td>\ref LFS_SNAPSHOT_MAGIC, \ref LFS_SNAPSHOT_VERSION, block size, block
+ *     count, number of blocks in use</td>
+ *   </tr>
+ *   <tr>
+ *     <td>Run</td>
+ *     <td>First block, number of blocks n, then the data of the n blocks</td>
+ *   </tr>
+ *   <tr>
+ *     <td>Trailer</td>
+ *     <td>\ref LFS_SNAPSHOT_END, CRC-32 of all the bytes before the CRC,
+ *     computed with lfs_crc() from 0xFFFFFFFF</td>
+ *   </tr>
+ * </table>
+ *
+ * <b>Note:</b>
+ * * The filesystem must not change during the export. When LFS_THREADSAFE is
+ * defined, the lock of the lfs_config structure is held for the whole
+ * export, so it must be recursive, as the mutexes of the RTOS abstraction
+ * are. Without it, the application must not use the filesystem meanwhile.
+ * * Programs that littlefs has cached but not written, for example in a file
+ * that is not synced, are not part of the snapshot.
+ */
+
+#ifndef LFS_SNAPSHOT_H            /* Guard against multiple inclusion */
+#define LFS_SNAPSHOT_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ */
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',2,\
+'The third-party defines the function interface with basic numeral type')
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** First word of a snapshot, "SNAP" in ASCII. */
+#define LFS_SNAPSHOT_MAGIC                      (0x50414E53UL)
+
+/** Version of the snapshot format. */
+#define LFS_SNAPSHOT_VERSION                    (1UL)
+
+/** First word of the trailer, in place of the first block of a run. */
+#define LFS_SNAPSHOT_END                        (0xFFFFFFFFUL)
+
+/** Size in bytes of the header. */
+#define LFS_SNAPSHOT_HEADER_SIZE                (20UL)
+
+/** Size in bytes of the bitmap for block_count blocks. */
+#define LFS_SNAPSHOT_BITMAP_SIZE(block_count)   (((block_count) + 7UL) / 8UL)
+
+/**
+ * Receives the next part of the stream. Returns 0 if successful; a negative
+ * error code otherwise, which stops the export.
+ */
+typedef int (*lfs_snapshot_sink_fn_t)(void *context, const void *data, lfs_size_t size);
+
+/** Configuration of an export. */
+typedef struct
+{
+    /** Bitmap of \ref LFS_SNAPSHOT_BITMAP_SIZE(block_count) bytes. */
+    uint8_t *bitmap;
+    /** Buffer for the blocks read. */
+    uint8_t *buffer;
+    /** Size of the buffer in bytes, a multiple of the read size. A multiple of
+     * the block size gives the fewest reads.
+     */
+    lfs_size_t buffer_size;
+    /** Function that receives the stream. */
+    lfs_snapshot_sink_fn_t sink;
+    /** Context passed to the sink. */
+    void *sink_context;
+} lfs_snapshot_config_t;
+
+/** Statistics of an export. */
+typedef struct
+{
+    uint32_t used_blocks;                   /**< Number of blocks in use */
+    uint32_t runs;                          /**< Number of runs of consecutive blocks */
+    uint32_t stream_bytes;                  /**< Number of bytes passed to the sink */
+} lfs_snapshot_stats_t;
+
+/**
+ * \brief Streams the blocks in use of a mounted filesystem to a sink.
+ * \param lfs Pointer to the mounted filesystem.
+ * \param lfs_cfg Pointer to the lfs_config structure with which the
+ *        filesystem is mounted.
+ * \param config Pointer to the configuration of the export.
+ * \param stats Pointer to the structure to store the statistics. Can be NULL.
+ * \returns 0 if successful; the error code of littlefs, of the block device or
+ *          of the sink otherwise.
+ */
+int lfs_snapshot_export(lfs_t *lfs, const struct lfs_config *lfs_cfg,
+        const lfs_snapshot_config_t *config, lfs_snapshot_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_snapshot */
@@ -75,6 +75,61 @@
  * * Littlefs can use the memory with blocks of the same size. For hybrid
  * memory, it is compulsory to limit the size available for littlefs by the
  * \ref lfs_spi_flash_bd_configure_memory function to use only same-size blocks.
+ * * littlefs reads metadata in small pieces because read_size is 1 byte. An
+ * optional read cache configured by \ref lfs_spi_flash_bd_configure_read_cache
+ * turns these reads into full-line QSPI transfers. Reads of a line size or
+ * larger bypass the cache. Lines of a block are invalidated when the block is
+ * programmed or erased, so littlefs still verifies programmed data against
+ * the memory.
+ * * By default, the littlefs cache is one program page. Define
+ * \ref LFS_SPI_FLASH_BD_CACHE_PAGES in the DEFINES variable of the Makefile
+ * to make the cache several pages long. littlefs then passes several pages to
+ * \ref lfs_spi_flash_bd_prog() at once, and serial-flash programs them in one
+ * call, one page after another, without returning to littlefs in between.
+ * Each littlefs cache grows by the same factor.
+ * * A block erase keeps the memory busy for up to hundreds of milliseconds,
+ * and serial-flash polls the status register during that time. When
+ * \ref lfs_spi_flash_bd_configure_erase_wait is called, the driver issues the
+ * erase itself and calls a wait function between status polls, for example
+ * an RTOS delay, so other tasks run and the CPU can sleep. The polling
+ * interval is derived from the erase time discovered through SFDP. This option
+ * is not available when ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH is defined.
+ * The erase commands bypass the lock of serial-flash, so no other task may use
+ * the SMIF block while littlefs is in use.
+ * * For a product with a known memory part, define
+ * LFS_SPI_FLASH_BD_FIXED_GEOMETRY together with the program size
+ * LFS_SPI_FLASH_BD_FIXED_PROG_SIZE, the erase block size
+ * LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE, the number of blocks
+ * LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT and optionally the start address
+ * LFS_SPI_FLASH_BD_FIXED_ADDRESS_START in the DEFINES variable of the
+ * Makefile. \ref lfs_spi_flash_bd_create then does not query the memory
+ * parameters, and the block addresses are computed from constants. In debug
+ * builds, the values are checked against the parameters discovered by
+ * serial-flash.
+ * \code DEFINES += LFS_SPI_FLASH_BD_FIXED_GEOMETRY LFS_SPI_FLASH_BD_FIXED_PROG_SIZE=256UL LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE=4096UL LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT=1024UL \endcode
+ * * The SFDP discovery of the memory runs in mtb_serial_memory_setup(), before
+ * \ref lfs_spi_flash_bd_create is called, and is not part of this driver.
+ * \ref lfs_spi_flash_bd_create only queries the parameters that serial-flash
+ * keeps after the discovery and sends no command to the memory. The
+ * tools/lfs_boot_bench host tool breaks the boot time down into the setup,
+ * the driver creation and the mount for both geometry builds.
+ * * Reformatting or provisioning a unit block by block through
+ * \ref lfs_spi_flash_bd_erase sends one erase request per block.
+ * \ref lfs_spi_flash_bd_erase_region wipes the whole region used by littlefs
+ * with a single request to serial-flash instead: a chip erase when the region
+ * covers the whole memory, otherwise a sweep of sector erases that serial-flash
+ * runs without returning to the driver. The erase never extends outside the
+ * region configured by \ref lfs_spi_flash_bd_configure_memory, and when
+ * ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH is defined a chip erase is refused.
+ * The erase-wait option is not used for the wipe.
+ * \code
+ * lfs_spi_flash_bd_erase_region_stats_t wipe;
+ * lfs_spi_flash_bd_create(&lfs_cfg, &serial_memory_obj);
+ * if(CY_RSLT_SUCCESS == lfs_spi_flash_bd_erase_region(&lfs_cfg, get_time_ms, &wipe))
+ * {
+ *     lfs_format(&lfs, &lfs_cfg);
+ * }
+ * \endcode
  */
 
 #ifndef LFS_SPI_FLASH_BD_H            /* Guard against multiple inclusion */
@@ -82,6 +137,7 @@
 
 #include "lfs.h"
 #include "lfs_util.h"
+#include "lfs_bd_geometry.h"
 #include "cy_result.h"
 #include "cy_smif_memslot.h"
 #include "mtb_serial_memory.h"
@@ -122,6 +178,73 @@ extern "C"
 #endif
 
 
+#if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY)
+#if !defined(LFS_SPI_FLASH_BD_FIXED_PROG_SIZE) || !defined(LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE) || \
+    !defined(LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT)
+#error "LFS_SPI_FLASH_BD_FIXED_GEOMETRY requires LFS_SPI_FLASH_BD_FIXED_PROG_SIZE, LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE and LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT"
+#endif
+
+/** Start address of the region used by littlefs in a fixed-geometry build. */
+#ifndef LFS_SPI_FLASH_BD_FIXED_ADDRESS_START
+#define LFS_SPI_FLASH_BD_FIXED_ADDRESS_START    (0UL)
+#endif /* #ifndef LFS_SPI_FLASH_BD_FIXED_ADDRESS_START */
+#endif /* #if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY) */
+
+/** Size in bytes of the buffer required by
+ * \ref lfs_spi_flash_bd_configure_read_cache for a given line size and number
+ * of sets. The buffer holds one tag word and one line per set.
+ */
+#define LFS_SPI_FLASH_BD_READ_CACHE_BUFFER_SIZE(line_size, set_count) \
+    ((set_count) * ((line_size) + sizeof(uint32_t)))
+
+/** Read cache statistics */
+typedef struct
+{
+    uint32_t requests;          /**< Number of reads served through the cache */
+    uint32_t bypassed;          /**< Number of reads of a line size or larger sent directly to the memory */
+    uint32_t hits;              /**< Number of line lookups that found the line */
+    uint32_t misses;            /**< Number of line lookups that loaded the line */
+    uint32_t invalidations;     /**< Number of lines invalidated by program or erase */
+    uint32_t commands_saved;    /**< Number of read commands avoided: requests minus line loads */
+} lfs_spi_flash_bd_read_cache_stats_t;
+
+#if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH)
+/** Divisor of the maximum erase time that gives the delay before the first
+ * status poll of an erase.
+ */
+#ifndef LFS_SPI_FLASH_BD_ERASE_WAIT_FIRST_DIVISOR
+#define LFS_SPI_FLASH_BD_ERASE_WAIT_FIRST_DIVISOR   (8UL)
+#endif /* #ifndef LFS_SPI_FLASH_BD_ERASE_WAIT_FIRST_DIVISOR */
+
+/** Divisor of the maximum erase time that gives the delay between the
+ * following status polls of an erase. The delay is at least 1 ms.
+ */
+#ifndef LFS_SPI_FLASH_BD_ERASE_WAIT_POLL_DIVISOR
+#define LFS_SPI_FLASH_BD_ERASE_WAIT_POLL_DIVISOR    (32UL)
+#endif /* #ifndef LFS_SPI_FLASH_BD_ERASE_WAIT_POLL_DIVISOR */
+
+/** Waits for the given number of milliseconds while the memory is busy. */
+typedef void (*lfs_spi_flash_bd_wait_fn_t)(uint32_t delay_ms);
+#endif /* #if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH) */
+
+/** The region used by littlefs cannot be wiped without erasing memory
+ * outside of it.
+ */
+#define LFS_SPI_FLASH_BD_RSLT_ERR_REGION            \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0302U))
+
+/** Returns a time in milliseconds. Used to measure the duration of a wipe. */
+typedef uint32_t (*lfs_spi_flash_bd_time_fn_t)(void);
+
+/** Result of \ref lfs_spi_flash_bd_erase_region */
+typedef struct
+{
+    uint32_t address;           /**< Start of the wiped region */
+    uint32_t erased_bytes;      /**< Size of the wiped region */
+    bool chip_erase;            /**< true if the region covers the whole memory and a chip erase was requested */
+    uint32_t time_ms;           /**< Wall-clock time of the wipe; 0 without a time source */
+} lfs_spi_flash_bd_erase_region_stats_t;
+
 /**
  * \brief Configures the memory region used by littlefs. If this function
  * is not called, the littlefs will use the whole size of the memory module.
@@ -134,6 +257,57 @@ extern "C"
  */
 void lfs_spi_flash_bd_configure_memory(const struct lfs_config *lfs_cfg, uint32_t address, uint32_t region_size);
 
+/**
+ * \brief Configures a direct-mapped read cache for small reads. If this
+ * function is not called, every read is sent to the memory. The function must
+ * be called before lfs_spi_flash_bd_create(). After de-initialization of
+ * littlefs, the settings configured by this function are lost.
+ * \param lfs_cfg The pointer to the block device configuration structure
+ * \param buffer Pointer to a word-aligned buffer of
+ *        \ref LFS_SPI_FLASH_BD_READ_CACHE_BUFFER_SIZE bytes.
+ * \param line_size Size of a cache line in bytes. Must be a power of two, for
+ *        example 64 to 512, and must divide the block size.
+ * \param set_count Number of cache lines.
+ */
+void lfs_spi_flash_bd_configure_read_cache(const struct lfs_config *lfs_cfg, void *buffer,
+        uint32_t line_size, uint32_t set_count);
+
+/**
+ * \brief Returns the read cache statistics.
+ * \param lfs_cfg The pointer to the block device configuration structure
+ * \param stats Pointer to the structure to store the statistics.
+ */
+void lfs_spi_flash_bd_get_read_cache_stats(const struct lfs_config *lfs_cfg,
+        lfs_spi_flash_bd_read_cache_stats_t *stats);
+
+#if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH)
+/**
+ * \brief Makes the driver erase blocks with SMIF commands and call a wait
+ * function between the status polls, instead of erasing through serial-flash.
+ * The arguments are the ones used to set up the serial-flash object. Blocks
+ * whose size differs from the erase size of the memory configuration, as in
+ * hybrid memories, are still erased through serial-flash. After
+ * de-initialization of littlefs, the settings configured by this function
+ * are lost.
+ * The commands are issued directly to the SMIF block and bypass the lock and
+ * state of serial-flash. The driver only issues them when the SMIF block is in
+ * command mode and idle, and erases through serial-flash otherwise. Because
+ * the wait function lets other tasks run during the erase, the application
+ * must not access the SMIF block from other tasks, through serial-flash or
+ * directly, while littlefs uses it. With LFS_THREADSAFE, the driver calls of
+ * littlefs are already serialized by the mutex of the driver.
+ * \param lfs_cfg The pointer to the block device configuration structure
+ * \param base The address of the SMIF registers.
+ * \param mem_config The memory configuration of the memory used by littlefs.
+ * \param context The SMIF context.
+ * \param wait The wait function. If NULL, cy_rtos_delay_milliseconds() is
+ *        used; this requires COMPONENTS=RTOS_AWARE.
+ */
+void lfs_spi_flash_bd_configure_erase_wait(const struct lfs_config *lfs_cfg, SMIF_Type *base,
+        cy_stc_smif_mem_config_t *mem_config, cy_stc_smif_context_t *context,
+        lfs_spi_flash_bd_wait_fn_t wait);
+#endif /* #if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH) */
+
 /**
  * \brief Initializes the SPI flash and populates the lfs_config structure with
  * the default values.
@@ -188,6 +362,25 @@ int lfs_spi_flash_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
  */
 int lfs_spi_flash_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
 
+/**
+ * \brief Erases all the blocks used by littlefs with the largest erase
+ * available for the region: a chip erase if the region is the whole memory,
+ * otherwise one sector-erase sweep. The filesystem must not be mounted. This
+ * is a blocking function.
+ * \param lfs_cfg Pointer to the lfs_config structure initialized by
+ *        \ref lfs_spi_flash_bd_create.
+ * \param get_time Time source in milliseconds. If NULL,
+ *        cy_rtos_get_time() is used with COMPONENTS=RTOS_AWARE; otherwise the
+ *        time is not measured.
+ * \param stats Pointer to the structure to store the result. Can be NULL.
+ * \returns CY_RSLT_SUCCESS if the region was erased;
+ *          \ref LFS_SPI_FLASH_BD_RSLT_ERR_REGION if the region does not start
+ *          and end on sector boundaries, or is the whole memory while it also
+ *          holds XIP code; the serial-flash error code otherwise.
+ */
+cy_rslt_t lfs_spi_flash_bd_erase_region(const struct lfs_config *lfs_cfg, lfs_spi_flash_bd_time_fn_t get_time,
+        lfs_spi_flash_bd_erase_region_stats_t *stats);
+
 /**
  * \brief Flushes the write cache when present. Simply returns zero
  * because QSPI block does not have any write cache in MMIO mode.
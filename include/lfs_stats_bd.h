@@ -0,0 +1,267 @@
+/***************************************************************************//**
+ * \file lfs_stats_bd.h
+ *
+ * \brief
+ * Implements a block device that counts the calls, bytes and time spent in
+ * another block device, broken down by application-defined phases.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_stats_bd Statistics Block Device
+ * \{
+ * * Implements a block device that counts the traffic of another block device
+ * populated by \ref lfs_spi_flash_bd_create() or \ref lfs_sd_bd_create().
+ * * The counters are kept per phase. The application selects the current
+ * phase with \ref lfs_stats_bd_set_phase(), for example lfs_mount() and the
+ * first lfs_file_open(), and reads the breakdown with
+ * \ref lfs_stats_bd_get_phase().
+ * * For each phase, the number of read, program, erase and sync calls, the
+ * number of bytes, the wall-clock time of the phase and the time spent inside
+ * the backing device are recorded. The difference between the two times is
+ * the processing time of littlefs, which is dominated by CRC calculation
+ * during mount.
+ * * Reads that start at offset 0 of a block are counted as block scans. A
+ * metadata fetch of littlefs starts with such a read, but so do other reads,
+ * and the CRC passes of littlefs are not visible at the block device
+ * interface. tools/lfs_stats_bench counts the CRC work on the host, together
+ * with these counters, as a function of fill level, file count and directory
+ * depth.
+ *
+ * The following sequence measures the boot-to-ready time. Driver creation does
+ * not go through the block device interface and is timed directly. The
+ * cache_size and lookahead_size fields of the statistics lfs_config structure
+ * can be changed after \ref lfs_stats_bd_create() to compare different
+ * settings.
+ * \code
+ * uint32_t start = get_time_us();
+ * lfs_spi_flash_bd_create(&flash_cfg, &serial_memory_obj);
+ * uint32_t create_time = get_time_us() - start;
+ *
+ * lfs_stats_bd_create(&stats_cfg, &stats, &flash_cfg, get_time_us);
+ * lfs_stats_bd_set_phase(&stats_cfg, 0U);
+ * lfs_mount(&lfs, &stats_cfg);
+ * lfs_stats_bd_set_phase(&stats_cfg, 1U);
+ * lfs_file_open(&lfs, &file, "config.bin", LFS_O_RDONLY);
+ * lfs_stats_bd_set_phase(&stats_cfg, LFS_STATS_BD_NO_PHASE);
+ * \endcode
+ */
+
+#ifndef LFS_STATS_BD_H            /* Guard against multiple inclusion */
+#define LFS_STATS_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_stats_bd_unlock and lfs_stats_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',4,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Number of phases for which counters are kept. */
+#ifndef LFS_STATS_BD_PHASES
+#define LFS_STATS_BD_PHASES                     (4U)
+#endif /* #ifndef LFS_STATS_BD_PHASES */
+
+/** Phase value that stops counting. */
+#define LFS_STATS_BD_NO_PHASE                   (0xFFFFFFFFUL)
+
+/** Returns a free-running time stamp, for example in microseconds. */
+typedef uint32_t (*lfs_stats_bd_time_fn_t)(void);
+
+/** Counters of one phase. */
+typedef struct
+{
+    uint32_t read_count;    /**< Number of read calls */
+    uint32_t read_bytes;    /**< Number of bytes read */
+    uint32_t block_scans;   /**< Number of reads starting at offset 0 of a block */
+    uint32_t prog_count;    /**< Number of program calls */
+    uint32_t prog_bytes;    /**< Number of bytes programmed */
+    uint32_t erase_count;   /**< Number of erase calls */
+    uint32_t sync_count;    /**< Number of sync calls */
+    uint32_t elapsed;       /**< Wall-clock time of the phase */
+    uint32_t bd_time;       /**< Time spent inside the backing device */
+} lfs_stats_bd_counters_t;
+
+/**
+ * Statistics block device object. The content of this structure is for
+ * internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const struct lfs_config *backing;
+    lfs_stats_bd_time_fn_t get_time;
+    uint32_t phase;
+    uint32_t phase_start;
+    lfs_stats_bd_counters_t counters[LFS_STATS_BD_PHASES];
+    /** \endcond */
+} lfs_stats_bd_t;
+
+/**
+ * \brief Initializes the statistics block device and populates the lfs_config
+ * structure with the values of the backing device. Counting is stopped until
+ * \ref lfs_stats_bd_set_phase() is called.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param stats Pointer to the statistics block device object.
+ * \param backing Pointer to the lfs_config structure of the backing device.
+ * \param get_time Time source used to measure the phases. Can be NULL.
+ * \returns CY_RSLT_SUCCESS.
+ */
+cy_rslt_t lfs_stats_bd_create(struct lfs_config *lfs_cfg, lfs_stats_bd_t *stats,
+        const struct lfs_config *backing, lfs_stats_bd_time_fn_t get_time);
+
+/**
+ * \brief De-initializes the statistics block device. The backing device is not
+ * destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_stats_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Ends the current phase and starts counting into another one.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param phase Index of the phase, less than \ref LFS_STATS_BD_PHASES, or
+ *        \ref LFS_STATS_BD_NO_PHASE to stop counting.
+ */
+void lfs_stats_bd_set_phase(const struct lfs_config *lfs_cfg, uint32_t phase);
+
+/**
+ * \brief Returns the counters of a phase.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param phase Index of the phase.
+ * \param counters Pointer to the structure to store the counters.
+ */
+void lfs_stats_bd_get_phase(const struct lfs_config *lfs_cfg, uint32_t phase,
+        lfs_stats_bd_counters_t *counters);
+
+/**
+ * \brief Returns the sum of the counters of all phases.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param counters Pointer to the structure to store the counters.
+ */
+void lfs_stats_bd_get_total(const struct lfs_config *lfs_cfg, lfs_stats_bd_counters_t *counters);
+
+/**
+ * \brief Resets the counters of all phases to zero.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_stats_bd_reset(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Reads data from the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns The result of the backing device.
+ */
+int lfs_stats_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data on the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns The result of the backing device.
+ */
+int lfs_stats_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block of the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns The result of the backing device.
+ */
+int lfs_stats_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Syncs the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns The result of the backing device.
+ */
+int lfs_stats_bd_sync(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_stats_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_stats_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_stats_bd */
@@ -0,0 +1,528 @@
+/***************************************************************************//**
+ * \file lfs_svc.h
+ *
+ * \brief
+ * Provides APIs to use a littlefs filesystem mounted on another CPU core.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_svc Cross-Core Filesystem Service
+ * \{
+ * * Lets a second CPU core use a filesystem that is mounted on another core.
+ * The block device drivers assume a single owner of the SMIF or SDHC object,
+ * so only one core mounts the filesystem and runs the server. The other core
+ * uses a client that forwards each file and directory operation to it.
+ * * The server runs the operations on its lfs_t one at a time with
+ * \ref lfs_svc_server_process(), called in a loop from a dedicated task.
+ * * Each client owns one \ref lfs_svc_request_t in memory shared by both
+ * cores. The path and the results of an operation are carried in it, and only
+ * a pointer to it is passed between the cores.
+ * * File data is not copied: the read and write buffers of the client are
+ * accessed directly by the server, so they must be in shared memory as well.
+ * * The pointers are passed through a transport, \ref lfs_svc_transport_t. A
+ * transport built on two single-producer, single-consumer rings in shared
+ * memory is provided by \ref lfs_svc_ring_port_init(); it calls a notify
+ * function of the application, for example one that triggers an IPC
+ * interrupt, and the interrupt handler of the other core calls
+ * \ref lfs_svc_ring_port_signal(). Other transports, such as two tasks on one
+ * core for testing, only need to provide the send and receive functions.
+ *
+ * The following code sets up the service with the IPC driver. The notify
+ * functions trigger an IPC interrupt on the other core, whose handler
+ * calls lfs_svc_ring_port_signal(&port, true).
+ * \code
+ * CY_SECTION_SHAREDMEM static lfs_svc_ring_t to_server;
+ * CY_SECTION_SHAREDMEM static lfs_svc_ring_t to_client;
+ * CY_SECTION_SHAREDMEM static lfs_svc_request_t request;
+ * CY_SECTION_SHAREDMEM static uint8_t data[512];
+ *
+ * // Core that owns the memory, with the filesystem mounted in lfs
+ * lfs_svc_ring_init(&to_server);
+ * lfs_svc_ring_init(&to_client);
+ * lfs_svc_ring_port_init(&port, &transport, &to_client, &to_server, notify_client, NULL);
+ * lfs_svc_server_init(&server, &lfs, &transport);
+ * for(;;)
+ * {
+ *     (void)lfs_svc_server_process(&server, CY_RTOS_NEVER_TIMEOUT);
+ * }
+ *
+ * // Other core
+ * lfs_svc_ring_port_init(&port, &transport, &to_server, &to_client, notify_server, NULL);
+ * lfs_svc_client_init(&client, &transport, &request, CY_RTOS_NEVER_TIMEOUT);
+ * int file = lfs_svc_file_open(&client, "log.txt", LFS_O_RDONLY);
+ * lfs_ssize_t read = lfs_svc_file_read(&client, file, data, sizeof(data));
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * Requires an RTOS: add COMPONENTS=RTOS_AWARE or DEFINES=LFS_THREADSAFE in
+ * the Makefile.
+ * * The shared memory must be mapped at the same address on both cores,
+ * because pointers are passed unchanged. The rings must not be cached, since
+ * their indices are written by both cores. The requests and data buffers can
+ * be cached if \ref LFS_SVC_CLEAN_DCACHE and \ref LFS_SVC_INVALIDATE_DCACHE
+ * are defined; they must then be aligned to and sized in whole cache lines.
+ * * The server accesses the buffers of the requests without checking them;
+ * use it only between cores that trust each other.
+ * * A pair of rings carries the requests of exactly one client. Each ring has
+ * a single producer, and a response is handed to whichever client waits on
+ * the port, so two clients on one pair would corrupt the ring and take each
+ * other's responses. The tasks of one core therefore share one client, whose
+ * operations are serialized. To serve more clients, give each its own pair of
+ * rings and its own server task, and define LFS_THREADSAFE so that the
+ * servers can share the lfs_t.
+ * * If the server does not answer within the timeout of the client, the
+ * request may still be in use by the server, so all later operations of the
+ * client fail with LFS_ERR_IO.
+ */
+
+#ifndef LFS_SVC_H            /* Guard against multiple inclusion */
+#define LFS_SVC_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+#include "cyabs_rtos.h"
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ */
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',12,\
+'The third-party defines the function interface with basic numeral type')
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Maximum length of a path, including the terminating null character. */
+#ifndef LFS_SVC_PATH_MAX
+#define LFS_SVC_PATH_MAX                        (64U)
+#endif /* #ifndef LFS_SVC_PATH_MAX */
+
+/** Number of files that can be open on the server at once. */
+#ifndef LFS_SVC_MAX_FILES
+#define LFS_SVC_MAX_FILES                       (4U)
+#endif /* #ifndef LFS_SVC_MAX_FILES */
+
+/** Number of directories that can be open on the server at once. */
+#ifndef LFS_SVC_MAX_DIRS
+#define LFS_SVC_MAX_DIRS                        (2U)
+#endif /* #ifndef LFS_SVC_MAX_DIRS */
+
+/** Number of entries of a ring. Must be a power of two. */
+#ifndef LFS_SVC_RING_SIZE
+#define LFS_SVC_RING_SIZE                       (4U)
+#endif /* #ifndef LFS_SVC_RING_SIZE */
+
+/** Orders the accesses to a ring. Define it, for example as __DMB(), for
+ * compilers that do not provide __sync_synchronize().
+ */
+#ifndef LFS_SVC_BARRIER
+#define LFS_SVC_BARRIER()                       __sync_synchronize()
+#endif /* #ifndef LFS_SVC_BARRIER */
+
+/** Writes the cached data of a shared area back to the memory. Define it, for
+ * example as SCB_CleanDCache_by_Addr(), when the requests and the data
+ * buffers are in cached memory.
+ */
+#ifndef LFS_SVC_CLEAN_DCACHE
+#define LFS_SVC_CLEAN_DCACHE(addr, size)        do { (void)(addr); (void)(size); } while(false)
+#endif /* #ifndef LFS_SVC_CLEAN_DCACHE */
+
+/** Discards the cached data of a shared area. Define it, for example as
+ * SCB_InvalidateDCache_by_Addr(), when the requests and the data buffers are
+ * in cached memory.
+ */
+#ifndef LFS_SVC_INVALIDATE_DCACHE
+#define LFS_SVC_INVALIDATE_DCACHE(addr, size)   do { (void)(addr); (void)(size); } while(false)
+#endif /* #ifndef LFS_SVC_INVALIDATE_DCACHE */
+
+/** The ring has no free entry. */
+#define LFS_SVC_RSLT_ERR_RING_FULL              \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0600U)
+
+/**
+ * Request of a client. Must be placed in memory shared by both cores. The
+ * content of this structure is for internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    uint32_t op;
+    int32_t handle;
+    int32_t flags;
+    int32_t offset;
+    void *buffer;
+    lfs_size_t size;
+    int32_t result;
+    struct lfs_info info;
+    char path[LFS_SVC_PATH_MAX];
+    char new_path[LFS_SVC_PATH_MAX];
+    /** \endcond */
+} lfs_svc_request_t;
+
+/**
+ * Sends a request, or the response to a request, to the other side.
+ * Returns CY_RSLT_SUCCESS if successful; an error code otherwise.
+ */
+typedef cy_rslt_t (*lfs_svc_send_fn_t)(void *context, lfs_svc_request_t *request);
+
+/**
+ * Waits for a request, or the response to a request, from the other side.
+ * Returns CY_RSLT_SUCCESS if one was received; an error code on timeout.
+ */
+typedef cy_rslt_t (*lfs_svc_receive_fn_t)(void *context, lfs_svc_request_t **request,
+        cy_time_t timeout_ms);
+
+/** Transport between a client and the server. */
+typedef struct
+{
+    lfs_svc_send_fn_t send;                 /**< Sends a pointer to a request */
+    lfs_svc_receive_fn_t receive;           /**< Receives a pointer to a request */
+    void *context;                          /**< Context of the functions */
+} lfs_svc_transport_t;
+
+/**
+ * Single-producer, single-consumer ring of request pointers. Must be placed
+ * in memory shared by both cores that is not cached. A pair of rings serves
+ * one client and one server. The content of this
+ * structure is for internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    lfs_svc_request_t *volatile entries[LFS_SVC_RING_SIZE];
+    /** \endcond */
+} lfs_svc_ring_t;
+
+/** Signals the other side that an entry was added to a ring. */
+typedef void (*lfs_svc_notify_fn_t)(void *arg);
+
+/**
+ * Ring transport of one side. The content of this structure is for internal
+ * use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    lfs_svc_ring_t *tx;
+    lfs_svc_ring_t *rx;
+    lfs_svc_notify_fn_t notify;
+    void *notify_arg;
+    cy_semaphore_t event;
+    /** \endcond */
+} lfs_svc_ring_port_t;
+
+/**
+ * Server object. The content of this structure is for internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    lfs_t *lfs;
+    const lfs_svc_transport_t *transport;
+    lfs_file_t files[LFS_SVC_MAX_FILES];
+    lfs_dir_t dirs[LFS_SVC_MAX_DIRS];
+    bool file_open[LFS_SVC_MAX_FILES];
+    bool dir_open[LFS_SVC_MAX_DIRS];
+    /** \endcond */
+} lfs_svc_server_t;
+
+/**
+ * Client object. The content of this structure is for internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const lfs_svc_transport_t *transport;
+    lfs_svc_request_t *request;
+    cy_time_t timeout_ms;
+    bool failed;
+    cy_mutex_t mutex;
+    /** \endcond */
+} lfs_svc_client_t;
+
+/**
+ * \brief Initializes a ring. Called once, by one of the cores, before either
+ * side uses it.
+ * \param ring Pointer to the ring in shared memory.
+ */
+void lfs_svc_ring_init(lfs_svc_ring_t *ring);
+
+/**
+ * \brief Initializes the ring transport of one side.
+ * \param port Pointer to the ring transport object.
+ * \param transport Pointer to the transport to populate.
+ * \param tx Pointer to the ring written by this side.
+ * \param rx Pointer to the ring read by this side.
+ * \param notify Function that signals the other side, for example by
+ *        triggering an IPC interrupt. Can be NULL if the other side polls.
+ * \param notify_arg Argument of the notify function.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful; an error
+ *          code of the RTOS abstraction otherwise.
+ */
+cy_rslt_t lfs_svc_ring_port_init(lfs_svc_ring_port_t *port, lfs_svc_transport_t *transport,
+        lfs_svc_ring_t *tx, lfs_svc_ring_t *rx, lfs_svc_notify_fn_t notify, void *notify_arg);
+
+/**
+ * \brief De-initializes the ring transport of one side.
+ * \param port Pointer to the ring transport object.
+ */
+void lfs_svc_ring_port_deinit(lfs_svc_ring_port_t *port);
+
+/**
+ * \brief Wakes up the side that waits on the port. Called when the other side
+ * has notified this side, for example from the IPC interrupt handler.
+ * \param port Pointer to the ring transport object.
+ * \param in_isr true if called from an interrupt handler.
+ */
+void lfs_svc_ring_port_signal(lfs_svc_ring_port_t *port, bool in_isr);
+
+/**
+ * \brief Initializes the server. The filesystem must be mounted and is used
+ * only by the server task from then on, unless LFS_THREADSAFE is defined.
+ * \param server Pointer to the server object.
+ * \param lfs Pointer to the mounted filesystem.
+ * \param transport Pointer to the transport of the server side.
+ */
+void lfs_svc_server_init(lfs_svc_server_t *server, lfs_t *lfs,
+        const lfs_svc_transport_t *transport);
+
+/**
+ * \brief Waits for one request, runs it and sends the response.
+ * \param server Pointer to the server object.
+ * \param timeout_ms Time to wait for a request, in milliseconds.
+ * \returns CY_RSLT_SUCCESS if a request was processed; the error code of the
+ *          transport otherwise.
+ */
+cy_rslt_t lfs_svc_server_process(lfs_svc_server_t *server, cy_time_t timeout_ms);
+
+/**
+ * \brief Closes the files and directories left open by the clients. The
+ * filesystem is not unmounted.
+ * \param server Pointer to the server object.
+ */
+void lfs_svc_server_deinit(lfs_svc_server_t *server);
+
+/**
+ * \brief Initializes a client.
+ * \param client Pointer to the client object.
+ * \param transport Pointer to the transport of the client side. Must not be
+ *        shared with another client.
+ * \param request Pointer to the request of the client in shared memory.
+ * \param timeout_ms Time to wait for each response, in milliseconds.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful; an error
+ *          code of the RTOS abstraction otherwise.
+ */
+cy_rslt_t lfs_svc_client_init(lfs_svc_client_t *client, const lfs_svc_transport_t *transport,
+        lfs_svc_request_t *request, cy_time_t timeout_ms);
+
+/**
+ * \brief De-initializes a client. The files and directories it opened are
+ * not closed.
+ * \param client Pointer to the client object.
+ */
+void lfs_svc_client_deinit(lfs_svc_client_t *client);
+
+/**
+ * \brief Opens a file on the server.
+ * \param client Pointer to the client object.
+ * \param path Path of the file.
+ * \param flags Flags of lfs_file_open().
+ * \returns A non-negative file handle if successful; a littlefs error code
+ *          otherwise. LFS_ERR_NOMEM is returned if \ref LFS_SVC_MAX_FILES
+ *          files are open.
+ */
+int lfs_svc_file_open(lfs_svc_client_t *client, const char *path, int flags);
+
+/**
+ * \brief Closes a file.
+ * \param client Pointer to the client object.
+ * \param file File handle.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_file_close(lfs_svc_client_t *client, int32_t file);
+
+/**
+ * \brief Reads data from a file directly into a shared buffer.
+ * \param client Pointer to the client object.
+ * \param file File handle.
+ * \param buffer Pointer to the buffer in shared memory.
+ * \param size Number of bytes to read.
+ * \returns The number of bytes read; a littlefs error code otherwise.
+ */
+lfs_ssize_t lfs_svc_file_read(lfs_svc_client_t *client, int32_t file, void *buffer,
+        lfs_size_t size);
+
+/**
+ * \brief Writes data to a file directly from a shared buffer.
+ * \param client Pointer to the client object.
+ * \param file File handle.
+ * \param buffer Pointer to the data in shared memory.
+ * \param size Number of bytes to write.
+ * \returns The number of bytes written; a littlefs error code otherwise.
+ */
+lfs_ssize_t lfs_svc_file_write(lfs_svc_client_t *client, int32_t file, const void *buffer,
+        lfs_size_t size);
+
+/**
+ * \brief Changes the position of a file.
+ * \param client Pointer to the client object.
+ * \param file File handle.
+ * \param off Offset.
+ * \param whence LFS_SEEK_SET, LFS_SEEK_CUR or LFS_SEEK_END.
+ * \returns The new position; a littlefs error code otherwise.
+ */
+lfs_soff_t lfs_svc_file_seek(lfs_svc_client_t *client, int32_t file, lfs_soff_t off,
+        int whence);
+
+/**
+ * \brief Returns the size of a file.
+ * \param client Pointer to the client object.
+ * \param file File handle.
+ * \returns The size in bytes; a littlefs error code otherwise.
+ */
+lfs_soff_t lfs_svc_file_size(lfs_svc_client_t *client, int32_t file);
+
+/**
+ * \brief Writes the pending data of a file to the memory.
+ * \param client Pointer to the client object.
+ * \param file File handle.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_file_sync(lfs_svc_client_t *client, int32_t file);
+
+/**
+ * \brief Truncates or extends a file.
+ * \param client Pointer to the client object.
+ * \param file File handle.
+ * \param size New size in bytes.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_file_truncate(lfs_svc_client_t *client, int32_t file, lfs_off_t size);
+
+/**
+ * \brief Removes a file or an empty directory.
+ * \param client Pointer to the client object.
+ * \param path Path of the file or directory.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_remove(lfs_svc_client_t *client, const char *path);
+
+/**
+ * \brief Renames or moves a file or a directory.
+ * \param client Pointer to the client object.
+ * \param old_path Current path.
+ * \param new_path New path.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_rename(lfs_svc_client_t *client, const char *old_path, const char *new_path);
+
+/**
+ * \brief Creates a directory.
+ * \param client Pointer to the client object.
+ * \param path Path of the directory.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_mkdir(lfs_svc_client_t *client, const char *path);
+
+/**
+ * \brief Finds information about a file or a directory.
+ * \param client Pointer to the client object.
+ * \param path Path of the file or directory.
+ * \param info Pointer to the structure to store the information.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_stat(lfs_svc_client_t *client, const char *path, struct lfs_info *info);
+
+/**
+ * \brief Opens a directory on the server.
+ * \param client Pointer to the client object.
+ * \param path Path of the directory.
+ * \returns A non-negative directory handle if successful; a littlefs error
+ *          code otherwise. LFS_ERR_NOMEM is returned if
+ *          \ref LFS_SVC_MAX_DIRS directories are open.
+ */
+int lfs_svc_dir_open(lfs_svc_client_t *client, const char *path);
+
+/**
+ * \brief Closes a directory.
+ * \param client Pointer to the client object.
+ * \param dir Directory handle.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_svc_dir_close(lfs_svc_client_t *client, int32_t dir);
+
+/**
+ * \brief Reads the next entry of a directory.
+ * \param client Pointer to the client object.
+ * \param dir Directory handle.
+ * \param info Pointer to the structure to store the entry.
+ * \returns A positive value if an entry was read, 0 at the end of the
+ *          directory; a littlefs error code otherwise.
+ */
+int lfs_svc_dir_read(lfs_svc_client_t *client, int32_t dir, struct lfs_info *info);
+
+/**
+ * \brief Returns the number of allocated blocks of the filesystem.
+ * \param client Pointer to the client object.
+ * \returns The number of blocks; a littlefs error code otherwise.
+ */
+lfs_ssize_t lfs_svc_fs_size(lfs_svc_client_t *client);
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_svc */
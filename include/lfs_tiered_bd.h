@@ -0,0 +1,351 @@
+/***************************************************************************//**
+ * \file lfs_tiered_bd.h
+ *
+ * \brief
+ * Implements a tiered block device for use with the littlefs API. Frequently
+ * used blocks of a backing block device are kept resident in a RAM region.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_tiered_bd Tiered Block Device
+ * \{
+ * * Implements a block device that keeps frequently used blocks of a backing
+ * block device resident in a RAM region, for example external PSRAM or
+ * HyperRAM mapped through a second SMIF slot, or internal SRAM.
+ * * The backing device is an lfs_config structure populated by
+ * \ref lfs_spi_flash_bd_create().
+ * * Reads of resident blocks are served from RAM and do not access the
+ * backing device. A read miss loads the whole block into a free slot or into
+ * the least recently used slot that is not pinned.
+ * * Program and erase operations are written through to the backing device.
+ * The resident copy of a programmed block is refreshed from the backing
+ * device, so the read-back with which littlefs verifies a program still
+ * detects bad programs and bad blocks.
+ * * When deferred mode is enabled, program and erase operations are applied
+ * to RAM only and written to the backing device by \ref lfs_tiered_bd_sync(),
+ * on eviction, or by \ref lfs_tiered_bd_flush(), in the order in which the
+ * blocks were first modified. An eviction first writes back the blocks
+ * modified before the victim. An operation on a dirty block that is not the
+ * block modified last first writes back all pending operations, so the
+ * backing device receives the operations in the order littlefs issued them.
+ * When no slot is available because all slots are pinned, an operation
+ * writes back all pending operations and then goes to the backing device
+ * directly.
+ * * Blocks can be pinned with \ref lfs_tiered_bd_pin(). The
+ * \ref LFS_TIERED_BD_POLICY_LRU_PIN_ROOT policy pins the superblock pair,
+ * which also holds the root directory, as soon as it is loaded.
+ * * Provides residency and hit-rate statistics through
+ * \ref lfs_tiered_bd_get_stats().
+ *
+ * <b>Note:</b>
+ * * Each slot holds one whole block. The RAM region must be at least
+ * slot_count * block_size bytes.
+ * * In deferred mode, data written after the last sync is lost on power loss.
+ * littlefs calls sync at the end of every metadata commit, so the filesystem
+ * stays consistent, but the deferred window grows with the number of writes
+ * between commits. littlefs verifies programs against the RAM copy only, so
+ * a bad program of the backing device is not detected in this mode.
+ */
+
+#ifndef LFS_TIERED_BD_H            /* Guard against multiple inclusion */
+#define LFS_TIERED_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_tiered_bd_unlock and lfs_tiered_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',9,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/**
+ * Enable trace for this driver by defining this macro. You must also define the
+ * global trace enable macro LFS_YES_TRACE.
+ */
+#ifdef LFS_TIERED_BD_YES_TRACE
+#define LFS_TIERED_BD_TRACE(...) LFS_TRACE(__VA_ARGS__)
+#else
+#define LFS_TIERED_BD_TRACE(...)
+#endif
+
+/** Value of an erased byte of the backing device, used for the resident copy of
+ * an erased block.
+ */
+#ifndef LFS_TIERED_BD_ERASE_VALUE
+#define LFS_TIERED_BD_ERASE_VALUE               (0xFFU)
+#endif /* #ifndef LFS_TIERED_BD_ERASE_VALUE */
+
+/** The RAM region is too small for the requested number of slots. */
+#define LFS_TIERED_BD_RSLT_ERR_RAM_SIZE         \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0200U)
+
+/** Eviction policies of the tiered block device. */
+typedef enum
+{
+    /** Evict the least recently used slot that is not pinned. */
+    LFS_TIERED_BD_POLICY_LRU,
+    /** Same as \ref LFS_TIERED_BD_POLICY_LRU, and pin blocks 0 and 1 (the
+     * superblock and root directory pair) when they are loaded.
+     */
+    LFS_TIERED_BD_POLICY_LRU_PIN_ROOT
+} lfs_tiered_bd_policy_t;
+
+/** State of one RAM slot. The content of this structure is for internal use
+ * only; the application provides the storage.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    lfs_block_t block;
+    uint32_t last_use;
+    uint32_t dirty_seq;
+    lfs_off_t dirty_start;
+    lfs_off_t dirty_end;
+    uint8_t flags;
+    /** \endcond */
+} lfs_tiered_bd_slot_t;
+
+/** Configuration of a tiered block device. */
+typedef struct
+{
+    /** lfs_config structure of the backing device, populated by
+     * \ref lfs_spi_flash_bd_create().
+     */
+    const struct lfs_config *backing;
+    /** Start of the RAM region used to hold resident blocks. */
+    void *ram;
+    /** Size of the RAM region in bytes. */
+    uint32_t ram_size;
+    /** Array of slot_count slot descriptors. */
+    lfs_tiered_bd_slot_t *slots;
+    /** Number of resident blocks. */
+    uint32_t slot_count;
+    /** Eviction policy. */
+    lfs_tiered_bd_policy_t policy;
+    /** True to defer program and erase operations until sync. */
+    bool deferred;
+} lfs_tiered_bd_config_t;
+
+/** Residency and hit-rate statistics of a tiered block device. */
+typedef struct
+{
+    uint32_t read_hits;         /**< Number of reads served from RAM */
+    uint32_t read_misses;       /**< Number of reads that accessed the backing device */
+    uint32_t fills;             /**< Number of blocks loaded into RAM */
+    uint32_t evictions;         /**< Number of resident blocks evicted */
+    uint32_t deferred_writes;   /**< Number of program and erase operations applied to RAM only */
+    uint32_t write_backs;       /**< Number of dirty blocks written to the backing device */
+    uint32_t resident;          /**< Number of blocks currently resident */
+    uint32_t pinned;            /**< Number of blocks currently pinned */
+    uint32_t dirty;             /**< Number of resident blocks not yet written to the backing device */
+} lfs_tiered_bd_stats_t;
+
+/**
+ * Tiered block device object. The content of this structure is for internal
+ * use only. The object must stay allocated while the device is in use.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const struct lfs_config *backing;
+    uint8_t *ram;
+    lfs_tiered_bd_slot_t *slots;
+    uint32_t slot_count;
+    lfs_tiered_bd_policy_t policy;
+    bool deferred;
+    uint32_t tick;
+    uint32_t dirty_seq;
+    lfs_tiered_bd_stats_t stats;
+    /** \endcond */
+} lfs_tiered_bd_t;
+
+/**
+ * \brief Initializes the tiered block device and populates the lfs_config
+ * structure with the geometry of the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param tiered Pointer to the tiered block device object.
+ * \param config Pointer to the tiered block device configuration.
+ * \returns CY_RSLT_SUCCESS if the initialization was successful; an error code
+ *          otherwise.
+ */
+cy_rslt_t lfs_tiered_bd_create(struct lfs_config *lfs_cfg, lfs_tiered_bd_t *tiered,
+        const lfs_tiered_bd_config_t *config);
+
+/**
+ * \brief Writes back the dirty blocks and de-initializes the tiered block
+ * device. The backing device is not destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_tiered_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Reads the data starting from a given block and offset. Resident
+ * blocks are served from RAM.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns 0 if the read was successful; -1 otherwise.
+ */
+int lfs_tiered_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs the data starting from a given block and offset. The data is
+ * written through to the backing device unless deferred mode is enabled.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns 0 if the write was successful; -1 otherwise.
+ */
+int lfs_tiered_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a given block. The erase is written through to the backing
+ * device unless deferred mode is enabled.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns 0 if the erase was successful; -1 otherwise.
+ */
+int lfs_tiered_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Writes back all dirty blocks and syncs the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if the sync was successful; -1 otherwise.
+ */
+int lfs_tiered_bd_sync(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Writes back all dirty blocks without syncing the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if the write-back was successful; -1 otherwise.
+ */
+int lfs_tiered_bd_flush(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Loads a block into RAM if needed and prevents it from being evicted.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to pin.
+ * \returns 0 if the block is resident and pinned; -1 if no slot is available or
+ *          the load failed.
+ */
+int lfs_tiered_bd_pin(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Allows a pinned block to be evicted again.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to unpin.
+ */
+void lfs_tiered_bd_unpin(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Checks whether a block is resident in RAM.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to check.
+ * \returns true if the block is resident; false otherwise.
+ */
+bool lfs_tiered_bd_is_resident(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Returns the residency and hit-rate statistics.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param stats Pointer to the structure to store the statistics.
+ */
+void lfs_tiered_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_tiered_bd_stats_t *stats);
+
+/**
+ * \brief Resets the hit, miss and traffic counters to zero. The residency
+ * counters are not affected.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_tiered_bd_reset_stats(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the backing device.
+ * This function is internally called by the littlefs APIs when
+ * LFS_THREADSAFE is defined.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_tiered_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the backing device.
+ * This function is internally called by the littlefs APIs when
+ * LFS_THREADSAFE is defined.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_tiered_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_tiered_bd */
@@ -0,0 +1,383 @@
+/***************************************************************************//**
+ * \file lfs_wa_bd.h
+ *
+ * \brief
+ * Implements a block device that attributes the bytes programmed and erased on
+ * another block device to the littlefs operation and file that caused them.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_wa_bd Write Amplification Block Device
+ * \{
+ * * Implements a block device that measures how many bytes are programmed and
+ * erased on another block device, populated by \ref lfs_spi_flash_bd_create()
+ * or \ref lfs_sd_bd_create(), for each byte written by the application.
+ * * The programs and erases are attributed to the operation and the file that
+ * are active. The application tags them with \ref lfs_wa_bd_begin() and
+ * \ref lfs_wa_bd_end() around a littlefs call, or uses
+ * \ref lfs_wa_bd_file_write(), \ref lfs_wa_bd_file_sync() and
+ * \ref lfs_wa_bd_file_close(), which do it for the most common calls.
+ * Programs and erases outside a tagged call, for example during lfs_mount(),
+ * are counted as \ref LFS_WA_BD_OP_UNTAGGED.
+ * * A file is tracked by name with \ref lfs_wa_bd_track() after it is opened.
+ * Its counters are kept after it is closed and accumulate when a file with the
+ * same name is opened again. Up to \ref LFS_WA_BD_MAX_FILES names are kept;
+ * the writes to other files are counted only per operation.
+ * * \ref lfs_wa_bd_prog_ratio() and \ref lfs_wa_bd_erase_ratio() return the
+ * amplification of a set of counters.
+ *
+ * \code
+ * lfs_wa_bd_create(&wa_cfg, &wa, &flash_cfg);
+ * lfs_mount(&lfs, &wa_cfg);
+ *
+ * lfs_file_open(&lfs, &file, "log.bin", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
+ * lfs_wa_bd_track(&wa_cfg, &file, "log.bin");
+ * lfs_wa_bd_file_write(&wa_cfg, &lfs, &file, record, sizeof(record));
+ * lfs_wa_bd_file_close(&wa_cfg, &lfs, &file);
+ *
+ * lfs_wa_bd_file_stats_t stats;
+ * for(uint32_t i = 0U; lfs_wa_bd_get_file(&wa_cfg, i, &stats); i++)
+ * {
+ *     printf("%s: %u.%02u\n", stats.name, lfs_wa_bd_prog_ratio(&stats.counters) / 100U,
+ *            lfs_wa_bd_prog_ratio(&stats.counters) % 100U);
+ * }
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * The bytes written to a file are programmed when littlefs flushes its
+ * cache, which can happen in the sync or close of the file. Both are
+ * attributed to the file, so the ratio of a file includes them.
+ * * When LFS_THREADSAFE is defined, \ref lfs_wa_bd_begin() takes the lock of
+ * the block device and \ref lfs_wa_bd_end() releases it, so that the calls of
+ * other tasks are not attributed to the tagged call. The lock of the backing
+ * device must then be recursive, as the mutexes of the RTOS abstraction are.
+ * If the lock cannot be taken, \ref lfs_wa_bd_begin() returns its error and
+ * the wrappers return it without calling littlefs.
+ */
+
+#ifndef LFS_WA_BD_H            /* Guard against multiple inclusion */
+#define LFS_WA_BD_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ * Functions lfs_wa_bd_unlock and lfs_wa_bd_lock don't reproduce violations if LFS_THREADSAFE not defined.
+ */
+
+#if defined(LFS_THREADSAFE)
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',9,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Number of file names for which counters are kept. */
+#ifndef LFS_WA_BD_MAX_FILES
+#define LFS_WA_BD_MAX_FILES                     (8U)
+#endif /* #ifndef LFS_WA_BD_MAX_FILES */
+
+/** Number of files that can be tracked while open. */
+#ifndef LFS_WA_BD_MAX_OPEN
+#define LFS_WA_BD_MAX_OPEN                      (4U)
+#endif /* #ifndef LFS_WA_BD_MAX_OPEN */
+
+/** Size of the file names kept, including the terminating null character.
+ * Longer names are truncated.
+ */
+#ifndef LFS_WA_BD_NAME_SIZE
+#define LFS_WA_BD_NAME_SIZE                     (32U)
+#endif /* #ifndef LFS_WA_BD_NAME_SIZE */
+
+/** Operation to which programs and erases are attributed. */
+typedef enum
+{
+    LFS_WA_BD_OP_UNTAGGED,                  /**< Outside a tagged call */
+    LFS_WA_BD_OP_WRITE,                     /**< lfs_file_write() */
+    LFS_WA_BD_OP_SYNC,                      /**< lfs_file_sync() and lfs_file_close() */
+    LFS_WA_BD_OP_METADATA,                  /**< Other calls, such as lfs_file_open() or lfs_remove() */
+    LFS_WA_BD_OP_COUNT                      /**< Number of operations */
+} lfs_wa_bd_op_t;
+
+/** Counters of an operation or a file. */
+typedef struct
+{
+    uint32_t calls;                         /**< Number of tagged calls */
+    uint64_t logical_bytes;                 /**< Number of bytes written by the application */
+    uint64_t prog_bytes;                    /**< Number of bytes programmed */
+    uint32_t erases;                        /**< Number of blocks erased */
+    uint64_t erased_bytes;                  /**< Number of bytes erased */
+} lfs_wa_bd_counters_t;
+
+/** Counters of a file. */
+typedef struct
+{
+    char name[LFS_WA_BD_NAME_SIZE];         /**< Name given to \ref lfs_wa_bd_track() */
+    lfs_wa_bd_counters_t counters;          /**< Counters of the file */
+} lfs_wa_bd_file_stats_t;
+
+/**
+ * Write amplification block device object. The content of this structure is
+ * for internal use only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    const struct lfs_config *backing;
+    lfs_wa_bd_op_t op;
+    lfs_wa_bd_counters_t *file;
+    const lfs_file_t *open_handles[LFS_WA_BD_MAX_OPEN];
+    uint32_t open_slots[LFS_WA_BD_MAX_OPEN];
+    uint32_t file_count;
+    lfs_wa_bd_counters_t ops[LFS_WA_BD_OP_COUNT];
+    lfs_wa_bd_file_stats_t files[LFS_WA_BD_MAX_FILES];
+    /** \endcond */
+} lfs_wa_bd_t;
+
+/**
+ * \brief Initializes the write amplification block device and populates the
+ * lfs_config structure with the values of the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure that will be
+ *        initialized with the default values.
+ * \param wa Pointer to the write amplification block device object.
+ * \param backing Pointer to the lfs_config structure of the backing device.
+ * \returns CY_RSLT_SUCCESS.
+ */
+cy_rslt_t lfs_wa_bd_create(struct lfs_config *lfs_cfg, lfs_wa_bd_t *wa,
+        const struct lfs_config *backing);
+
+/**
+ * \brief De-initializes the write amplification block device. The backing
+ * device is not destroyed.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_wa_bd_destroy(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Attributes the following programs and erases of an open file to its
+ * name.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param file Pointer to the open file.
+ * \param path Name under which the counters are kept.
+ * \returns true if the file is tracked; false if \ref LFS_WA_BD_MAX_OPEN files
+ *          are tracked or \ref LFS_WA_BD_MAX_FILES names are kept.
+ */
+bool lfs_wa_bd_track(const struct lfs_config *lfs_cfg, const lfs_file_t *file, const char *path);
+
+/**
+ * \brief Stops tracking a file, for example after it is closed. The counters
+ * of its name are kept.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param file Pointer to the file.
+ */
+void lfs_wa_bd_untrack(const struct lfs_config *lfs_cfg, const lfs_file_t *file);
+
+/**
+ * \brief Starts a tagged call. The following programs and erases are
+ * attributed to the operation and to the file if it is tracked.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param op Operation.
+ * \param file Pointer to the file of the call; NULL if none.
+ * \returns 0 on success; the error of the lock of the backing device
+ *          otherwise. On error, the call is not tagged and
+ *          \ref lfs_wa_bd_end() must not be called.
+ */
+int lfs_wa_bd_begin(const struct lfs_config *lfs_cfg, lfs_wa_bd_op_t op, const lfs_file_t *file);
+
+/**
+ * \brief Ends a tagged call.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param logical_bytes Number of bytes written by the call.
+ */
+void lfs_wa_bd_end(const struct lfs_config *lfs_cfg, lfs_size_t logical_bytes);
+
+/**
+ * \brief Calls lfs_file_write() tagged with \ref LFS_WA_BD_OP_WRITE.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param lfs Pointer to the filesystem.
+ * \param file Pointer to the file.
+ * \param buffer Pointer to the data.
+ * \param size Number of bytes.
+ * \returns The result of lfs_file_write(), or the error of \ref lfs_wa_bd_begin().
+ */
+lfs_ssize_t lfs_wa_bd_file_write(const struct lfs_config *lfs_cfg, lfs_t *lfs, lfs_file_t *file,
+        const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Calls lfs_file_sync() tagged with \ref LFS_WA_BD_OP_SYNC.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param lfs Pointer to the filesystem.
+ * \param file Pointer to the file.
+ * \returns The result of lfs_file_sync(), or the error of \ref lfs_wa_bd_begin().
+ */
+int lfs_wa_bd_file_sync(const struct lfs_config *lfs_cfg, lfs_t *lfs, lfs_file_t *file);
+
+/**
+ * \brief Calls lfs_file_close() tagged with \ref LFS_WA_BD_OP_SYNC and stops
+ * tracking the file.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param lfs Pointer to the filesystem.
+ * \param file Pointer to the file.
+ * \returns The result of lfs_file_close(), or the error of \ref lfs_wa_bd_begin().
+ */
+int lfs_wa_bd_file_close(const struct lfs_config *lfs_cfg, lfs_t *lfs, lfs_file_t *file);
+
+/**
+ * \brief Returns the counters of an operation.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param op Operation.
+ * \param counters Pointer to the structure to store the counters.
+ */
+void lfs_wa_bd_get_op(const struct lfs_config *lfs_cfg, lfs_wa_bd_op_t op,
+        lfs_wa_bd_counters_t *counters);
+
+/**
+ * \brief Returns the sum of the counters of all operations.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param counters Pointer to the structure to store the counters.
+ */
+void lfs_wa_bd_get_total(const struct lfs_config *lfs_cfg, lfs_wa_bd_counters_t *counters);
+
+/**
+ * \brief Returns the counters of a file name.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param index Index of the file name, from 0.
+ * \param stats Pointer to the structure to store the name and counters.
+ * \returns true if a file name has this index; false otherwise.
+ */
+bool lfs_wa_bd_get_file(const struct lfs_config *lfs_cfg, uint32_t index,
+        lfs_wa_bd_file_stats_t *stats);
+
+/**
+ * \brief Resets all counters to zero and forgets the file names of the files
+ * that are not tracked.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ */
+void lfs_wa_bd_reset(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Returns the number of bytes programmed per byte written, times 100.
+ * \param counters Pointer to the counters.
+ * \returns The ratio times 100; 0 if no byte was written.
+ */
+uint32_t lfs_wa_bd_prog_ratio(const lfs_wa_bd_counters_t *counters);
+
+/**
+ * \brief Returns the number of bytes erased per byte written, times 100.
+ * \param counters Pointer to the counters.
+ * \returns The ratio times 100; 0 if no byte was written.
+ */
+uint32_t lfs_wa_bd_erase_ratio(const lfs_wa_bd_counters_t *counters);
+
+/**
+ * \brief Reads data from the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which read should begin.
+ * \param off Offset in the block from which read should begin.
+ * \param buffer Pointer to the buffer to store the data read from the memory.
+ * \param size Number of bytes to read.
+ * \returns The result of the backing device.
+ */
+int lfs_wa_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Programs data on the backing device and counts the bytes.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number from which write should begin.
+ * \param off Offset in the block from which write should begin.
+ * \param buffer Pointer to the buffer that contains the data to be written.
+ * \param size Number of bytes to write.
+ * \returns The result of the backing device.
+ */
+int lfs_wa_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size);
+
+/**
+ * \brief Erases a block of the backing device and counts it.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \param block Block number to be erased.
+ * \returns The result of the backing device.
+ */
+int lfs_wa_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block);
+
+/**
+ * \brief Syncs the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns The result of the backing device.
+ */
+int lfs_wa_bd_sync(const struct lfs_config *lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+/**
+ * \brief Locks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if locking was successful; -1 otherwise.
+ */
+int lfs_wa_bd_lock(const struct lfs_config *lfs_cfg);
+
+/**
+ * \brief Unlocks the backing device.
+ * \param lfs_cfg Pointer to the lfs_config structure.
+ * \returns 0 if unlocking was successful; -1 otherwise.
+ */
+int lfs_wa_bd_unlock(const struct lfs_config *lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_wa_bd */
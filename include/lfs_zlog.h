@@ -0,0 +1,246 @@
+/***************************************************************************//**
+ * \file lfs_zlog.h
+ *
+ * \brief
+ * Compressed append-only log files on top of littlefs
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/**
+ * \addtogroup group_lfs_zlog Compressed Log Files
+ * \{
+ * * Implements append-only log files that are compressed while they are
+ * written, so fewer bytes are programmed and erased.
+ * * The data is collected in chunks of \ref LFS_ZLOG_CHUNK_SIZE bytes. Each
+ * chunk is compressed on its own with an LZ4-class algorithm and written with
+ * a small header that holds its sizes and a CRC. A chunk that does not
+ * compress is stored as is.
+ * * A second file holds one index entry per chunk. Readers use it to jump to
+ * any position with \ref lfs_zlog_seek() and decompress only the chunk that
+ * contains it.
+ * * All RAM is provided by the application in one work buffer of
+ * \ref LFS_ZLOG_WORK_BUFFER_SIZE bytes; nothing is allocated.
+ * * \ref lfs_zlog_get_stats() returns the number of uncompressed bytes in the
+ * stored chunks and the number of bytes in the files.
+ *
+ * \code
+ * static uint32_t work[(LFS_ZLOG_WORK_BUFFER_SIZE + 3U) / 4U];
+ * lfs_zlog_t log;
+ *
+ * lfs_zlog_open(&lfs, &log, "sensor.log", "sensor.idx", LFS_ZLOG_APPEND, work);
+ * lfs_zlog_write(&log, &sample, sizeof(sample));
+ * lfs_zlog_close(&log);
+ * \endcode
+ *
+ * <b>Note:</b>
+ * * Data written since the last \ref lfs_zlog_flush() or \ref lfs_zlog_close()
+ * is lost on power loss. A flush stores the partly filled chunk as a short
+ * chunk, so frequent flushes reduce the compression ratio.
+ * * A chunk that was written to the data file but not to the index is removed
+ * when the log is opened again for appending.
+ */
+
+#ifndef LFS_ZLOG_H            /* Guard against multiple inclusion */
+#define LFS_ZLOG_H
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+
+/**
+ * \cond DO_NOT_DOCUMENT
+ * This block of code ignores violations of Directive 4.6 MISRA.
+ */
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',3,\
+'The third-party defines the function interface with basic numeral type')
+
+/**
+ *\endcond
+ */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/** Number of uncompressed bytes in a chunk. At most 32768. */
+#ifndef LFS_ZLOG_CHUNK_SIZE
+#define LFS_ZLOG_CHUNK_SIZE                     (2048UL)
+#endif /* #ifndef LFS_ZLOG_CHUNK_SIZE */
+
+/** Number of bits of the hash of the compressor. The hash table takes
+ * 2 * 2^LFS_ZLOG_HASH_BITS bytes.
+ */
+#ifndef LFS_ZLOG_HASH_BITS
+#define LFS_ZLOG_HASH_BITS                      (10UL)
+#endif /* #ifndef LFS_ZLOG_HASH_BITS */
+
+/** Size in bytes of the work buffer passed to \ref lfs_zlog_open(). */
+#define LFS_ZLOG_WORK_BUFFER_SIZE               \
+    ((sizeof(uint16_t) << LFS_ZLOG_HASH_BITS) + (2UL * LFS_ZLOG_CHUNK_SIZE))
+
+/** Mode of \ref lfs_zlog_open(). */
+typedef enum
+{
+    LFS_ZLOG_READ,                          /**< Reads an existing log */
+    LFS_ZLOG_APPEND                         /**< Appends to a log, creating it if needed */
+} lfs_zlog_mode_t;
+
+/** Compression statistics of a log. */
+typedef struct
+{
+    uint32_t raw_bytes;                     /**< Number of uncompressed bytes in the stored chunks */
+    uint32_t stored_bytes;                  /**< Number of bytes in the data and index files */
+    uint32_t chunks;                        /**< Number of chunks */
+} lfs_zlog_stats_t;
+
+/**
+ * Compressed log object. The content of this structure is for internal use
+ * only.
+ */
+typedef struct
+{
+    /** \cond INTERNAL */
+    lfs_t *lfs;
+    lfs_file_t data;
+    lfs_file_t index;
+    lfs_zlog_mode_t mode;
+    uint16_t *hash;
+    uint8_t *raw;
+    uint8_t *packed;
+    uint32_t raw_fill;
+    uint32_t raw_total;
+    uint32_t data_end;
+    uint32_t chunk_count;
+    uint32_t pos;
+    bool loaded;
+    uint32_t loaded_chunk;
+    uint32_t loaded_start;
+    uint32_t loaded_size;
+    bool trim_pending;
+    /** \endcond */
+} lfs_zlog_t;
+
+/**
+ * \brief Opens a compressed log.
+ * \param lfs Pointer to the mounted filesystem.
+ * \param log Pointer to the log object.
+ * \param data_path Path of the data file.
+ * \param index_path Path of the index file.
+ * \param mode \ref LFS_ZLOG_READ or \ref LFS_ZLOG_APPEND.
+ * \param work_buffer Pointer to a word-aligned buffer of
+ *        \ref LFS_ZLOG_WORK_BUFFER_SIZE bytes, used until the log is closed.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_zlog_open(lfs_t *lfs, lfs_zlog_t *log, const char *data_path, const char *index_path,
+        lfs_zlog_mode_t mode, void *work_buffer);
+
+/**
+ * \brief Appends data to a log opened with \ref LFS_ZLOG_APPEND. Each full
+ * chunk is compressed and written.
+ * \param log Pointer to the log object.
+ * \param data Pointer to the data.
+ * \param size Number of bytes.
+ * \returns The number of bytes written. When a chunk cannot be written after
+ *          earlier chunks of the same call were, the number of bytes written
+ *          up to that chunk, which is less than size. A littlefs error code if
+ *          no byte was written; the data is then not consumed.
+ */
+lfs_ssize_t lfs_zlog_write(lfs_zlog_t *log, const void *data, lfs_size_t size);
+
+/**
+ * \brief Writes the partly filled chunk and syncs both files. If a write
+ * fails, for example with LFS_ERR_NOSPC, the files are cut back to the last
+ * complete chunk and the chunk stays buffered for the next flush or write.
+ * \param log Pointer to the log object.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_zlog_flush(lfs_zlog_t *log);
+
+/**
+ * \brief Flushes a log opened with \ref LFS_ZLOG_APPEND and closes both files.
+ * \param log Pointer to the log object.
+ * \returns 0 if successful; a littlefs error code otherwise.
+ */
+int lfs_zlog_close(lfs_zlog_t *log);
+
+/**
+ * \brief Reads uncompressed data from the current position of a log opened
+ * with \ref LFS_ZLOG_READ.
+ * \param log Pointer to the log object.
+ * \param buffer Pointer to the buffer to store the data.
+ * \param size Number of bytes to read.
+ * \returns The number of bytes read, zero at the end of the log; a littlefs
+ *          error code otherwise. LFS_ERR_CORRUPT is returned if a chunk does
+ *          not match its CRC.
+ */
+lfs_ssize_t lfs_zlog_read(lfs_zlog_t *log, void *buffer, lfs_size_t size);
+
+/**
+ * \brief Sets the read position in the uncompressed data. A position past the
+ * end is set to the end.
+ * \param log Pointer to the log object.
+ * \param off Position in bytes from the start of the log.
+ * \returns The new position.
+ */
+lfs_soff_t lfs_zlog_seek(lfs_zlog_t *log, lfs_off_t off);
+
+/**
+ * \brief Returns the size of the uncompressed data, including the data not
+ * yet flushed.
+ * \param log Pointer to the log object.
+ * \returns The size in bytes.
+ */
+lfs_soff_t lfs_zlog_size(const lfs_zlog_t *log);
+
+/**
+ * \brief Returns the compression statistics of the whole log.
+ * \param log Pointer to the log object.
+ * \param stats Pointer to the structure to store the statistics.
+ */
+void lfs_zlog_get_stats(const lfs_zlog_t *log, lfs_zlog_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif                      /* Avoid multiple inclusion */
+
+/** \} group_lfs_zlog */
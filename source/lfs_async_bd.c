@@ -0,0 +1,686 @@
+/***************************************************************************//**
+ * \file lfs_async_bd.c
+ *
+ * \brief
+ * Implements an asynchronous block device that runs the operations of another
+ * block device in a dedicated worker thread.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_async_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_async_bd_unlock and lfs_async_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',5,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define RESULT_ERROR                                (-1)
+
+#define DONE_SEMA_MAX_COUNT                         (1UL)
+#define DONE_SEMA_INIT_COUNT                        (0UL)
+/* One extra count for the request of littlefs, which has a reserved slot, and
+ * one that wakes the worker thread up when it is stopped.
+ */
+#define PENDING_SEMA_MAX_COUNT                      (LFS_ASYNC_BD_MAX_PENDING + 2UL)
+#define PENDING_SEMA_INIT_COUNT                     (0UL)
+
+#define WORKER_THREAD_NAME                          "lfs_async_bd"
+#define SYNC_OBJECT_COUNT                           (3UL)
+
+static inline lfs_async_bd_t *_get_async(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_async_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_async_bd_t instance.');
+    return (lfs_async_bd_t *)(lfs_cfg->context);
+}
+
+static inline bool _is_write(const lfs_async_bd_request_t *request)
+{
+    return (LFS_ASYNC_BD_OP_PROG == request->op) || (LFS_ASYNC_BD_OP_ERASE == request->op);
+}
+
+/* Checks whether a later request may not be executed before an earlier one.
+ * Reads may pass each other. A program or erase may not pass, or be passed by,
+ * a request on the same block, and a sync may not pass, or be passed by, a
+ * program or erase.
+ */
+static bool _conflicts(const lfs_async_bd_request_t *earlier, const lfs_async_bd_request_t *later)
+{
+    bool conflict;
+
+    if(!_is_write(earlier) && !_is_write(later))
+    {
+        conflict = false;
+    }
+    else if((LFS_ASYNC_BD_OP_SYNC == earlier->op) || (LFS_ASYNC_BD_OP_SYNC == later->op))
+    {
+        conflict = true;
+    }
+    else
+    {
+        conflict = (earlier->block == later->block);
+    }
+
+    return conflict;
+}
+
+/* Checks whether a request conflicts with a request submitted before it. */
+static bool _is_blocked(const lfs_async_bd_request_t *head, const lfs_async_bd_request_t *candidate)
+{
+    bool blocked = false;
+
+    for(const lfs_async_bd_request_t *request = head; (request != candidate) && !blocked; request = request->next)
+    {
+        blocked = _conflicts(request, candidate);
+    }
+
+    return blocked;
+}
+
+/* Returns the first read if it does not conflict with an earlier request, or
+ * the head of the list otherwise.
+ */
+static lfs_async_bd_request_t *_select_read_first(lfs_async_bd_t *async, lfs_async_bd_request_t **prev)
+{
+    lfs_async_bd_request_t *request = async->head;
+    lfs_async_bd_request_t *read = async->head;
+    lfs_async_bd_request_t *read_prev = NULL;
+
+    while((NULL != read) && (LFS_ASYNC_BD_OP_READ != read->op))
+    {
+        read_prev = read;
+        read = read->next;
+    }
+
+    if((NULL != read) && !_is_blocked(async->head, read))
+    {
+        request = read;
+        *prev = read_prev;
+    }
+
+    return request;
+}
+
+/* Returns the request with the highest priority among the requests that do
+ * not conflict with an earlier one; the earliest wins a tie. A request that has
+ * been passed LFS_ASYNC_BD_AGING_LIMIT times is raised above all priorities,
+ * so low-priority requests are not starved. The requests that are passed
+ * count it.
+ */
+static lfs_async_bd_request_t *_select_priority(lfs_async_bd_t *async, lfs_async_bd_request_t **prev)
+{
+    lfs_async_bd_request_t *request = async->head;
+    lfs_async_bd_request_t *candidate_prev = NULL;
+    uint32_t best = 0U;
+
+    for(lfs_async_bd_request_t *candidate = async->head; NULL != candidate; candidate = candidate->next)
+    {
+        uint32_t priority = (candidate->passed >= LFS_ASYNC_BD_AGING_LIMIT) ?
+                            (uint32_t)LFS_ASYNC_BD_PRIORITIES : (uint32_t)candidate->priority;
+
+        if(((candidate == async->head) || (priority > best)) && !_is_blocked(async->head, candidate))
+        {
+            request = candidate;
+            *prev = candidate_prev;
+            best = priority;
+        }
+        candidate_prev = candidate;
+    }
+
+    if(request != async->head)
+    {
+        async->stats.reordered++;
+    }
+
+    for(lfs_async_bd_request_t *passed = async->head; passed != request; passed = passed->next)
+    {
+        passed->passed++;
+        if(LFS_ASYNC_BD_AGING_LIMIT == passed->passed)
+        {
+            async->stats.aged++;
+        }
+    }
+
+    return request;
+}
+
+/* Removes the next request to execute from the list. Returns NULL if the list
+ * is empty.
+ */
+static lfs_async_bd_request_t *_dequeue(lfs_async_bd_t *async)
+{
+    cy_rslt_t result = cy_rtos_get_mutex(&async->list_mutex, CY_RTOS_NEVER_TIMEOUT);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+
+    lfs_async_bd_request_t *request = async->head;
+    lfs_async_bd_request_t *prev = NULL;
+
+    if(NULL != request)
+    {
+        if(LFS_ASYNC_BD_ORDER_READS_FIRST == async->config.order)
+        {
+            request = _select_read_first(async, &prev);
+        }
+        else if(LFS_ASYNC_BD_ORDER_PRIORITY == async->config.order)
+        {
+            request = _select_priority(async, &prev);
+        }
+        else
+        {
+            /* LFS_ASYNC_BD_ORDER_STRICT: the head of the list. */
+        }
+    }
+
+    if(NULL != request)
+    {
+        if(NULL == prev)
+        {
+            async->head = request->next;
+        }
+        else
+        {
+            prev->next = request->next;
+        }
+
+        if(async->tail == request)
+        {
+            async->tail = prev;
+        }
+
+        request->next = NULL;
+        if(request != &async->lfs_request)
+        {
+            async->pending--;
+        }
+    }
+
+    result = cy_rtos_set_mutex(&async->list_mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+
+    return request;
+}
+
+static inline uint32_t _now(const lfs_async_bd_t *async)
+{
+    return (NULL != async->config.get_time) ? async->config.get_time() : 0U;
+}
+
+static void _record_latency(lfs_async_bd_t *async, const lfs_async_bd_request_t *request)
+{
+    cy_rslt_t result = cy_rtos_get_mutex(&async->list_mutex, CY_RTOS_NEVER_TIMEOUT);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+
+    lfs_async_bd_class_stats_t *stats = &async->stats.classes[request->priority];
+    uint32_t latency = _now(async) - request->submit_time;
+
+    stats->count++;
+    stats->total_latency += latency;
+    stats->max_latency = lfs_max(stats->max_latency, latency);
+
+    result = cy_rtos_set_mutex(&async->list_mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+static void _execute(lfs_async_bd_t *async, lfs_async_bd_request_t *request)
+{
+    const struct lfs_config *backing = async->config.backing;
+    int res;
+
+    switch(request->op)
+    {
+        case LFS_ASYNC_BD_OP_READ:
+            res = backing->read(backing, request->block, request->off, request->buffer, request->size);
+            break;
+        case LFS_ASYNC_BD_OP_PROG:
+            res = backing->prog(backing, request->block, request->off, request->data, request->size);
+            break;
+        case LFS_ASYNC_BD_OP_ERASE:
+            res = backing->erase(backing, request->block);
+            break;
+        case LFS_ASYNC_BD_OP_SYNC:
+            res = backing->sync(backing);
+            break;
+        default:
+            res = RESULT_ERROR;
+            break;
+    }
+
+    request->result = res;
+    _record_latency(async, request);
+
+    if(NULL != request->callback)
+    {
+        request->callback(request, request->arg);
+    }
+
+    cy_rslt_t result = cy_rtos_set_semaphore(&request->done_sema, false);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+
+    /* The last access to the request. Its owner may release it once
+     * lfs_async_bd_is_done() or lfs_async_bd_wait() sees this flag.
+     */
+    request->done = true;
+}
+
+static void _worker(cy_thread_arg_t arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The thread argument is cast to lfs_async_bd_t*. It is guaranteed that arg points to a valid lfs_async_bd_t instance.');
+    lfs_async_bd_t *async = (lfs_async_bd_t *)arg;
+    bool running = true;
+
+    while(running)
+    {
+        cy_rslt_t result = cy_rtos_get_semaphore(&async->pending_sema, CY_RTOS_NEVER_TIMEOUT, false);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+        CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+
+        lfs_async_bd_request_t *request = _dequeue(async);
+
+        if(NULL != request)
+        {
+            _execute(async, request);
+        }
+        else
+        {
+            /* The list is empty only when woken up by lfs_async_bd_destroy. */
+            running = !async->stop;
+        }
+    }
+
+    (void)cy_rtos_exit_thread();
+}
+
+/* Deletes the first created synchronization objects, in the reverse order of
+ * their creation in lfs_async_bd_create().
+ */
+static void _deinit_sync(lfs_async_bd_t *async, uint32_t created)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if(created > 2U)
+    {
+        result = cy_rtos_deinit_semaphore(&async->pending_sema);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    }
+    if(created > 1U)
+    {
+        result = cy_rtos_deinit_mutex(&async->list_mutex);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    }
+    if(created > 0U)
+    {
+        lfs_async_bd_request_deinit(&async->lfs_request);
+    }
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+/* Runs a littlefs operation through the worker thread. littlefs issues one
+ * operation at a time, so a single request object is enough. Its slot is
+ * reserved, so the operation is queued even if direct submitters filled the
+ * list.
+ */
+static int _run_lfs_request(const struct lfs_config *lfs_cfg, lfs_async_bd_op_t op, lfs_block_t block,
+        lfs_off_t off, void *buffer, const void *data, lfs_size_t size)
+{
+    lfs_async_bd_t *async = _get_async(lfs_cfg);
+    lfs_async_bd_request_t *request = &async->lfs_request;
+
+    /* Reads stall the caller of littlefs, while erases can usually wait. */
+    if(LFS_ASYNC_BD_OP_READ == op)
+    {
+        request->priority = LFS_ASYNC_BD_PRIORITY_HIGH;
+    }
+    else if(LFS_ASYNC_BD_OP_ERASE == op)
+    {
+        request->priority = LFS_ASYNC_BD_PRIORITY_LOW;
+    }
+    else
+    {
+        request->priority = LFS_ASYNC_BD_PRIORITY_NORMAL;
+    }
+
+    request->op = op;
+    request->block = block;
+    request->off = off;
+    request->buffer = buffer;
+    request->data = data;
+    request->size = size;
+
+    cy_rslt_t result = lfs_async_bd_submit(lfs_cfg, request);
+    if(CY_RSLT_SUCCESS == result)
+    {
+        result = lfs_async_bd_wait(request, CY_RTOS_NEVER_TIMEOUT);
+    }
+
+    return (CY_RSLT_SUCCESS == result) ? request->result : RESULT_ERROR;
+}
+
+cy_rslt_t lfs_async_bd_create(struct lfs_config *lfs_cfg, lfs_async_bd_t *async,
+        const lfs_async_bd_config_t *config)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_ASYNC_BD_TRACE("lfs_async_bd_create(%p, %p, %p)", (void*)lfs_cfg, (void*)async, (void*)config);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != async);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->backing);
+
+    (void)memset(async, 0, sizeof(*async));
+    async->config = *config;
+
+    lfs_cfg->context     = async;
+
+    /* Block device operations */
+    lfs_cfg->read        = lfs_async_bd_read;
+    lfs_cfg->prog        = lfs_async_bd_prog;
+    lfs_cfg->erase       = lfs_async_bd_erase;
+    lfs_cfg->sync        = lfs_async_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+    lfs_cfg->lock        = lfs_async_bd_lock;
+    lfs_cfg->unlock      = lfs_async_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /* The geometry and the littlefs tuning of the backing device are kept. */
+    lfs_cfg->read_size      = config->backing->read_size;
+    lfs_cfg->prog_size      = config->backing->prog_size;
+    lfs_cfg->block_size     = config->backing->block_size;
+    lfs_cfg->block_count    = config->backing->block_count;
+    lfs_cfg->block_cycles   = config->backing->block_cycles;
+    lfs_cfg->cache_size     = config->backing->cache_size;
+    lfs_cfg->lookahead_size = config->backing->lookahead_size;
+
+    uint32_t created = 0U;
+    cy_rslt_t result = lfs_async_bd_request_init(&async->lfs_request);
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        result = cy_rtos_init_mutex(&async->list_mutex);
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        result = cy_rtos_init_semaphore(&async->pending_sema, PENDING_SEMA_MAX_COUNT, PENDING_SEMA_INIT_COUNT);
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        result = cy_rtos_create_thread(&async->thread, _worker, WORKER_THREAD_NAME, config->stack,
+                                       config->stack_size, config->priority, (cy_thread_arg_t)async);
+    }
+
+    if(CY_RSLT_SUCCESS != result)
+    {
+        _deinit_sync(async, created);
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_ASYNC_BD_TRACE("lfs_async_bd_create -> %"PRIu32"", result);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    return result;
+}
+
+void lfs_async_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_async_bd_t *async = _get_async(lfs_cfg);
+
+    /* The worker thread completes the pending requests before it finds the
+     * list empty and stops.
+     */
+    async->stop = true;
+    cy_rslt_t result = cy_rtos_set_semaphore(&async->pending_sema, false);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+
+    result = cy_rtos_join_thread(&async->thread);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+
+    _deinit_sync(async, SYNC_OBJECT_COUNT);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+cy_rslt_t lfs_async_bd_request_init(lfs_async_bd_request_t *request)
+{
+    LFS_ASSERT(NULL != request);
+
+    (void)memset(request, 0, sizeof(*request));
+    request->priority = LFS_ASYNC_BD_PRIORITY_NORMAL;
+
+    return cy_rtos_init_semaphore(&request->done_sema, DONE_SEMA_MAX_COUNT, DONE_SEMA_INIT_COUNT);
+}
+
+void lfs_async_bd_request_deinit(lfs_async_bd_request_t *request)
+{
+    LFS_ASSERT(NULL != request);
+
+    cy_rslt_t result = cy_rtos_deinit_semaphore(&request->done_sema);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+cy_rslt_t lfs_async_bd_submit(const struct lfs_config *lfs_cfg, lfs_async_bd_request_t *request)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != request);
+
+    lfs_async_bd_t *async = _get_async(lfs_cfg);
+
+    LFS_ASSERT(!async->stop);
+    LFS_ASSERT((uint32_t)request->priority < LFS_ASYNC_BD_PRIORITIES);
+
+    /* Drop a completion of a previous submission that nobody waited for. */
+    (void)cy_rtos_get_semaphore(&request->done_sema, 0U, false);
+    request->done = false;
+    request->next = NULL;
+    request->passed = 0U;
+    request->submit_time = _now(async);
+
+    cy_rslt_t result = cy_rtos_get_mutex(&async->list_mutex, CY_RTOS_NEVER_TIMEOUT);
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        /* The request of littlefs is not counted, so it always finds a slot. */
+        bool reserved = (request == &async->lfs_request);
+
+        if(!reserved && (async->pending >= LFS_ASYNC_BD_MAX_PENDING))
+        {
+            result = LFS_ASYNC_BD_RSLT_ERR_QUEUE_FULL;
+        }
+        else
+        {
+            if(NULL == async->tail)
+            {
+                async->head = request;
+            }
+            else
+            {
+                async->tail->next = request;
+            }
+            async->tail = request;
+            if(!reserved)
+            {
+                async->pending++;
+            }
+        }
+
+        cy_rslt_t unlock_result = cy_rtos_set_mutex(&async->list_mutex);
+        LFS_ASSERT(CY_RSLT_SUCCESS == unlock_result);
+        CY_UNUSED_PARAMETER(unlock_result); /* To avoid compiler warning in Release mode. */
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        result = cy_rtos_set_semaphore(&async->pending_sema, false);
+    }
+
+    return result;
+}
+
+cy_rslt_t lfs_async_bd_wait(lfs_async_bd_request_t *request, cy_time_t timeout_ms)
+{
+    LFS_ASSERT(NULL != request);
+
+    cy_rslt_t result = cy_rtos_get_semaphore(&request->done_sema, timeout_ms, false);
+
+    /* The worker thread gives the semaphore before it sets the done flag, so
+     * wait for the flag before the request is handed back to its owner.
+     */
+    while((CY_RSLT_SUCCESS == result) && (!request->done))
+    {
+        result = cy_rtos_delay_milliseconds(1U);
+    }
+
+    return result;
+}
+
+bool lfs_async_bd_is_done(const lfs_async_bd_request_t *request)
+{
+    LFS_ASSERT(NULL != request);
+
+    return request->done;
+}
+
+void lfs_async_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_async_bd_stats_t *stats)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+
+    lfs_async_bd_t *async = _get_async(lfs_cfg);
+
+    cy_rslt_t result = cy_rtos_get_mutex(&async->list_mutex, CY_RTOS_NEVER_TIMEOUT);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+
+    *stats = async->stats;
+
+    result = cy_rtos_set_mutex(&async->list_mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+void lfs_async_bd_reset_stats(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_async_bd_t *async = _get_async(lfs_cfg);
+
+    cy_rslt_t result = cy_rtos_get_mutex(&async->list_mutex, CY_RTOS_NEVER_TIMEOUT);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+
+    (void)memset(&async->stats, 0, sizeof(async->stats));
+
+    result = cy_rtos_set_mutex(&async->list_mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+int lfs_async_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return _run_lfs_request(lfs_cfg, LFS_ASYNC_BD_OP_READ, block, off, buffer, NULL, size);
+}
+
+int lfs_async_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return _run_lfs_request(lfs_cfg, LFS_ASYNC_BD_OP_PROG, block, off, NULL, buffer, size);
+}
+
+int lfs_async_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return _run_lfs_request(lfs_cfg, LFS_ASYNC_BD_OP_ERASE, block, 0U, NULL, NULL, 0U);
+}
+
+int lfs_async_bd_sync(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return _run_lfs_request(lfs_cfg, LFS_ASYNC_BD_OP_SYNC, 0U, 0U, NULL, NULL, 0U);
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_async_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_async(lfs_cfg)->config.backing;
+    return backing->lock(backing);
+}
+
+int lfs_async_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_async(lfs_cfg)->config.backing;
+    return backing->unlock(backing);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
@@ -0,0 +1,140 @@
+/***************************************************************************//**
+ * \file lfs_bd_geometry.c
+ *
+ * \brief
+ * Geometry of the lfs_config structure derived by the block device drivers
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_bd_geometry.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define QSPI_MIN_READ_SIZE                          (1UL)
+
+/* Recommended value as per the comment in lfs.c is in the range of 100-1000. */
+#define LFS_CFG_DEFAULT_BLOCK_CYCLES                (512)
+#define LFS_CFG_LOOKAHEAD_SIZE_MIN                  (64UL) /* Must be a multiple of 8. */
+
+/* A larger Lookahead size reduces the number of scans performed by the block
+ * allocation algorithm thus increasing the filesystem performance, but results
+ * in higher RAM consumption.
+ *
+ * Must be a multiple of 8.
+ */
+static inline lfs_size_t _lookahead_size(lfs_size_t block_count)
+{
+    return lfs_min((lfs_size_t) LFS_CFG_LOOKAHEAD_SIZE_MIN, 8UL * ((block_count + 63UL)/64UL) );
+}
+
+void lfs_spi_flash_bd_set_geometry(struct lfs_config *lfs_cfg, lfs_size_t prog_size,
+        lfs_size_t block_size, lfs_size_t block_count)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT((0U != prog_size) && (0U == (block_size % prog_size)));
+
+    lfs_cfg->read_size   = QSPI_MIN_READ_SIZE;
+    lfs_cfg->prog_size   = prog_size;
+    lfs_cfg->block_size  = block_size;
+    lfs_cfg->block_count = block_count;
+
+    /* Refer to lfs.h for the description of the following parameters: */
+
+    /* The number of erase cycles before data is moved to a new block.
+     * A larger value results in more efficient filesystem performance, but
+     * causes less even-wear distribution.
+     *
+     * Setting this to -1 disables dynamic wear leveling.
+     */
+    lfs_cfg->block_cycles = LFS_CFG_DEFAULT_BLOCK_CYCLES;
+
+    /* cache_size must be a multiple of prog & read sizes.
+     * i.e., cache_size % prog_size = 0 and cache_size % read_size = 0
+     * block_size must be a multiple of cache_size. i.e., block_size % cache_size = 0.
+     *
+     * littlefs allocates 1 cache for each file and 2 caches for
+     * internal operations.
+     * The higher the cache size, the better the performance is, but the
+     * RAM consumption is also higher.
+     *
+     * A cache of several pages lets littlefs flush them with one program
+     * call, which serial-flash streams page after page.
+     */
+    uint32_t cache_pages = LFS_SPI_FLASH_BD_CACHE_PAGES;
+    while((cache_pages > 1UL) && (0U != (block_size % (prog_size * cache_pages))))
+    {
+        cache_pages--;
+    }
+    lfs_cfg->cache_size = prog_size * cache_pages;
+
+    lfs_cfg->lookahead_size = _lookahead_size(block_count);
+}
+
+void lfs_sd_bd_set_geometry(struct lfs_config *lfs_cfg, lfs_size_t block_count)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_cfg->read_size   = LFS_SD_BD_BLOCK_SIZE;
+    lfs_cfg->prog_size   = LFS_SD_BD_BLOCK_SIZE;
+    lfs_cfg->block_size  = LFS_SD_BD_BLOCK_SIZE;
+    lfs_cfg->block_count = block_count;
+
+    /* Refer to lfs.h for the description of the following parameters. */
+
+    /* Set to -1 to disable wear leveling as the controller in the
+     * SD card may be handling wear leveling.
+     */
+    lfs_cfg->block_cycles = -1;
+
+    /* cache_size must be a multiple of prog & read sizes.
+     * i.e., cache_size % prog_size = 0 and cache_size % read_size = 0
+     * block_size must be a multiple of cache_size. i.e., block_size % cache_size = 0.
+     *
+     * littlefs allocates 1 cache for each file and 2 caches for
+     * internal operations.
+     * The higher the cache size, the better the performance is, but the
+     * RAM consumption is also higher.
+     */
+    lfs_cfg->cache_size = LFS_SD_BD_BLOCK_SIZE;
+
+    lfs_cfg->lookahead_size = _lookahead_size(block_count);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
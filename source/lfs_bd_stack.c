@@ -0,0 +1,305 @@
+/***************************************************************************//**
+ * \file lfs_bd_stack.c
+ *
+ * \brief
+ * Implements a convention to stack block device layers at run time and an
+ * adapter that turns a stack into an lfs_config structure.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_bd_stack.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_bd_stack_unlock and lfs_bd_stack_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',18,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',12,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+static inline const struct lfs_config *_get_config(const lfs_bd_layer_t *layer)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer layer->context is cast to const struct lfs_config*. It is guaranteed that the context of a base layer points to a valid lfs_config instance.');
+    return (const struct lfs_config *)(layer->context);
+}
+
+static inline const lfs_bd_layer_t *_get_top(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to const lfs_bd_layer_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_bd_layer_t instance.');
+    return (const lfs_bd_layer_t *)(lfs_cfg->context);
+}
+
+/* Operations of a base layer: the functions of its lfs_config structure. */
+
+static int _config_read(const lfs_bd_layer_t *layer, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    const struct lfs_config *lfs_cfg = _get_config(layer);
+    return lfs_cfg->read(lfs_cfg, block, off, buffer, size);
+}
+
+static int _config_prog(const lfs_bd_layer_t *layer, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    const struct lfs_config *lfs_cfg = _get_config(layer);
+    return lfs_cfg->prog(lfs_cfg, block, off, buffer, size);
+}
+
+static int _config_erase(const lfs_bd_layer_t *layer, lfs_block_t block)
+{
+    const struct lfs_config *lfs_cfg = _get_config(layer);
+    return lfs_cfg->erase(lfs_cfg, block);
+}
+
+static int _config_sync(const lfs_bd_layer_t *layer)
+{
+    const struct lfs_config *lfs_cfg = _get_config(layer);
+    return lfs_cfg->sync(lfs_cfg);
+}
+
+#if defined(LFS_THREADSAFE)
+static int _config_lock(const lfs_bd_layer_t *layer)
+{
+    const struct lfs_config *lfs_cfg = _get_config(layer);
+    return lfs_cfg->lock(lfs_cfg);
+}
+
+static int _config_unlock(const lfs_bd_layer_t *layer)
+{
+    const struct lfs_config *lfs_cfg = _get_config(layer);
+    return lfs_cfg->unlock(lfs_cfg);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+static const lfs_bd_ops_t _config_ops =
+{
+    .read   = _config_read,
+    .prog   = _config_prog,
+    .erase  = _config_erase,
+    .sync   = _config_sync,
+#if defined(LFS_THREADSAFE)
+    .lock   = _config_lock,
+    .unlock = _config_unlock,
+#endif /* #if defined(LFS_THREADSAFE) */
+};
+
+/* Moves layer down to the first layer that implements the operation op. The
+ * base layer implements all operations.
+ */
+#define FIND_LAYER(layer, op)                                   \
+    do                                                          \
+    {                                                           \
+        while(NULL == (layer)->ops->op)                         \
+        {                                                       \
+            (layer) = (layer)->lower;                           \
+            LFS_ASSERT(NULL != (layer));                        \
+        }                                                       \
+    } while(false)
+
+void lfs_bd_stack_base(lfs_bd_layer_t *layer, const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != layer);
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    layer->ops = &_config_ops;
+    CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.8', 'The const qualifier of lfs_cfg is removed to store it as the context. The operations of a base layer do not modify it.');
+    layer->context = (void *)lfs_cfg;
+    layer->lower = NULL;
+
+    layer->read_size      = lfs_cfg->read_size;
+    layer->prog_size      = lfs_cfg->prog_size;
+    layer->block_size     = lfs_cfg->block_size;
+    layer->block_count    = lfs_cfg->block_count;
+    layer->block_cycles   = lfs_cfg->block_cycles;
+    layer->cache_size     = lfs_cfg->cache_size;
+    layer->lookahead_size = lfs_cfg->lookahead_size;
+}
+
+void lfs_bd_stack_push(lfs_bd_layer_t *layer, const lfs_bd_ops_t *ops, void *context,
+        const lfs_bd_layer_t *lower)
+{
+    LFS_ASSERT(NULL != layer);
+    LFS_ASSERT(NULL != ops);
+    LFS_ASSERT(NULL != lower);
+
+    *layer = *lower;
+    layer->ops = ops;
+    layer->context = context;
+    layer->lower = lower;
+}
+
+int lfs_bd_stack_layer_read(const lfs_bd_layer_t *layer, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != layer);
+
+    FIND_LAYER(layer, read);
+    return layer->ops->read(layer, block, off, buffer, size);
+}
+
+int lfs_bd_stack_layer_prog(const lfs_bd_layer_t *layer, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != layer);
+
+    FIND_LAYER(layer, prog);
+    return layer->ops->prog(layer, block, off, buffer, size);
+}
+
+int lfs_bd_stack_layer_erase(const lfs_bd_layer_t *layer, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != layer);
+
+    FIND_LAYER(layer, erase);
+    return layer->ops->erase(layer, block);
+}
+
+int lfs_bd_stack_layer_sync(const lfs_bd_layer_t *layer)
+{
+    LFS_ASSERT(NULL != layer);
+
+    FIND_LAYER(layer, sync);
+    return layer->ops->sync(layer);
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_bd_stack_layer_lock(const lfs_bd_layer_t *layer)
+{
+    LFS_ASSERT(NULL != layer);
+
+    FIND_LAYER(layer, lock);
+    return layer->ops->lock(layer);
+}
+
+int lfs_bd_stack_layer_unlock(const lfs_bd_layer_t *layer)
+{
+    LFS_ASSERT(NULL != layer);
+
+    FIND_LAYER(layer, unlock);
+    return layer->ops->unlock(layer);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+cy_rslt_t lfs_bd_stack_create(struct lfs_config *lfs_cfg, const lfs_bd_layer_t *top)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != top);
+
+    CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.8', 'The const qualifier of top is removed to store it as the context. The stack does not modify its layers.');
+    lfs_cfg->context     = (void *)top;
+
+    /* Block device operations */
+    lfs_cfg->read        = lfs_bd_stack_read;
+    lfs_cfg->prog        = lfs_bd_stack_prog;
+    lfs_cfg->erase       = lfs_bd_stack_erase;
+    lfs_cfg->sync        = lfs_bd_stack_sync;
+
+#if defined(LFS_THREADSAFE)
+    lfs_cfg->lock        = lfs_bd_stack_lock;
+    lfs_cfg->unlock      = lfs_bd_stack_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /* Block device configuration */
+    lfs_cfg->read_size      = top->read_size;
+    lfs_cfg->prog_size      = top->prog_size;
+    lfs_cfg->block_size     = top->block_size;
+    lfs_cfg->block_count    = top->block_count;
+    lfs_cfg->block_cycles   = top->block_cycles;
+    lfs_cfg->cache_size     = top->cache_size;
+    lfs_cfg->lookahead_size = top->lookahead_size;
+
+    return CY_RSLT_SUCCESS;
+}
+
+int lfs_bd_stack_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    return lfs_bd_stack_layer_read(_get_top(lfs_cfg), block, off, buffer, size);
+}
+
+int lfs_bd_stack_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    return lfs_bd_stack_layer_prog(_get_top(lfs_cfg), block, off, buffer, size);
+}
+
+int lfs_bd_stack_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    return lfs_bd_stack_layer_erase(_get_top(lfs_cfg), block);
+}
+
+int lfs_bd_stack_sync(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return lfs_bd_stack_layer_sync(_get_top(lfs_cfg));
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_bd_stack_lock(const struct lfs_config *lfs_cfg)
+{
+    return lfs_bd_stack_layer_lock(_get_top(lfs_cfg));
+}
+
+int lfs_bd_stack_unlock(const struct lfs_config *lfs_cfg)
+{
+    return lfs_bd_stack_layer_unlock(_get_top(lfs_cfg));
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
@@ -0,0 +1,506 @@
+/***************************************************************************//**
+ * \file lfs_crypt_bd.c
+ *
+ * \brief
+ * Encryption block device
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_crypt_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_crypt_bd_unlock and lfs_crypt_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',5,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/* Data unit number: index of the data unit on the device (8, little-endian),
+ * nonce of the volume (8).
+ */
+#define DATA_UNIT_INDEX_SIZE                        (8U)
+
+/* Reduction polynomial of GF(2^128) used to advance the XTS tweak */
+#define XTS_POLYNOMIAL                              (0x87U)
+
+#if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES)
+#define AES_KEY_SIZE                                (16U)
+#define AES_ROUNDS                                  (10U)
+#define AES_COLUMNS                                 (4U)
+
+static const uint8_t _sbox[256] =
+{
+    0x63U, 0x7cU, 0x77U, 0x7bU, 0xf2U, 0x6bU, 0x6fU, 0xc5U, 0x30U, 0x01U, 0x67U, 0x2bU, 0xfeU, 0xd7U, 0xabU, 0x76U,
+    0xcaU, 0x82U, 0xc9U, 0x7dU, 0xfaU, 0x59U, 0x47U, 0xf0U, 0xadU, 0xd4U, 0xa2U, 0xafU, 0x9cU, 0xa4U, 0x72U, 0xc0U,
+    0xb7U, 0xfdU, 0x93U, 0x26U, 0x36U, 0x3fU, 0xf7U, 0xccU, 0x34U, 0xa5U, 0xe5U, 0xf1U, 0x71U, 0xd8U, 0x31U, 0x15U,
+    0x04U, 0xc7U, 0x23U, 0xc3U, 0x18U, 0x96U, 0x05U, 0x9aU, 0x07U, 0x12U, 0x80U, 0xe2U, 0xebU, 0x27U, 0xb2U, 0x75U,
+    0x09U, 0x83U, 0x2cU, 0x1aU, 0x1bU, 0x6eU, 0x5aU, 0xa0U, 0x52U, 0x3bU, 0xd6U, 0xb3U, 0x29U, 0xe3U, 0x2fU, 0x84U,
+    0x53U, 0xd1U, 0x00U, 0xedU, 0x20U, 0xfcU, 0xb1U, 0x5bU, 0x6aU, 0xcbU, 0xbeU, 0x39U, 0x4aU, 0x4cU, 0x58U, 0xcfU,
+    0xd0U, 0xefU, 0xaaU, 0xfbU, 0x43U, 0x4dU, 0x33U, 0x85U, 0x45U, 0xf9U, 0x02U, 0x7fU, 0x50U, 0x3cU, 0x9fU, 0xa8U,
+    0x51U, 0xa3U, 0x40U, 0x8fU, 0x92U, 0x9dU, 0x38U, 0xf5U, 0xbcU, 0xb6U, 0xdaU, 0x21U, 0x10U, 0xffU, 0xf3U, 0xd2U,
+    0xcdU, 0x0cU, 0x13U, 0xecU, 0x5fU, 0x97U, 0x44U, 0x17U, 0xc4U, 0xa7U, 0x7eU, 0x3dU, 0x64U, 0x5dU, 0x19U, 0x73U,
+    0x60U, 0x81U, 0x4fU, 0xdcU, 0x22U, 0x2aU, 0x90U, 0x88U, 0x46U, 0xeeU, 0xb8U, 0x14U, 0xdeU, 0x5eU, 0x0bU, 0xdbU,
+    0xe0U, 0x32U, 0x3aU, 0x0aU, 0x49U, 0x06U, 0x24U, 0x5cU, 0xc2U, 0xd3U, 0xacU, 0x62U, 0x91U, 0x95U, 0xe4U, 0x79U,
+    0xe7U, 0xc8U, 0x37U, 0x6dU, 0x8dU, 0xd5U, 0x4eU, 0xa9U, 0x6cU, 0x56U, 0xf4U, 0xeaU, 0x65U, 0x7aU, 0xaeU, 0x08U,
+    0xbaU, 0x78U, 0x25U, 0x2eU, 0x1cU, 0xa6U, 0xb4U, 0xc6U, 0xe8U, 0xddU, 0x74U, 0x1fU, 0x4bU, 0xbdU, 0x8bU, 0x8aU,
+    0x70U, 0x3eU, 0xb5U, 0x66U, 0x48U, 0x03U, 0xf6U, 0x0eU, 0x61U, 0x35U, 0x57U, 0xb9U, 0x86U, 0xc1U, 0x1dU, 0x9eU,
+    0xe1U, 0xf8U, 0x98U, 0x11U, 0x69U, 0xd9U, 0x8eU, 0x94U, 0x9bU, 0x1eU, 0x87U, 0xe9U, 0xceU, 0x55U, 0x28U, 0xdfU,
+    0x8cU, 0xa1U, 0x89U, 0x0dU, 0xbfU, 0xe6U, 0x42U, 0x68U, 0x41U, 0x99U, 0x2dU, 0x0fU, 0xb0U, 0x54U, 0xbbU, 0x16U
+};
+
+static const uint8_t _inv_sbox[256] =
+{
+    0x52U, 0x09U, 0x6aU, 0xd5U, 0x30U, 0x36U, 0xa5U, 0x38U, 0xbfU, 0x40U, 0xa3U, 0x9eU, 0x81U, 0xf3U, 0xd7U, 0xfbU,
+    0x7cU, 0xe3U, 0x39U, 0x82U, 0x9bU, 0x2fU, 0xffU, 0x87U, 0x34U, 0x8eU, 0x43U, 0x44U, 0xc4U, 0xdeU, 0xe9U, 0xcbU,
+    0x54U, 0x7bU, 0x94U, 0x32U, 0xa6U, 0xc2U, 0x23U, 0x3dU, 0xeeU, 0x4cU, 0x95U, 0x0bU, 0x42U, 0xfaU, 0xc3U, 0x4eU,
+    0x08U, 0x2eU, 0xa1U, 0x66U, 0x28U, 0xd9U, 0x24U, 0xb2U, 0x76U, 0x5bU, 0xa2U, 0x49U, 0x6dU, 0x8bU, 0xd1U, 0x25U,
+    0x72U, 0xf8U, 0xf6U, 0x64U, 0x86U, 0x68U, 0x98U, 0x16U, 0xd4U, 0xa4U, 0x5cU, 0xccU, 0x5dU, 0x65U, 0xb6U, 0x92U,
+    0x6cU, 0x70U, 0x48U, 0x50U, 0xfdU, 0xedU, 0xb9U, 0xdaU, 0x5eU, 0x15U, 0x46U, 0x57U, 0xa7U, 0x8dU, 0x9dU, 0x84U,
+    0x90U, 0xd8U, 0xabU, 0x00U, 0x8cU, 0xbcU, 0xd3U, 0x0aU, 0xf7U, 0xe4U, 0x58U, 0x05U, 0xb8U, 0xb3U, 0x45U, 0x06U,
+    0xd0U, 0x2cU, 0x1eU, 0x8fU, 0xcaU, 0x3fU, 0x0fU, 0x02U, 0xc1U, 0xafU, 0xbdU, 0x03U, 0x01U, 0x13U, 0x8aU, 0x6bU,
+    0x3aU, 0x91U, 0x11U, 0x41U, 0x4fU, 0x67U, 0xdcU, 0xeaU, 0x97U, 0xf2U, 0xcfU, 0xceU, 0xf0U, 0xb4U, 0xe6U, 0x73U,
+    0x96U, 0xacU, 0x74U, 0x22U, 0xe7U, 0xadU, 0x35U, 0x85U, 0xe2U, 0xf9U, 0x37U, 0xe8U, 0x1cU, 0x75U, 0xdfU, 0x6eU,
+    0x47U, 0xf1U, 0x1aU, 0x71U, 0x1dU, 0x29U, 0xc5U, 0x89U, 0x6fU, 0xb7U, 0x62U, 0x0eU, 0xaaU, 0x18U, 0xbeU, 0x1bU,
+    0xfcU, 0x56U, 0x3eU, 0x4bU, 0xc6U, 0xd2U, 0x79U, 0x20U, 0x9aU, 0xdbU, 0xc0U, 0xfeU, 0x78U, 0xcdU, 0x5aU, 0xf4U,
+    0x1fU, 0xddU, 0xa8U, 0x33U, 0x88U, 0x07U, 0xc7U, 0x31U, 0xb1U, 0x12U, 0x10U, 0x59U, 0x27U, 0x80U, 0xecU, 0x5fU,
+    0x60U, 0x51U, 0x7fU, 0xa9U, 0x19U, 0xb5U, 0x4aU, 0x0dU, 0x2dU, 0xe5U, 0x7aU, 0x9fU, 0x93U, 0xc9U, 0x9cU, 0xefU,
+    0xa0U, 0xe0U, 0x3bU, 0x4dU, 0xaeU, 0x2aU, 0xf5U, 0xb0U, 0xc8U, 0xebU, 0xbbU, 0x3cU, 0x83U, 0x53U, 0x99U, 0x61U,
+    0x17U, 0x2bU, 0x04U, 0x7eU, 0xbaU, 0x77U, 0xd6U, 0x26U, 0xe1U, 0x69U, 0x14U, 0x63U, 0x55U, 0x21U, 0x0cU, 0x7dU
+};
+#endif /* #if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES) */
+
+static inline lfs_crypt_bd_t *_get_crypt(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_crypt_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_crypt_bd_t instance.');
+    return (lfs_crypt_bd_t *)(lfs_cfg->context);
+}
+
+#if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES)
+static inline uint8_t _xtime(uint8_t x)
+{
+    return (uint8_t)(((uint32_t)x << 1U) ^ (((x & 0x80U) != 0U) ? 0x1bU : 0x00U));
+}
+
+static void _mix_column(uint8_t col[4])
+{
+    uint8_t all = col[0] ^ col[1] ^ col[2] ^ col[3];
+    uint8_t first = col[0];
+
+    col[0] ^= all ^ _xtime(col[0] ^ col[1]);
+    col[1] ^= all ^ _xtime(col[1] ^ col[2]);
+    col[2] ^= all ^ _xtime(col[2] ^ col[3]);
+    col[3] ^= all ^ _xtime(col[3] ^ first);
+}
+
+/* Multiplies the tweak by x in GF(2^128), little-endian as in IEEE 1619. */
+static void _next_tweak(uint8_t tweak[LFS_CRYPT_BD_AES_BLOCK_SIZE])
+{
+    uint8_t carry = 0U;
+
+    for(uint32_t i = 0U; i < LFS_CRYPT_BD_AES_BLOCK_SIZE; i++)
+    {
+        uint8_t next = (uint8_t)(tweak[i] >> 7U);
+
+        tweak[i] = (uint8_t)((uint32_t)tweak[i] << 1U) | carry;
+        carry = next;
+    }
+
+    if(0U != carry)
+    {
+        tweak[0] ^= XTS_POLYNOMIAL;
+    }
+}
+
+static void _expand_key(uint8_t *round_keys, const uint8_t *key)
+{
+    uint8_t rcon = 0x01U;
+
+    (void)memcpy(round_keys, key, AES_KEY_SIZE);
+
+    for(uint32_t i = AES_KEY_SIZE; i < ((AES_ROUNDS + 1U) * LFS_CRYPT_BD_AES_BLOCK_SIZE); i += 4U)
+    {
+        uint8_t word[4];
+
+        (void)memcpy(word, &round_keys[i - 4U], sizeof(word));
+        if(0U == (i % AES_KEY_SIZE))
+        {
+            uint8_t first = word[0];
+
+            word[0] = _sbox[word[1]] ^ rcon;
+            word[1] = _sbox[word[2]];
+            word[2] = _sbox[word[3]];
+            word[3] = _sbox[first];
+            rcon = _xtime(rcon);
+        }
+
+        for(uint32_t j = 0U; j < 4U; j++)
+        {
+            round_keys[i + j] = round_keys[(i + j) - AES_KEY_SIZE] ^ word[j];
+        }
+    }
+}
+
+/* Encrypts one AES block in place. The state is stored column by column. */
+static void _encrypt_block(const uint8_t *round_keys, uint8_t state[LFS_CRYPT_BD_AES_BLOCK_SIZE])
+{
+    uint8_t tmp[LFS_CRYPT_BD_AES_BLOCK_SIZE];
+
+    for(uint32_t i = 0U; i < LFS_CRYPT_BD_AES_BLOCK_SIZE; i++)
+    {
+        state[i] ^= round_keys[i];
+    }
+
+    for(uint32_t round = 1U; round <= AES_ROUNDS; round++)
+    {
+        /* SubBytes and ShiftRows: row r of column c comes from column c + r */
+        for(uint32_t c = 0U; c < AES_COLUMNS; c++)
+        {
+            for(uint32_t r = 0U; r < 4U; r++)
+            {
+                tmp[(c * 4U) + r] = _sbox[state[(((c + r) % AES_COLUMNS) * 4U) + r]];
+            }
+        }
+
+        /* MixColumns, skipped in the last round */
+        if(round < AES_ROUNDS)
+        {
+            for(uint32_t c = 0U; c < AES_COLUMNS; c++)
+            {
+                _mix_column(&tmp[c * 4U]);
+            }
+        }
+
+        for(uint32_t i = 0U; i < LFS_CRYPT_BD_AES_BLOCK_SIZE; i++)
+        {
+            state[i] = tmp[i] ^ round_keys[(round * LFS_CRYPT_BD_AES_BLOCK_SIZE) + i];
+        }
+    }
+}
+
+/* Decrypts one AES block in place with the round keys of the encryption. */
+static void _decrypt_block(const uint8_t *round_keys, uint8_t state[LFS_CRYPT_BD_AES_BLOCK_SIZE])
+{
+    uint8_t tmp[LFS_CRYPT_BD_AES_BLOCK_SIZE];
+
+    for(uint32_t i = 0U; i < LFS_CRYPT_BD_AES_BLOCK_SIZE; i++)
+    {
+        state[i] ^= round_keys[(AES_ROUNDS * LFS_CRYPT_BD_AES_BLOCK_SIZE) + i];
+    }
+
+    for(uint32_t round = AES_ROUNDS; round > 0U; round--)
+    {
+        /* InvShiftRows and InvSubBytes: row r of column c + r comes from column c */
+        for(uint32_t c = 0U; c < AES_COLUMNS; c++)
+        {
+            for(uint32_t r = 0U; r < 4U; r++)
+            {
+                tmp[(((c + r) % AES_COLUMNS) * 4U) + r] = _inv_sbox[state[(c * 4U) + r]];
+            }
+        }
+
+        for(uint32_t i = 0U; i < LFS_CRYPT_BD_AES_BLOCK_SIZE; i++)
+        {
+            tmp[i] ^= round_keys[((round - 1U) * LFS_CRYPT_BD_AES_BLOCK_SIZE) + i];
+        }
+
+        /* InvMixColumns, skipped in the last round. It is MixColumns applied
+         * after multiplying the even and the odd bytes by 4.
+         */
+        if(round > 1U)
+        {
+            for(uint32_t c = 0U; c < AES_COLUMNS; c++)
+            {
+                uint8_t *col = &tmp[c * 4U];
+                uint8_t even = _xtime(_xtime(col[0] ^ col[2]));
+                uint8_t odd = _xtime(_xtime(col[1] ^ col[3]));
+
+                col[0] ^= even;
+                col[1] ^= odd;
+                col[2] ^= even;
+                col[3] ^= odd;
+                _mix_column(col);
+            }
+        }
+
+        (void)memcpy(state, tmp, LFS_CRYPT_BD_AES_BLOCK_SIZE);
+    }
+}
+
+static int _software_xts(void *context, bool encrypt, const uint8_t data_unit[LFS_CRYPT_BD_AES_BLOCK_SIZE],
+        const uint8_t *input, uint8_t *output, lfs_size_t size)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The context of the software implementation is the lfs_crypt_bd_t instance.');
+    const lfs_crypt_bd_t *crypt = (const lfs_crypt_bd_t *)context;
+    uint8_t tweak[LFS_CRYPT_BD_AES_BLOCK_SIZE];
+    uint8_t state[LFS_CRYPT_BD_AES_BLOCK_SIZE];
+
+    (void)memcpy(tweak, data_unit, sizeof(tweak));
+    _encrypt_block(crypt->tweak_round_keys, tweak);
+
+    for(lfs_size_t done = 0U; done < size; done += LFS_CRYPT_BD_AES_BLOCK_SIZE)
+    {
+        for(uint32_t i = 0U; i < LFS_CRYPT_BD_AES_BLOCK_SIZE; i++)
+        {
+            state[i] = input[done + i] ^ tweak[i];
+        }
+
+        if(encrypt)
+        {
+            _encrypt_block(crypt->data_round_keys, state);
+        }
+        else
+        {
+            _decrypt_block(crypt->data_round_keys, state);
+        }
+
+        for(uint32_t i = 0U; i < LFS_CRYPT_BD_AES_BLOCK_SIZE; i++)
+        {
+            output[done + i] = state[i] ^ tweak[i];
+        }
+        _next_tweak(tweak);
+    }
+
+    return 0;
+}
+#endif /* #if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES) */
+
+/* Encrypts or decrypts a range of a block that starts and ends on data unit
+ * boundaries. Each data unit is processed with its own data unit number.
+ */
+static int32_t _crypt_units(const lfs_crypt_bd_t *crypt, bool encrypt, lfs_block_t block, lfs_off_t off,
+        const uint8_t *input, uint8_t *output, lfs_size_t size)
+{
+    int32_t res = 0;
+    uint64_t index = ((uint64_t)block * (crypt->backing->block_size / crypt->unit_size)) + (off / crypt->unit_size);
+    uint8_t data_unit[LFS_CRYPT_BD_AES_BLOCK_SIZE];
+
+    (void)memcpy(&data_unit[DATA_UNIT_INDEX_SIZE], crypt->nonce, LFS_CRYPT_BD_NONCE_SIZE);
+
+    for(lfs_size_t done = 0U; (0 == res) && (done < size); done += crypt->unit_size)
+    {
+        for(uint32_t i = 0U; i < DATA_UNIT_INDEX_SIZE; i++)
+        {
+            data_unit[i] = (uint8_t)(index >> (8U * i));
+        }
+
+        res = crypt->xts(crypt->xts_context, encrypt, data_unit, &input[done], &output[done], crypt->unit_size);
+        index++;
+    }
+
+    return res;
+}
+
+cy_rslt_t lfs_crypt_bd_create(struct lfs_config *lfs_cfg, lfs_crypt_bd_t *crypt,
+        const lfs_crypt_bd_config_t *config)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != crypt);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->backing);
+#if defined(LFS_CRYPT_BD_NO_SOFTWARE_AES)
+    LFS_ASSERT(NULL != config->xts);
+#else
+    LFS_ASSERT((NULL != config->xts) || (NULL != config->key));
+#endif /* #if defined(LFS_CRYPT_BD_NO_SOFTWARE_AES) */
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    const struct lfs_config *backing = config->backing;
+
+    /* The data unit is the program size, and at least one AES block. littlefs
+     * reads and programs whole data units, because each one is encrypted as a
+     * whole.
+     */
+    lfs_size_t unit_size = lfs_max(backing->prog_size, (lfs_size_t)LFS_CRYPT_BD_AES_BLOCK_SIZE);
+
+    if((0U != (unit_size % LFS_CRYPT_BD_AES_BLOCK_SIZE)) || (0U != (unit_size % backing->read_size)) ||
+       (0U != (unit_size % backing->prog_size)) || (0U != (backing->cache_size % unit_size)) ||
+       (0U != (LFS_CRYPT_BD_BUFFER_SIZE % unit_size)))
+    {
+        result = LFS_CRYPT_BD_RSLT_ERR_PROG_SIZE;
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        (void)memset(crypt, 0, sizeof(*crypt));
+        crypt->backing      = backing;
+        (void)memcpy(crypt->nonce, config->nonce, LFS_CRYPT_BD_NONCE_SIZE);
+        crypt->unit_size    = unit_size;
+        crypt->xts          = config->xts;
+        crypt->xts_context  = config->xts_context;
+
+#if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES)
+        if(NULL == crypt->xts)
+        {
+            _expand_key(crypt->data_round_keys, config->key);
+            _expand_key(crypt->tweak_round_keys, &config->key[AES_KEY_SIZE]);
+            crypt->xts          = _software_xts;
+            crypt->xts_context  = crypt;
+        }
+#endif /* #if !defined(LFS_CRYPT_BD_NO_SOFTWARE_AES) */
+
+        lfs_cfg->context     = crypt;
+
+        /* Block device operations */
+        lfs_cfg->read        = lfs_crypt_bd_read;
+        lfs_cfg->prog        = lfs_crypt_bd_prog;
+        lfs_cfg->erase       = lfs_crypt_bd_erase;
+        lfs_cfg->sync        = lfs_crypt_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+        lfs_cfg->lock        = lfs_crypt_bd_lock;
+        lfs_cfg->unlock      = lfs_crypt_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+        /* Encryption does not change the size of the data */
+        lfs_cfg->read_size      = unit_size;
+        lfs_cfg->prog_size      = unit_size;
+        lfs_cfg->block_size     = backing->block_size;
+        lfs_cfg->block_count    = backing->block_count;
+        lfs_cfg->block_cycles   = backing->block_cycles;
+        lfs_cfg->cache_size     = backing->cache_size;
+        lfs_cfg->lookahead_size = backing->lookahead_size;
+    }
+
+    return result;
+}
+
+void lfs_crypt_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_crypt_bd_t *crypt = _get_crypt(lfs_cfg);
+
+    /* Volatile access, so that clearing the key material is not optimized out */
+    volatile uint8_t *bytes = (volatile uint8_t *)crypt;
+    for(size_t i = 0U; i < sizeof(*crypt); i++)
+    {
+        bytes[i] = 0U;
+    }
+}
+
+int lfs_crypt_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    const lfs_crypt_bd_t *crypt = _get_crypt(lfs_cfg);
+    int32_t res = crypt->backing->read(crypt->backing, block, off, buffer, size);
+
+    if(0 == res)
+    {
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The buffer of littlefs is decrypted as bytes.');
+        uint8_t *data = (uint8_t *)buffer;
+        res = _crypt_units(crypt, false, block, off, data, data, size);
+    }
+
+    return res;
+}
+
+int lfs_crypt_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_crypt_bd_t *crypt = _get_crypt(lfs_cfg);
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The data of littlefs is encrypted as bytes.');
+    const uint8_t *data = (const uint8_t *)buffer;
+    int32_t res = 0;
+    lfs_size_t done = 0U;
+
+    /* The buffer of littlefs is not modified: littlefs may compare it with the
+     * programmed data afterwards.
+     */
+    while((0 == res) && (done < size))
+    {
+        lfs_size_t count = lfs_min(size - done, LFS_CRYPT_BD_BUFFER_SIZE);
+
+        res = _crypt_units(crypt, true, block, off + done, &data[done], crypt->buffer, count);
+        if(0 == res)
+        {
+            res = crypt->backing->prog(crypt->backing, block, off + done, crypt->buffer, count);
+        }
+        done += count;
+    }
+
+    return res;
+}
+
+int lfs_crypt_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    const struct lfs_config *backing = _get_crypt(lfs_cfg)->backing;
+    return backing->erase(backing, block);
+}
+
+int lfs_crypt_bd_sync(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    const struct lfs_config *backing = _get_crypt(lfs_cfg)->backing;
+    return backing->sync(backing);
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_crypt_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_crypt(lfs_cfg)->backing;
+    return backing->lock(backing);
+}
+
+int lfs_crypt_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_crypt(lfs_cfg)->backing;
+    return backing->unlock(backing);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
@@ -0,0 +1,347 @@
+/***************************************************************************//**
+ * \file lfs_maint_bd.c
+ *
+ * \brief
+ * Implements a block device that erases free blocks of another block device
+ * while it is idle.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_maint_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_maint_bd_unlock and lfs_maint_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',8,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/* lfs_fs_gc() is available from littlefs 2.8. */
+#define LFS_VERSION_FS_GC                           (0x00020008UL)
+
+static inline lfs_maint_bd_t *_get_maint(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_maint_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_maint_bd_t instance.');
+    return (lfs_maint_bd_t *)(lfs_cfg->context);
+}
+
+static inline bool _test(const uint8_t *map, lfs_block_t block)
+{
+    return (0U != (map[block / 8U] & (uint8_t)(1U << (block % 8U))));
+}
+
+static inline void _set(uint8_t *map, lfs_block_t block)
+{
+    map[block / 8U] |= (uint8_t)(1U << (block % 8U));
+}
+
+static inline void _clear(uint8_t *map, lfs_block_t block)
+{
+    map[block / 8U] &= (uint8_t)~(1U << (block % 8U));
+}
+
+/* Records foreground I/O. The I/O of lfs_maint_bd_run() does not end the
+ * idle time.
+ */
+static inline void _touch(lfs_maint_bd_t *maint)
+{
+    if(!maint->running)
+    {
+        maint->last_io = maint->get_time_ms();
+    }
+}
+
+static int _mark_in_use(void *data, lfs_block_t block)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer data is cast to lfs_maint_bd_t*. It is guaranteed that data points to a valid lfs_maint_bd_t instance.');
+    lfs_maint_bd_t *maint = (lfs_maint_bd_t *)data;
+
+    if(block < maint->backing->block_count)
+    {
+        _set(maint->in_use, block);
+    }
+
+    return 0;
+}
+
+/* Erases free blocks that are not yet erased, from where the previous run
+ * stopped, until the budget is used up or all blocks have been checked.
+ */
+static int32_t _erase_ahead(lfs_maint_bd_t *maint, uint32_t start, uint32_t budget_ms)
+{
+    const struct lfs_config *backing = maint->backing;
+    int32_t res = 0;
+    int32_t count = 0;
+
+    for(lfs_block_t checked = 0U; (checked < backing->block_count) && (0 == res) &&
+        ((maint->get_time_ms() - start) < budget_ms); checked++)
+    {
+        lfs_block_t block = maint->cursor;
+        maint->cursor = (block + 1U) % backing->block_count;
+
+        if(!_test(maint->in_use, block) && !_test(maint->erased, block))
+        {
+            uint32_t erase_start = maint->get_time_ms();
+
+            res = backing->erase(backing, block);
+            if(0 == res)
+            {
+                _set(maint->erased, block);
+                maint->stats.pre_erases++;
+                maint->stats.pre_erase_ms += maint->get_time_ms() - erase_start;
+                count++;
+            }
+        }
+    }
+
+    return (0 == res) ? count : res;
+}
+
+cy_rslt_t lfs_maint_bd_create(struct lfs_config *lfs_cfg, lfs_maint_bd_t *maint,
+        const lfs_maint_bd_config_t *config)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != maint);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->backing);
+    LFS_ASSERT(NULL != config->bitmap);
+    LFS_ASSERT(NULL != config->get_time_ms);
+
+    const struct lfs_config *backing = config->backing;
+    size_t map_size = (backing->block_count + 7UL) / 8UL;
+
+    (void)memset(maint, 0, sizeof(*maint));
+    maint->backing = backing;
+    maint->erased = config->bitmap;
+    maint->in_use = &config->bitmap[map_size];
+    maint->get_time_ms = config->get_time_ms;
+    maint->idle_ms = config->idle_ms;
+    maint->last_io = config->get_time_ms();
+
+    /* Nothing is known about the blocks until the first run. */
+    (void)memset(config->bitmap, 0, 2U * map_size);
+
+    lfs_cfg->context     = maint;
+
+    /* Block device operations */
+    lfs_cfg->read        = lfs_maint_bd_read;
+    lfs_cfg->prog        = lfs_maint_bd_prog;
+    lfs_cfg->erase       = lfs_maint_bd_erase;
+    lfs_cfg->sync        = lfs_maint_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+    lfs_cfg->lock        = lfs_maint_bd_lock;
+    lfs_cfg->unlock      = lfs_maint_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /* Block device configuration */
+    lfs_cfg->read_size      = backing->read_size;
+    lfs_cfg->prog_size      = backing->prog_size;
+    lfs_cfg->block_size     = backing->block_size;
+    lfs_cfg->block_count    = backing->block_count;
+    lfs_cfg->block_cycles   = backing->block_cycles;
+    lfs_cfg->cache_size     = backing->cache_size;
+    lfs_cfg->lookahead_size = backing->lookahead_size;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void lfs_maint_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_maint_bd_t *maint = _get_maint(lfs_cfg);
+    maint->map_valid = false;
+    maint->backing = NULL;
+}
+
+int lfs_maint_bd_run(const struct lfs_config *lfs_cfg, lfs_t *lfs, uint32_t budget_ms)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != lfs);
+
+    lfs_maint_bd_t *maint = _get_maint(lfs_cfg);
+    int32_t res = 0;
+
+#if defined(LFS_THREADSAFE)
+    /* Another task must not allocate a block between the traversal and the
+     * erases.
+     */
+    res = lfs_maint_bd_lock(lfs_cfg);
+    if(0 == res)
+    {
+#endif /* #if defined(LFS_THREADSAFE) */
+        uint32_t start = maint->get_time_ms();
+
+        if((start - maint->last_io) >= maint->idle_ms)
+        {
+            maint->running = true;
+            maint->stats.runs++;
+
+#if (LFS_VERSION >= LFS_VERSION_FS_GC)
+            res = lfs_fs_gc(lfs);
+            maint->stats.gc_calls++;
+#endif /* #if (LFS_VERSION >= LFS_VERSION_FS_GC) */
+
+            /* A block is free if the traversal does not report it. The map is
+             * reused until littlefs programs or erases a block.
+             */
+            if((0 == res) && !maint->map_valid)
+            {
+                (void)memset(maint->in_use, 0, (maint->backing->block_count + 7UL) / 8UL);
+                res = lfs_fs_traverse(lfs, _mark_in_use, maint);
+                maint->stats.traversals++;
+                maint->map_valid = (0 == res);
+            }
+
+            if(0 == res)
+            {
+                res = _erase_ahead(maint, start, budget_ms);
+            }
+
+            maint->running = false;
+        }
+
+#if defined(LFS_THREADSAFE)
+        (void)lfs_maint_bd_unlock(lfs_cfg);
+    }
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    return res;
+}
+
+void lfs_maint_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_maint_bd_stats_t *stats)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+
+    *stats = _get_maint(lfs_cfg)->stats;
+}
+
+int lfs_maint_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_maint_bd_t *maint = _get_maint(lfs_cfg);
+
+    _touch(maint);
+    return maint->backing->read(maint->backing, block, off, buffer, size);
+}
+
+int lfs_maint_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    lfs_maint_bd_t *maint = _get_maint(lfs_cfg);
+
+    _touch(maint);
+    _clear(maint->erased, block);
+    maint->map_valid = false;
+
+    return maint->backing->prog(maint->backing, block, off, buffer, size);
+}
+
+int lfs_maint_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    lfs_maint_bd_t *maint = _get_maint(lfs_cfg);
+    int32_t res = 0;
+
+    _touch(maint);
+    maint->map_valid = false;
+
+    if(_test(maint->erased, block))
+    {
+        /* Erased ahead of time and not programmed since */
+        maint->stats.erases_avoided++;
+    }
+    else
+    {
+        res = maint->backing->erase(maint->backing, block);
+        maint->stats.foreground_erases++;
+        if(0 == res)
+        {
+            _set(maint->erased, block);
+        }
+    }
+
+    return res;
+}
+
+int lfs_maint_bd_sync(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_maint_bd_t *maint = _get_maint(lfs_cfg);
+
+    _touch(maint);
+    return maint->backing->sync(maint->backing);
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_maint_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_maint(lfs_cfg)->backing;
+    return backing->lock(backing);
+}
+
+int lfs_maint_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_maint(lfs_cfg)->backing;
+    return backing->unlock(backing);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
@@ -0,0 +1,641 @@
+/***************************************************************************//**
+ * \file lfs_mirror_bd.c
+ *
+ * \brief
+ * Implements a mirrored block device for use with the littlefs API. Writes
+ * are duplicated to two member block devices and reads alternate between
+ * them.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_mirror_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_mirror_bd_unlock and lfs_mirror_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',8,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define RESULT_OK                                   (0)
+#define RESULT_ERROR                                (-1)
+
+#define LFS_CFG_LOOKAHEAD_SIZE_MIN                  (64UL) /* Must be a multiple of 8. */
+
+/* Bit position of a member of a given block in the resync map */
+#define RESYNC_MAP_BIT(block, member)               (((block) * LFS_MIRROR_BD_MEMBER_COUNT) + (member))
+
+#define OTHER_MEMBER(member)                        ((LFS_MIRROR_BD_MEMBER_COUNT - 1U) - (member))
+
+static inline lfs_mirror_bd_t *_get_mirror(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_mirror_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_mirror_bd_t instance.');
+    return (lfs_mirror_bd_t *)(lfs_cfg->context);
+}
+
+static bool _is_diverged(const lfs_mirror_bd_t *mirror, uint32_t member, lfs_block_t block)
+{
+    bool diverged = mirror->diverged[member];
+
+    if((!diverged) && (NULL != mirror->resync_map))
+    {
+        uint32_t bit = RESYNC_MAP_BIT(block, member);
+        diverged = (0U != (mirror->resync_map[bit / 8U] & (uint8_t)(1U << (bit % 8U))));
+    }
+
+    return diverged;
+}
+
+static void _set_diverged(lfs_mirror_bd_t *mirror, uint32_t member, lfs_block_t block)
+{
+    if(NULL != mirror->resync_map)
+    {
+        uint32_t bit = RESYNC_MAP_BIT(block, member);
+        mirror->resync_map[bit / 8U] |= (uint8_t)(1U << (bit % 8U));
+    }
+    else
+    {
+        /* Without a resync map, the whole member has to be restored. */
+        mirror->diverged[member] = true;
+    }
+}
+
+static void _clear_diverged(lfs_mirror_bd_t *mirror, uint32_t member, lfs_block_t block)
+{
+    if(NULL != mirror->resync_map)
+    {
+        uint32_t bit = RESYNC_MAP_BIT(block, member);
+        mirror->resync_map[bit / 8U] &= (uint8_t)~(1U << (bit % 8U));
+    }
+}
+
+/* Selects the member that serves a read. littlefs issues one operation at a
+ * time, so both members are always idle here; the in-sync members are taken in
+ * turn so that sequential reads are spread across both devices.
+ */
+static uint32_t _select_member(lfs_mirror_bd_t *mirror, lfs_block_t block)
+{
+    uint32_t member;
+
+    if(_is_diverged(mirror, LFS_MIRROR_BD_PRIMARY, block))
+    {
+        member = LFS_MIRROR_BD_SECONDARY;
+    }
+    else if(_is_diverged(mirror, LFS_MIRROR_BD_SECONDARY, block))
+    {
+        member = LFS_MIRROR_BD_PRIMARY;
+    }
+    else
+    {
+        member = mirror->next_member;
+        mirror->next_member = OTHER_MEMBER(member);
+    }
+
+    return member;
+}
+
+static int _member_read(lfs_mirror_bd_t *mirror, uint32_t member, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    const struct lfs_config *member_cfg = mirror->member[member];
+
+    int res = member_cfg->read(member_cfg, block, off, buffer, size);
+
+    if(RESULT_OK == res)
+    {
+        mirror->stats.read_count[member]++;
+        mirror->stats.read_bytes[member] += size;
+    }
+
+    return res;
+}
+
+/* Checks whether both members are the same device: the same lfs_config
+ * structure, or two structures of the same driver with the same context.
+ * Mirroring a device onto itself gives no redundancy.
+ */
+static bool _is_same_device(const struct lfs_config *primary, const struct lfs_config *secondary)
+{
+    return (primary == secondary) ||
+           ((primary->read == secondary->read) && (primary->context == secondary->context));
+}
+
+/* Combines the results of an operation applied to both members. The operation
+ * fails only when no member succeeded; a member that failed alone is recorded
+ * as diverged for the block.
+ */
+static int _complete_write(lfs_mirror_bd_t *mirror, lfs_block_t block, const int *res, bool is_erase)
+{
+    int result = RESULT_OK;
+
+    if((RESULT_OK != res[LFS_MIRROR_BD_PRIMARY]) && (RESULT_OK != res[LFS_MIRROR_BD_SECONDARY]))
+    {
+        result = RESULT_ERROR;
+    }
+    else
+    {
+        for(uint32_t member = 0U; member < LFS_MIRROR_BD_MEMBER_COUNT; member++)
+        {
+            if(RESULT_OK != res[member])
+            {
+                _set_diverged(mirror, member, block);
+                mirror->stats.degraded_writes++;
+            }
+            else if(is_erase && (RESULT_OK == res[OTHER_MEMBER(member)]))
+            {
+                /* The block is erased on both members and is identical again. */
+                _clear_diverged(mirror, member, block);
+            }
+            else
+            {
+                /* Nothing to update. */
+            }
+        }
+    }
+
+    return result;
+}
+
+static int _copy_block(lfs_mirror_bd_t *mirror, uint32_t src, uint32_t dst, lfs_block_t block,
+        uint8_t *buffer, lfs_size_t buffer_size)
+{
+    const struct lfs_config *src_cfg = mirror->member[src];
+    const struct lfs_config *dst_cfg = mirror->member[dst];
+
+    int res = dst_cfg->erase(dst_cfg, block);
+
+    for(lfs_off_t off = 0U; (RESULT_OK == res) && (off < dst_cfg->block_size); off += buffer_size)
+    {
+        res = src_cfg->read(src_cfg, block, off, buffer, buffer_size);
+        if(RESULT_OK == res)
+        {
+            res = dst_cfg->prog(dst_cfg, block, off, buffer, buffer_size);
+        }
+    }
+
+    if(RESULT_OK == res)
+    {
+        _clear_diverged(mirror, dst, block);
+        mirror->stats.resynced_blocks++;
+    }
+
+    return res;
+}
+
+cy_rslt_t lfs_mirror_bd_create(struct lfs_config *lfs_cfg, lfs_mirror_bd_t *mirror,
+        const lfs_mirror_bd_config_t *config)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_create(%p, %p, %p)", (void*)lfs_cfg, (void*)mirror, (void*)config);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != mirror);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->member[LFS_MIRROR_BD_PRIMARY]);
+    LFS_ASSERT(NULL != config->member[LFS_MIRROR_BD_SECONDARY]);
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    const struct lfs_config *primary = config->member[LFS_MIRROR_BD_PRIMARY];
+    const struct lfs_config *secondary = config->member[LFS_MIRROR_BD_SECONDARY];
+
+    (void)memset(mirror, 0, sizeof(*mirror));
+
+    /* Both members must use the same block numbering. The larger read and
+     * program sizes must be multiples of the smaller ones so that any request
+     * valid for the mirror is valid for both members.
+     */
+    lfs_size_t read_size = lfs_max(primary->read_size, secondary->read_size);
+    lfs_size_t prog_size = lfs_max(primary->prog_size, secondary->prog_size);
+
+    if((primary->block_size != secondary->block_size) ||
+       ((read_size % lfs_min(primary->read_size, secondary->read_size)) != 0U) ||
+       ((prog_size % lfs_min(primary->prog_size, secondary->prog_size)) != 0U))
+    {
+        result = LFS_MIRROR_BD_RSLT_ERR_GEOMETRY;
+    }
+    else if(_is_same_device(primary, secondary))
+    {
+        result = LFS_MIRROR_BD_RSLT_ERR_SAME_DEVICE;
+    }
+    else
+    {
+        /* The members are compatible. */
+    }
+
+    lfs_size_t block_count = lfs_min(primary->block_count, secondary->block_count);
+
+    if((CY_RSLT_SUCCESS == result) && (NULL != config->resync_map) &&
+       (config->resync_map_size < LFS_MIRROR_BD_RESYNC_MAP_SIZE(block_count)))
+    {
+        result = LFS_MIRROR_BD_RSLT_ERR_RESYNC_MAP;
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        mirror->member[LFS_MIRROR_BD_PRIMARY] = primary;
+        mirror->member[LFS_MIRROR_BD_SECONDARY] = secondary;
+        mirror->resync_map = config->resync_map;
+
+        if(NULL != mirror->resync_map)
+        {
+            (void)memset(mirror->resync_map, 0, LFS_MIRROR_BD_RESYNC_MAP_SIZE(block_count));
+        }
+
+        lfs_cfg->context     = mirror;
+
+        /* Block device operations */
+        lfs_cfg->read        = lfs_mirror_bd_read;
+        lfs_cfg->prog        = lfs_mirror_bd_prog;
+        lfs_cfg->erase       = lfs_mirror_bd_erase;
+        lfs_cfg->sync        = lfs_mirror_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+        lfs_cfg->lock        = lfs_mirror_bd_lock;
+        lfs_cfg->unlock      = lfs_mirror_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+        /* Block device configuration */
+        lfs_cfg->read_size   = read_size;
+        lfs_cfg->prog_size   = prog_size;
+        lfs_cfg->block_size  = primary->block_size;
+        lfs_cfg->block_count = block_count;
+
+        /* Refer to lfs.h for the description of the following parameters. */
+
+        /* Keep the wear-leveling policy of the primary member. */
+        lfs_cfg->block_cycles = primary->block_cycles;
+
+        /* cache_size must be a multiple of prog & read sizes and must divide
+         * block_size. The larger of the member values satisfies both as long
+         * as each member satisfies them for its own geometry.
+         */
+        lfs_cfg->cache_size = lfs_max(lfs_max(primary->cache_size, secondary->cache_size),
+                                      lfs_max(read_size, prog_size));
+
+        /* Must be a multiple of 8. */
+        lfs_cfg->lookahead_size = lfs_min((lfs_size_t) LFS_CFG_LOOKAHEAD_SIZE_MIN, 8UL * ((lfs_cfg->block_count + 63UL)/64UL) );
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_create -> %"PRIu32"", result);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    return result;
+}
+
+void lfs_mirror_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_destroy(%p)", (void*)lfs_cfg);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    mirror->member[LFS_MIRROR_BD_PRIMARY] = NULL;
+    mirror->member[LFS_MIRROR_BD_SECONDARY] = NULL;
+    mirror->resync_map = NULL;
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_destroy -> %d", 0);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+}
+
+int lfs_mirror_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_read(%p, "
+                    "0x%"PRIx32", %"PRIu32", %p, %"PRIu32")",
+                (void*)lfs_cfg, block, off, buffer, size);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+    LFS_ASSERT((off % lfs_cfg->read_size) == 0);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((size % lfs_cfg->read_size) == 0);
+
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    uint32_t member = _select_member(mirror, block);
+
+    int res = _member_read(mirror, member, block, off, buffer, size);
+    if((RESULT_OK != res) && !_is_diverged(mirror, OTHER_MEMBER(member), block))
+    {
+        mirror->stats.read_failovers++;
+        res = _member_read(mirror, OTHER_MEMBER(member), block, off, buffer, size);
+    }
+
+    res = (RESULT_OK == res) ? RESULT_OK : RESULT_ERROR;
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_read -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_mirror_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_prog(%p, "
+                    "0x%"PRIx32", %"PRIu32", %p, %"PRIu32")",
+                (void*)lfs_cfg, block, off, buffer, size);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+    LFS_ASSERT((off % lfs_cfg->prog_size) == 0);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((size % lfs_cfg->prog_size) == 0);
+
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    int member_res[LFS_MIRROR_BD_MEMBER_COUNT];
+
+    /* The primary member is always written first, so after a power loss it is
+     * never older than the secondary member.
+     */
+    for(uint32_t member = 0U; member < LFS_MIRROR_BD_MEMBER_COUNT; member++)
+    {
+        const struct lfs_config *member_cfg = mirror->member[member];
+        member_res[member] = member_cfg->prog(member_cfg, block, off, buffer, size);
+    }
+
+    int res = _complete_write(mirror, block, member_res, false);
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_prog -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_mirror_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_erase(%p, 0x%"PRIx32")", (void*)lfs_cfg, block);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    int member_res[LFS_MIRROR_BD_MEMBER_COUNT];
+
+    for(uint32_t member = 0U; member < LFS_MIRROR_BD_MEMBER_COUNT; member++)
+    {
+        const struct lfs_config *member_cfg = mirror->member[member];
+        member_res[member] = member_cfg->erase(member_cfg, block);
+    }
+
+    int res = _complete_write(mirror, block, member_res, true);
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_erase -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_mirror_bd_sync(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_sync(%p)", (void*)lfs_cfg);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    int res = RESULT_OK;
+
+    for(uint32_t member = 0U; member < LFS_MIRROR_BD_MEMBER_COUNT; member++)
+    {
+        const struct lfs_config *member_cfg = mirror->member[member];
+        if(RESULT_OK != member_cfg->sync(member_cfg))
+        {
+            res = RESULT_ERROR;
+        }
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_MIRROR_BD_TRACE("lfs_mirror_bd_sync -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_mirror_bd_resync(const struct lfs_config *lfs_cfg, void *buffer, lfs_size_t buffer_size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((buffer_size % lfs_cfg->prog_size) == 0);
+    LFS_ASSERT((lfs_cfg->block_size % buffer_size) == 0);
+
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    int res = RESULT_OK;
+
+    for(lfs_block_t block = 0U; (RESULT_OK == res) && (block < lfs_cfg->block_count); block++)
+    {
+        for(uint32_t member = 0U; (RESULT_OK == res) && (member < LFS_MIRROR_BD_MEMBER_COUNT); member++)
+        {
+            if(_is_diverged(mirror, member, block) && !_is_diverged(mirror, OTHER_MEMBER(member), block))
+            {
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer buffer is cast to uint8_t* for byte-level access.');
+                res = _copy_block(mirror, OTHER_MEMBER(member), member, block, (uint8_t *)buffer, buffer_size);
+            }
+        }
+    }
+
+    if(RESULT_OK == res)
+    {
+        mirror->diverged[LFS_MIRROR_BD_PRIMARY] = false;
+        mirror->diverged[LFS_MIRROR_BD_SECONDARY] = false;
+    }
+
+    return (RESULT_OK == res) ? RESULT_OK : RESULT_ERROR;
+}
+
+int lfs_mirror_bd_verify(const struct lfs_config *lfs_cfg, void *buffer, lfs_size_t buffer_size,
+        bool repair, lfs_block_t *diverged)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != buffer);
+
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    const struct lfs_config *primary = mirror->member[LFS_MIRROR_BD_PRIMARY];
+    const struct lfs_config *secondary = mirror->member[LFS_MIRROR_BD_SECONDARY];
+    lfs_size_t chunk_size = buffer_size / 2U;
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer buffer is cast to uint8_t* for byte-level access.');
+    uint8_t *primary_buf = (uint8_t *)buffer;
+    uint8_t *secondary_buf = &primary_buf[chunk_size];
+    lfs_block_t diverged_count = 0U;
+    int res = RESULT_OK;
+
+    LFS_ASSERT((chunk_size % lfs_cfg->read_size) == 0);
+    LFS_ASSERT((chunk_size % lfs_cfg->prog_size) == 0);
+    LFS_ASSERT((lfs_cfg->block_size % chunk_size) == 0);
+
+    for(lfs_block_t block = 0U; (RESULT_OK == res) && (block < lfs_cfg->block_count); block++)
+    {
+        bool differs = false;
+
+        for(lfs_off_t off = 0U; (RESULT_OK == res) && !differs && (off < lfs_cfg->block_size); off += chunk_size)
+        {
+            res = primary->read(primary, block, off, primary_buf, chunk_size);
+            if(RESULT_OK == res)
+            {
+                res = secondary->read(secondary, block, off, secondary_buf, chunk_size);
+            }
+            if(RESULT_OK == res)
+            {
+                differs = (0 != memcmp(primary_buf, secondary_buf, chunk_size));
+            }
+        }
+
+        if((RESULT_OK == res) && differs)
+        {
+            diverged_count++;
+            if(repair)
+            {
+                res = _copy_block(mirror, LFS_MIRROR_BD_PRIMARY, LFS_MIRROR_BD_SECONDARY, block,
+                                  primary_buf, chunk_size);
+            }
+            else
+            {
+                _set_diverged(mirror, LFS_MIRROR_BD_SECONDARY, block);
+            }
+        }
+    }
+
+    if(NULL != diverged)
+    {
+        *diverged = diverged_count;
+    }
+
+    return (RESULT_OK == res) ? RESULT_OK : RESULT_ERROR;
+}
+
+void lfs_mirror_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_mirror_bd_stats_t *stats)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+
+    *stats = _get_mirror(lfs_cfg)->stats;
+}
+
+void lfs_mirror_bd_reset_stats(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    (void)memset(&_get_mirror(lfs_cfg)->stats, 0, sizeof(lfs_mirror_bd_stats_t));
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_mirror_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    const struct lfs_config *primary = mirror->member[LFS_MIRROR_BD_PRIMARY];
+    const struct lfs_config *secondary = mirror->member[LFS_MIRROR_BD_SECONDARY];
+
+    /* Members are always locked in the same order to avoid a deadlock with
+     * another mirror or a direct user of the same member.
+     */
+    int res = primary->lock(primary);
+    if(RESULT_OK == res)
+    {
+        res = secondary->lock(secondary);
+        if(RESULT_OK != res)
+        {
+            (void)primary->unlock(primary);
+        }
+    }
+
+    return (RESULT_OK == res) ? RESULT_OK : RESULT_ERROR;
+}
+
+int lfs_mirror_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    lfs_mirror_bd_t *mirror = _get_mirror(lfs_cfg);
+    const struct lfs_config *primary = mirror->member[LFS_MIRROR_BD_PRIMARY];
+    const struct lfs_config *secondary = mirror->member[LFS_MIRROR_BD_SECONDARY];
+
+    int res_secondary = secondary->unlock(secondary);
+    int res_primary = primary->unlock(primary);
+
+    return ((RESULT_OK == res_secondary) && (RESULT_OK == res_primary)) ? RESULT_OK : RESULT_ERROR;
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
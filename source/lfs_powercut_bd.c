@@ -0,0 +1,409 @@
+/***************************************************************************//**
+ * \file lfs_powercut_bd.c
+ *
+ * \brief
+ * Implements a block device that injects power losses in front of another
+ * block device and measures the cost of the recovery that follows.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_powercut_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_powercut_bd_unlock and lfs_powercut_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',4,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define RESULT_ERROR                                (-1)
+
+static inline lfs_powercut_bd_t *_get_cut(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_powercut_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_powercut_bd_t instance.');
+    return (lfs_powercut_bd_t *)(lfs_cfg->context);
+}
+
+/* xorshift32: small, deterministic and good enough to spread cut points. */
+static uint32_t _next_rand(lfs_powercut_bd_t *cut)
+{
+    uint32_t x = cut->rand_state;
+
+    x ^= x << 13U;
+    x ^= x >> 17U;
+    x ^= x << 5U;
+    cut->rand_state = x;
+
+    return x;
+}
+
+/* Counts a program or erase operation. Returns true when the power has to be
+ * cut before this operation completes.
+ */
+static bool _reach_cut_point(lfs_powercut_bd_t *cut)
+{
+    bool cut_now = false;
+
+    if(cut->armed)
+    {
+        cut->ops_left--;
+        cut_now = (0U == cut->ops_left);
+    }
+
+    return cut_now;
+}
+
+static void _cut_power(lfs_powercut_bd_t *cut)
+{
+    cut->powered = false;
+    cut->armed = false;
+    cut->recovering = false;
+    cut->stats.cuts++;
+}
+
+static uint32_t _histogram_bucket(uint32_t elapsed)
+{
+    uint32_t bucket = 0U;
+
+    while((0U != elapsed) && (bucket < (LFS_POWERCUT_BD_HISTOGRAM_BUCKETS - 1U)))
+    {
+        elapsed >>= 1U;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+static void _update_max(lfs_powercut_bd_counters_t *max, const lfs_powercut_bd_counters_t *counters)
+{
+    max->read_count  = lfs_max(max->read_count, counters->read_count);
+    max->read_bytes  = lfs_max(max->read_bytes, counters->read_bytes);
+    max->prog_count  = lfs_max(max->prog_count, counters->prog_count);
+    max->prog_bytes  = lfs_max(max->prog_bytes, counters->prog_bytes);
+    max->erase_count = lfs_max(max->erase_count, counters->erase_count);
+    max->sync_count  = lfs_max(max->sync_count, counters->sync_count);
+}
+
+cy_rslt_t lfs_powercut_bd_create(struct lfs_config *lfs_cfg, lfs_powercut_bd_t *cut,
+        const lfs_powercut_bd_config_t *config)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_POWERCUT_BD_TRACE("lfs_powercut_bd_create(%p, %p, %p)", (void*)lfs_cfg, (void*)cut, (void*)config);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != cut);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->backing);
+    LFS_ASSERT(0U < config->max_ops);
+
+    const struct lfs_config *backing = config->backing;
+
+    (void)memset(cut, 0, sizeof(*cut));
+    cut->config = *config;
+    cut->rand_state = config->seed;
+    cut->powered = true;
+    cut->stats.time_min = UINT32_MAX;
+
+    lfs_cfg->context     = cut;
+
+    /* Block device operations */
+    lfs_cfg->read        = lfs_powercut_bd_read;
+    lfs_cfg->prog        = lfs_powercut_bd_prog;
+    lfs_cfg->erase       = lfs_powercut_bd_erase;
+    lfs_cfg->sync        = lfs_powercut_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+    lfs_cfg->lock        = lfs_powercut_bd_lock;
+    lfs_cfg->unlock      = lfs_powercut_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /* The geometry and the littlefs tuning of the backing device are used
+     * unchanged, so the measured recovery matches the real configuration.
+     */
+    lfs_cfg->read_size      = backing->read_size;
+    lfs_cfg->prog_size      = backing->prog_size;
+    lfs_cfg->block_size     = backing->block_size;
+    lfs_cfg->block_count    = backing->block_count;
+    lfs_cfg->block_cycles   = backing->block_cycles;
+    lfs_cfg->cache_size     = backing->cache_size;
+    lfs_cfg->lookahead_size = backing->lookahead_size;
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_POWERCUT_BD_TRACE("lfs_powercut_bd_create -> %"PRIu32"", CY_RSLT_SUCCESS);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    return CY_RSLT_SUCCESS;
+}
+
+void lfs_powercut_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+    cut->armed = false;
+    cut->config.backing = NULL;
+}
+
+void lfs_powercut_bd_arm(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+
+    cut->ops_left = (0U != cut->config.seed) ? ((_next_rand(cut) % cut->config.max_ops) + 1U) :
+                                               cut->config.max_ops;
+    cut->armed = true;
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_POWERCUT_BD_TRACE("lfs_powercut_bd_arm: cut after %"PRIu32" operations", cut->ops_left);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+}
+
+void lfs_powercut_bd_disarm(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    _get_cut(lfs_cfg)->armed = false;
+}
+
+bool lfs_powercut_bd_is_cut(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return !_get_cut(lfs_cfg)->powered;
+}
+
+void lfs_powercut_bd_power_on(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+
+    cut->powered = true;
+    cut->armed = false;
+    cut->recovering = true;
+    (void)memset(&cut->counters, 0, sizeof(cut->counters));
+    cut->recovery_start = (NULL != cut->config.get_time) ? cut->config.get_time() : 0U;
+}
+
+void lfs_powercut_bd_recovery_done(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+    lfs_powercut_bd_stats_t *stats = &cut->stats;
+
+    if(cut->recovering)
+    {
+        uint32_t elapsed = (NULL != cut->config.get_time) ?
+                           (cut->config.get_time() - cut->recovery_start) : 0U;
+
+        cut->recovering = false;
+        stats->recoveries++;
+        stats->time_total += elapsed;
+        stats->time_min = lfs_min(stats->time_min, elapsed);
+        if((elapsed >= stats->time_max) || (1U == stats->recoveries))
+        {
+            stats->time_max = elapsed;
+            stats->worst = cut->counters;
+        }
+        stats->last = cut->counters;
+        _update_max(&stats->max, &cut->counters);
+        stats->histogram[_histogram_bucket(elapsed)]++;
+    }
+}
+
+void lfs_powercut_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_powercut_bd_stats_t *stats)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+
+    *stats = _get_cut(lfs_cfg)->stats;
+    if(0U == stats->recoveries)
+    {
+        stats->time_min = 0U;
+    }
+}
+
+int lfs_powercut_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+    const struct lfs_config *backing = cut->config.backing;
+    int res = RESULT_ERROR;
+
+    if(cut->powered)
+    {
+        cut->counters.read_count++;
+        cut->counters.read_bytes += size;
+        res = backing->read(backing, block, off, buffer, size);
+    }
+
+    return res;
+}
+
+int lfs_powercut_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+    const struct lfs_config *backing = cut->config.backing;
+    int res = RESULT_ERROR;
+
+    if(cut->powered)
+    {
+        cut->counters.prog_count++;
+        cut->counters.prog_bytes += size;
+
+        if(_reach_cut_point(cut))
+        {
+            /* A torn program leaves a whole number of program units behind,
+             * which is what an interrupted page program looks like to littlefs.
+             */
+            lfs_size_t units = size / lfs_cfg->prog_size;
+            if(cut->config.tear_prog && (1U < units))
+            {
+                lfs_size_t torn = (_next_rand(cut) % units) * lfs_cfg->prog_size;
+                if(0U < torn)
+                {
+                    (void)backing->prog(backing, block, off, buffer, torn);
+                }
+            }
+
+            _cut_power(cut);
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+            LFS_POWERCUT_BD_TRACE("lfs_powercut_bd_prog: power cut at block 0x%"PRIx32", off %"PRIu32"", block, off);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+        }
+        else
+        {
+            res = backing->prog(backing, block, off, buffer, size);
+        }
+    }
+
+    return res;
+}
+
+int lfs_powercut_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+    const struct lfs_config *backing = cut->config.backing;
+    int res = RESULT_ERROR;
+
+    if(cut->powered)
+    {
+        cut->counters.erase_count++;
+
+        if(_reach_cut_point(cut))
+        {
+            _cut_power(cut);
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+            LFS_POWERCUT_BD_TRACE("lfs_powercut_bd_erase: power cut at block 0x%"PRIx32"", block);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+        }
+        else
+        {
+            res = backing->erase(backing, block);
+        }
+    }
+
+    return res;
+}
+
+int lfs_powercut_bd_sync(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_powercut_bd_t *cut = _get_cut(lfs_cfg);
+    const struct lfs_config *backing = cut->config.backing;
+    int res = RESULT_ERROR;
+
+    if(cut->powered)
+    {
+        cut->counters.sync_count++;
+        res = backing->sync(backing);
+    }
+
+    return res;
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_powercut_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_cut(lfs_cfg)->config.backing;
+    return backing->lock(backing);
+}
+
+int lfs_powercut_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_cut(lfs_cfg)->config.backing;
+    return backing->unlock(backing);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
@@ -0,0 +1,338 @@
+/***************************************************************************//**
+ * \file lfs_ram_bd.c
+ *
+ * \brief
+ * Implements the block device driver functions for a region of RAM for use
+ * with littlefs API.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_ram_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_ram_bd_unlock and lfs_ram_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',4,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define ERASED_VALUE                        (0xFFU)
+#define LFS_CFG_LOOKAHEAD_SIZE_MIN          (64UL) /* Must be a multiple of 8. */
+
+#if defined(LFS_THREADSAFE)
+#define RESULT_OK                           (0)
+#define RESULT_ERROR                        (-1)
+#define GET_INT_RETURN_VALUE(result)        ((CY_RSLT_SUCCESS == (result)) ? RESULT_OK : RESULT_ERROR)
+
+#ifndef LFS_RAM_BD_GET_MUTEX_TIMEOUT_MS
+#define LFS_RAM_BD_GET_MUTEX_TIMEOUT_MS     (500UL)
+#endif /* #ifndef LFS_RAM_BD_GET_MUTEX_TIMEOUT_MS */
+#endif /* #if defined(LFS_THREADSAFE) */
+
+static inline lfs_ram_bd_t *_get_ram(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_ram_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_ram_bd_t instance.');
+    return (lfs_ram_bd_t *)lfs_cfg->context;
+}
+
+static inline uint8_t *_get_addr(const struct lfs_config *lfs_cfg, lfs_block_t block, lfs_off_t off)
+{
+    return &_get_ram(lfs_cfg)->buffer[((size_t)block * lfs_cfg->block_size) + off];
+}
+
+cy_rslt_t lfs_ram_bd_create(struct lfs_config *lfs_cfg, lfs_ram_bd_t *ram,
+        const lfs_ram_bd_config_t *config)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_create(%p, %p, %p)", (void*)lfs_cfg, (void*)ram, (void*)config);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != ram);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->buffer);
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if((0U == config->prog_size) || (0U == config->block_count) ||
+       (0U == config->block_size) || (0U != (config->block_size % config->prog_size)))
+    {
+        result = LFS_RAM_BD_RSLT_ERR_GEOMETRY;
+    }
+
+#if defined(LFS_THREADSAFE)
+    if(CY_RSLT_SUCCESS == result)
+    {
+        result = cy_rtos_init_mutex(&ram->mutex);
+    }
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer config->buffer is cast to uint8_t* for byte-level access. It is guaranteed that config->buffer points to a memory region of block_size * block_count bytes.');
+        ram->buffer = (uint8_t *)config->buffer;
+        ram->check_nor = config->check_nor;
+        ram->violations = 0U;
+
+        if(!config->retained)
+        {
+            (void)memset(ram->buffer, (int)ERASED_VALUE,
+                         (size_t)config->block_size * config->block_count);
+        }
+
+        lfs_cfg->context     = ram;
+
+        /* Block device operations */
+        lfs_cfg->read        = lfs_ram_bd_read;
+        lfs_cfg->prog        = lfs_ram_bd_prog;
+        lfs_cfg->erase       = lfs_ram_bd_erase;
+        lfs_cfg->sync        = lfs_ram_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+        lfs_cfg->lock        = lfs_ram_bd_lock;
+        lfs_cfg->unlock      = lfs_ram_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+        /* Block device configuration */
+        lfs_cfg->read_size   = config->prog_size;
+        lfs_cfg->prog_size   = config->prog_size;
+        lfs_cfg->block_size  = config->block_size;
+        lfs_cfg->block_count = config->block_count;
+
+        /* RAM does not wear out, so wear leveling is disabled. */
+        lfs_cfg->block_cycles = -1;
+
+        /* Copies are cheap, so the smallest valid cache saves RAM. */
+        lfs_cfg->cache_size = config->prog_size;
+
+        /* Must be a multiple of 8. */
+        lfs_cfg->lookahead_size = lfs_min((lfs_size_t) LFS_CFG_LOOKAHEAD_SIZE_MIN, 8UL * ((lfs_cfg->block_count + 63UL)/64UL) );
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_create -> %"PRIu32"", result);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    return result;
+}
+
+void lfs_ram_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_destroy(%p)", (void*)lfs_cfg);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_ram_bd_t *ram = _get_ram(lfs_cfg);
+
+#if defined(LFS_THREADSAFE)
+    cy_rslt_t result = cy_rtos_deinit_mutex(&ram->mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    ram->buffer = NULL;
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_destroy -> %d", 0);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+}
+
+int lfs_ram_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_read(%p, "
+                    "0x%"PRIx32", %"PRIu32", %p, %"PRIu32")",
+                (void*)lfs_cfg, block, off, buffer, size);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+    LFS_ASSERT((off % lfs_cfg->read_size) == 0);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((size % lfs_cfg->read_size) == 0);
+    LFS_ASSERT((off + size) <= lfs_cfg->block_size);
+
+    (void)memcpy(buffer, _get_addr(lfs_cfg, block, off), size);
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_read -> %d", 0);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return 0;
+}
+
+int lfs_ram_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_prog(%p, "
+                    "0x%"PRIx32", %"PRIu32", %p, %"PRIu32")",
+                (void*)lfs_cfg, block, off, buffer, size);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+    LFS_ASSERT((off % lfs_cfg->prog_size) == 0);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((size % lfs_cfg->prog_size) == 0);
+    LFS_ASSERT((off + size) <= lfs_cfg->block_size);
+
+    lfs_ram_bd_t *ram = _get_ram(lfs_cfg);
+    uint8_t *addr = _get_addr(lfs_cfg, block, off);
+    int32_t res = 0;
+
+    if(ram->check_nor)
+    {
+        /* A NOR flash can only program erased bytes; programming again would
+         * AND the old and new data.
+         */
+        for(lfs_size_t i = 0U; (i < size) && (0 == res); i++)
+        {
+            if(ERASED_VALUE != addr[i])
+            {
+                ram->violations++;
+                res = LFS_ERR_IO;
+            }
+        }
+    }
+
+    if(0 == res)
+    {
+        (void)memcpy(addr, buffer, size);
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_prog -> %d", (int)res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_ram_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_erase(%p, 0x%"PRIx32")", (void*)lfs_cfg, block);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    (void)memset(_get_addr(lfs_cfg, block, 0U), (int)ERASED_VALUE, lfs_cfg->block_size);
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_RAM_BD_TRACE("lfs_ram_bd_erase -> %d", 0);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return 0;
+}
+
+/* Simply return zero because the data is in place once programmed. */
+
+int lfs_ram_bd_sync(const struct lfs_config *lfs_cfg)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',2,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 21.6',2,\
+    'Using the safe wrapper of printf')
+    LFS_RAM_BD_TRACE("lfs_ram_bd_sync(%p)", (void*)lfs_cfg);
+    LFS_RAM_BD_TRACE("lfs_ram_bd_sync -> %d", 0);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 21.6')
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return 0;
+}
+
+uint32_t lfs_ram_bd_get_violations(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return _get_ram(lfs_cfg)->violations;
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_ram_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return GET_INT_RETURN_VALUE(cy_rtos_get_mutex(&_get_ram(lfs_cfg)->mutex, LFS_RAM_BD_GET_MUTEX_TIMEOUT_MS));
+}
+
+int lfs_ram_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return GET_INT_RETURN_VALUE(cy_rtos_set_mutex(&_get_ram(lfs_cfg)->mutex));
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
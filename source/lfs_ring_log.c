@@ -0,0 +1,917 @@
+/***************************************************************************//**
+ * \file lfs_ring_log.c
+ *
+ * \brief
+ * Fixed-size circular record log on a reserved block range
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_ring_log.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+/* This block of code ignores violations of Directive 4.6 MISRA. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',5,\
+'The third-party defines the function interface with basic numeral type')
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/* Index entry of a block that holds no valid header */
+#define INDEX_INVALID                           (0xFFFFFFFFUL)
+
+/* First byte of a record header. It differs from both erased values, 0xFF
+ * on NOR flash and 0x00 on some SD cards, and from the padding byte.
+ */
+#define RECORD_TAG                              (0x52U)
+#define RECORD_MAX_SIZE                         (0xFFFFUL)
+
+/* Offsets in a record header: tag, size, CRC of the tag, size and data */
+#define RECORD_SIZE_OFF                         (1U)
+#define RECORD_CRC_OFF                          (3U)
+
+/* Results of _record_at() besides the error codes */
+#define RECORD_FOUND                            (0)
+#define RECORD_END                              (1)
+
+/* Fills the unused end of a programmed page */
+#define PAD_BYTE                                (0xFFU)
+
+static inline void _lock(const lfs_ring_log_t *log)
+{
+#if defined(LFS_THREADSAFE)
+    (void)log->config->bd->lock(log->config->bd);
+#else
+    CY_UNUSED_PARAMETER(log);
+#endif /* #if defined(LFS_THREADSAFE) */
+}
+
+static inline void _unlock(const lfs_ring_log_t *log)
+{
+#if defined(LFS_THREADSAFE)
+    (void)log->config->bd->unlock(log->config->bd);
+#else
+    CY_UNUSED_PARAMETER(log);
+#endif /* #if defined(LFS_THREADSAFE) */
+}
+
+static inline lfs_block_t _next(const lfs_ring_log_t *log, lfs_block_t block)
+{
+    return (block + 1U) % log->config->block_count;
+}
+
+/* Sequence numbers wrap, so they are compared by their distance. */
+static inline bool _seq_before(uint32_t a, uint32_t b)
+{
+    return ((int32_t)(a - b) < 0);
+}
+
+static inline void _put_le16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8U);
+}
+
+static inline uint16_t _get_le16(const uint8_t *p)
+{
+    return (uint16_t)((uint16_t)p[0] | (uint16_t)((uint16_t)p[1] << 8U));
+}
+
+static inline void _put_le32(uint8_t *p, uint32_t value)
+{
+    uint32_t le = lfs_tole32(value);
+    (void)memcpy(p, &le, sizeof(le));
+}
+
+static inline uint32_t _get_le32(const uint8_t *p)
+{
+    uint32_t le;
+    (void)memcpy(&le, p, sizeof(le));
+    return lfs_fromle32(le);
+}
+
+/* Returns the content of a page. The page being filled is served from RAM,
+ * the others through the one-page read cache.
+ */
+static int32_t _load(lfs_ring_log_t *log, lfs_block_t block, lfs_off_t page_off, const uint8_t **page)
+{
+    const lfs_ring_log_config_t *config = log->config;
+    int32_t res = 0;
+
+    if((block == log->head) && (page_off == log->page_off))
+    {
+        *page = log->page;
+    }
+    else
+    {
+        if((block != log->read_block) || (page_off != log->read_off))
+        {
+            res = config->bd->read(config->bd, config->first_block + block, page_off,
+                                   log->read_page, config->page_size);
+            log->read_block = (0 == res) ? block : config->block_count;
+            log->read_off = page_off;
+        }
+        *page = log->read_page;
+    }
+
+    return res;
+}
+
+static int32_t _read(lfs_ring_log_t *log, lfs_block_t block, lfs_off_t off, uint8_t *buffer, lfs_size_t size)
+{
+    lfs_size_t page_size = log->config->page_size;
+    int32_t res = 0;
+
+    while((0U != size) && (0 == res))
+    {
+        lfs_off_t page_off = off - (off % page_size);
+        lfs_size_t chunk = lfs_min(size, (page_off + page_size) - off);
+        const uint8_t *page = NULL;
+
+        res = _load(log, block, page_off, &page);
+        if(0 == res)
+        {
+            (void)memcpy(buffer, &page[off - page_off], chunk);
+            buffer = &buffer[chunk];
+            off += chunk;
+            size -= chunk;
+        }
+    }
+
+    return res;
+}
+
+static uint16_t _record_crc(const uint8_t *header, const void *data, lfs_size_t size)
+{
+    uint32_t crc = lfs_crc(0xFFFFFFFFUL, header, RECORD_CRC_OFF);
+    return (uint16_t)lfs_crc(crc, data, size);
+}
+
+/* Finds the record header at or after an offset of a block. A header never
+ * spans two pages: the writer leaves the last bytes of a page unused when
+ * fewer than a header remain. Any byte other than the tag in the middle of a
+ * page is the padding of a flush; at the start of a page it is the end of
+ * the block, whatever value the device reads back after an erase.
+ */
+static int32_t _record_at(lfs_ring_log_t *log, lfs_block_t block, lfs_off_t *off,
+        lfs_size_t *size, uint16_t *crc)
+{
+    const lfs_ring_log_config_t *config = log->config;
+    lfs_size_t page_size = config->page_size;
+    int32_t res = RECORD_END;
+    bool done = false;
+
+    while(!done)
+    {
+        lfs_off_t in_page = *off % page_size;
+        uint8_t header[LFS_RING_LOG_RECORD_OVERHEAD];
+
+        done = true;
+        if(((block == log->head) && (*off >= log->write_off)) ||
+           ((*off + LFS_RING_LOG_RECORD_OVERHEAD) > config->bd->block_size))
+        {
+            res = RECORD_END;
+        }
+        else if((page_size - in_page) < LFS_RING_LOG_RECORD_OVERHEAD)
+        {
+            *off += page_size - in_page;
+            done = false;
+        }
+        else
+        {
+            res = _read(log, block, *off, header, sizeof(header));
+            if(0 == res)
+            {
+                uint16_t record_size = _get_le16(&header[RECORD_SIZE_OFF]);
+
+                if(RECORD_TAG != header[0])
+                {
+                    if(0U == in_page)
+                    {
+                        res = RECORD_END;
+                    }
+                    else
+                    {
+                        *off += page_size - in_page;
+                        done = false;
+                    }
+                }
+                else if((0U == record_size) ||
+                        ((*off + LFS_RING_LOG_RECORD_OVERHEAD + record_size) > config->bd->block_size))
+                {
+                    res = LFS_ERR_CORRUPT;
+                }
+                else
+                {
+                    *size = record_size;
+                    *crc = _get_le16(&header[RECORD_CRC_OFF]);
+                    res = RECORD_FOUND;
+                }
+            }
+        }
+    }
+
+    return res;
+}
+
+/* Computes the CRC of a stored record without copying it. */
+static int32_t _check_record(lfs_ring_log_t *log, lfs_block_t block, lfs_off_t off,
+        lfs_size_t size, uint16_t crc, bool *valid)
+{
+    lfs_size_t page_size = log->config->page_size;
+    uint8_t header[RECORD_CRC_OFF];
+    int32_t res = 0;
+
+    header[0] = RECORD_TAG;
+    _put_le16(&header[RECORD_SIZE_OFF], (uint16_t)size);
+    uint32_t sum = lfs_crc(0xFFFFFFFFUL, header, sizeof(header));
+    off += LFS_RING_LOG_RECORD_OVERHEAD;
+    while((0U != size) && (0 == res))
+    {
+        lfs_off_t page_off = off - (off % page_size);
+        lfs_size_t chunk = lfs_min(size, (page_off + page_size) - off);
+        const uint8_t *page = NULL;
+
+        res = _load(log, block, page_off, &page);
+        if(0 == res)
+        {
+            sum = lfs_crc(sum, &page[off - page_off], chunk);
+            off += chunk;
+            size -= chunk;
+        }
+    }
+
+    *valid = ((uint16_t)sum == crc);
+
+    return res;
+}
+
+static int32_t _prog_page(lfs_ring_log_t *log)
+{
+    const lfs_ring_log_config_t *config = log->config;
+    int32_t res = config->bd->prog(config->bd, config->first_block + log->head, log->page_off,
+                                   log->page, config->page_size);
+
+    if((log->read_block == log->head) && (log->read_off == log->page_off))
+    {
+        log->read_block = config->block_count;
+    }
+    log->programmed_pages++;
+    log->page_off += config->page_size;
+    log->write_off = log->page_off;
+    (void)memset(log->page, PAD_BYTE, config->page_size);
+
+    return res;
+}
+
+static int32_t _put(lfs_ring_log_t *log, const uint8_t *data, lfs_size_t size)
+{
+    lfs_size_t page_size = log->config->page_size;
+    int32_t res = 0;
+
+    while((0U != size) && (0 == res))
+    {
+        lfs_size_t chunk = lfs_min(size, (log->page_off + page_size) - log->write_off);
+
+        (void)memcpy(&log->page[log->write_off - log->page_off], data, chunk);
+        log->write_off += chunk;
+        data = &data[chunk];
+        size -= chunk;
+
+        if(log->write_off == (log->page_off + page_size))
+        {
+            res = _prog_page(log);
+        }
+    }
+
+    return res;
+}
+
+/* Erases the first block after the ones already erased ahead. The oldest
+ * records are dropped when that block holds them.
+ */
+static int32_t _erase_ahead(lfs_ring_log_t *log)
+{
+    const lfs_ring_log_config_t *config = log->config;
+    lfs_block_t block = (log->head + log->erased_ahead + 1U) % config->block_count;
+
+    config->index[block] = INDEX_INVALID;
+    if(log->read_block == block)
+    {
+        log->read_block = config->block_count;
+    }
+
+    int32_t res = config->bd->erase(config->bd, config->first_block + block);
+    if(0 == res)
+    {
+        log->erased_ahead++;
+    }
+
+    return res;
+}
+
+static int32_t _next_block(lfs_ring_log_t *log)
+{
+    const lfs_ring_log_config_t *config = log->config;
+    int32_t res = 0;
+
+    if(log->write_off > log->page_off)
+    {
+        res = _prog_page(log);
+    }
+
+    if((0 == res) && (0U == log->erased_ahead))
+    {
+        res = _erase_ahead(log);
+        log->append_erases++;
+    }
+
+    if(0 == res)
+    {
+        uint8_t header[LFS_RING_LOG_BLOCK_HEADER_SIZE];
+
+        log->erased_ahead--;
+        log->head = _next(log, log->head);
+        log->page_off = 0U;
+        log->write_off = 0U;
+        config->index[log->head] = log->next_seq;
+
+        _put_le32(&header[0U], LFS_RING_LOG_MAGIC);
+        _put_le32(&header[4U], log->next_seq);
+        _put_le32(&header[8U], lfs_crc(0xFFFFFFFFUL, header, 8U));
+        res = _put(log, header, sizeof(header));
+    }
+
+    while((0 == res) && !config->defer_erase && (log->erased_ahead < config->erase_ahead))
+    {
+        res = _erase_ahead(log);
+        log->append_erases++;
+    }
+
+    return res;
+}
+
+/* Returns the oldest block of the run of valid blocks that ends at the block
+ * being written, or the number of blocks if the log holds no records.
+ */
+static lfs_block_t _tail(const lfs_ring_log_t *log, lfs_block_t *count)
+{
+    const lfs_ring_log_config_t *config = log->config;
+    lfs_block_t tail = config->block_count;
+
+    *count = 0U;
+    if((log->head < config->block_count) && (INDEX_INVALID != config->index[log->head]))
+    {
+        lfs_block_t prev = (log->head + config->block_count - 1U) % config->block_count;
+
+        tail = log->head;
+        *count = 1U;
+        while((*count < config->block_count) && (INDEX_INVALID != config->index[prev]) &&
+              _seq_before(config->index[prev], config->index[tail]))
+        {
+            tail = prev;
+            (*count)++;
+            prev = (prev + config->block_count - 1U) % config->block_count;
+        }
+    }
+
+    return tail;
+}
+
+/* Checks that a page holds one value throughout and that the value is one
+ * that an erase leaves. The first page checked sets the value for the rest.
+ */
+static bool _is_erased(const uint8_t *page, lfs_size_t size, int32_t *erased)
+{
+    bool result = (((int32_t)-1 == *erased) && ((0x00U == page[0]) || (0xFFU == page[0]))) ||
+                  ((int32_t)page[0] == *erased);
+
+    for(lfs_size_t i = 1U; result && (i < size); i++)
+    {
+        result = (page[i] == page[0]);
+    }
+    *erased = (int32_t)page[0];
+
+    return result;
+}
+
+/* Rebuilds the write position from the records of the last block. Writing
+ * continues on the page after the last valid record only if the rest of the
+ * block is still erased.
+ */
+static int32_t _recover_head(lfs_ring_log_t *log, lfs_block_t head)
+{
+    const lfs_ring_log_config_t *config = log->config;
+    lfs_size_t page_size = config->page_size;
+    lfs_off_t off = LFS_RING_LOG_BLOCK_HEADER_SIZE;
+    lfs_off_t end = off;
+    uint32_t count = 0U;
+    int32_t erased = -1;
+    bool clean = false;
+    int32_t res = 0;
+
+    while(0 == res)
+    {
+        lfs_size_t size = 0U;
+        uint16_t crc = 0U;
+        bool valid = false;
+
+        res = _record_at(log, head, &off, &size, &crc);
+        if(RECORD_FOUND == res)
+        {
+            res = _check_record(log, head, off, size, crc, &valid);
+            if((0 == res) && valid)
+            {
+                off += LFS_RING_LOG_RECORD_OVERHEAD + size;
+                end = off;
+                count++;
+            }
+            else if(0 == res)
+            {
+                res = RECORD_END;
+            }
+            else
+            {
+                /* A read error is returned. */
+            }
+        }
+        else if(RECORD_END == res)
+        {
+            clean = true;
+        }
+        else if(LFS_ERR_CORRUPT == res)
+        {
+            res = RECORD_END;
+        }
+        else
+        {
+            /* A read error is returned. */
+        }
+    }
+
+    if(RECORD_END == res)
+    {
+        lfs_off_t page_off = ((end + page_size) - 1U) - (((end + page_size) - 1U) % page_size);
+
+        res = 0;
+        for(lfs_off_t check = page_off; clean && (check < config->bd->block_size) && (0 == res);
+            check += page_size)
+        {
+            const uint8_t *page = NULL;
+
+            res = _load(log, head, check, &page);
+            clean = (0 == res) && _is_erased(page, page_size, &erased);
+        }
+
+        /* A block that cannot be continued is closed. */
+        log->page_off = clean ? page_off : config->bd->block_size;
+        log->write_off = log->page_off;
+        log->next_seq = config->index[head] + count;
+    }
+
+    return res;
+}
+
+int lfs_ring_log_open(lfs_ring_log_t *log, const lfs_ring_log_config_t *config)
+{
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->bd);
+    LFS_ASSERT(NULL != config->index);
+    LFS_ASSERT(NULL != config->buffer);
+    LFS_ASSERT(config->erase_ahead >= 1U);
+    LFS_ASSERT(config->block_count >= (config->erase_ahead + 2U));
+    LFS_ASSERT((config->first_block + config->block_count) <= config->bd->block_count);
+    LFS_ASSERT(config->page_size >= 16U);
+    LFS_ASSERT(0U == (config->page_size % config->bd->prog_size));
+    LFS_ASSERT(0U == (config->page_size % config->bd->read_size));
+    LFS_ASSERT(0U == (config->bd->block_size % config->page_size));
+
+    (void)memset(log, 0, sizeof(*log));
+    log->config = config;
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer config->buffer is cast to uint8_t* for byte-level access.');
+    log->page = (uint8_t *)config->buffer;
+    log->read_page = &log->page[config->page_size];
+    log->read_block = config->block_count;
+
+    /* The page being filled is not looked up while the headers are read. */
+    log->head = config->block_count;
+    (void)memset(log->page, PAD_BYTE, config->page_size);
+
+    _lock(log);
+
+    int32_t res = 0;
+    for(lfs_block_t block = 0U; (block < config->block_count) && (0 == res); block++)
+    {
+        uint8_t header[LFS_RING_LOG_BLOCK_HEADER_SIZE];
+
+        res = _read(log, block, 0U, header, sizeof(header));
+        config->index[block] = INDEX_INVALID;
+        if((0 == res) && (LFS_RING_LOG_MAGIC == _get_le32(&header[0U])) &&
+           (lfs_crc(0xFFFFFFFFUL, header, 8U) == _get_le32(&header[8U])))
+        {
+            config->index[block] = _get_le32(&header[4U]);
+        }
+    }
+
+    /* The last block written is the valid block that is not followed by a
+     * newer one.
+     */
+    lfs_block_t head = config->block_count;
+    for(lfs_block_t block = 0U; (block < config->block_count) && (head == config->block_count); block++)
+    {
+        uint32_t next_seq = config->index[_next(log, block)];
+
+        if((INDEX_INVALID != config->index[block]) &&
+           ((INDEX_INVALID == next_seq) || !_seq_before(config->index[block], next_seq)))
+        {
+            head = block;
+        }
+    }
+
+    if(0 == res)
+    {
+        if(head == config->block_count)
+        {
+            /* The first append moves to block 0. */
+            log->head = config->block_count - 1U;
+            log->page_off = config->bd->block_size;
+            log->write_off = log->page_off;
+        }
+        else
+        {
+            res = _recover_head(log, head);
+            log->head = head;
+        }
+    }
+
+    _unlock(log);
+
+    return res;
+}
+
+int lfs_ring_log_append(lfs_ring_log_t *log, const void *data, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(NULL != data);
+    LFS_ASSERT((0U != size) && (size <= RECORD_MAX_SIZE));
+    LFS_ASSERT(size <= (log->config->bd->block_size -
+                        (LFS_RING_LOG_BLOCK_HEADER_SIZE + LFS_RING_LOG_RECORD_OVERHEAD)));
+
+    const lfs_ring_log_config_t *config = log->config;
+    lfs_size_t page_size = config->page_size;
+    int32_t res = 0;
+
+    _lock(log);
+
+    lfs_off_t pos = log->write_off;
+
+    /* The record header starts on the next page if it does not fit in this
+     * one.
+     */
+    if(((log->page_off + page_size) - pos) < LFS_RING_LOG_RECORD_OVERHEAD)
+    {
+        pos = log->page_off + page_size;
+    }
+
+    if((log->page_off >= config->bd->block_size) ||
+       ((pos + LFS_RING_LOG_RECORD_OVERHEAD + size) > config->bd->block_size))
+    {
+        res = _next_block(log);
+    }
+    else if(pos != log->write_off)
+    {
+        log->write_off = pos;
+        res = _prog_page(log);
+    }
+    else
+    {
+        /* The record follows the previous one. */
+    }
+
+    if(0 == res)
+    {
+        uint8_t header[LFS_RING_LOG_RECORD_OVERHEAD];
+
+        header[0] = RECORD_TAG;
+        _put_le16(&header[RECORD_SIZE_OFF], (uint16_t)size);
+        _put_le16(&header[RECORD_CRC_OFF], _record_crc(header, data, size));
+        res = _put(log, header, sizeof(header));
+    }
+
+    if(0 == res)
+    {
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer data is cast to const uint8_t* for byte-level access.');
+        res = _put(log, (const uint8_t *)data, size);
+    }
+
+    if(0 == res)
+    {
+        log->next_seq++;
+    }
+
+    _unlock(log);
+
+    return res;
+}
+
+int lfs_ring_log_flush(lfs_ring_log_t *log)
+{
+    LFS_ASSERT(NULL != log);
+
+    const lfs_ring_log_config_t *config = log->config;
+    int32_t res = 0;
+
+    _lock(log);
+
+    if(log->write_off > log->page_off)
+    {
+        res = _prog_page(log);
+    }
+
+    if(0 == res)
+    {
+        res = config->bd->sync(config->bd);
+    }
+
+    _unlock(log);
+
+    return res;
+}
+
+int lfs_ring_log_maintain(lfs_ring_log_t *log)
+{
+    LFS_ASSERT(NULL != log);
+
+    const lfs_ring_log_config_t *config = log->config;
+    int32_t res = 0;
+
+    _lock(log);
+
+    if(log->erased_ahead < config->erase_ahead)
+    {
+        res = _erase_ahead(log);
+        log->maintain_erases++;
+    }
+
+    if(0 == res)
+    {
+        res = (int32_t)config->erase_ahead - (int32_t)log->erased_ahead;
+    }
+
+    _unlock(log);
+
+    return res;
+}
+
+static void _cursor_at_end(const lfs_ring_log_t *log, lfs_ring_log_cursor_t *cursor)
+{
+    cursor->seq = log->next_seq;
+    cursor->block = log->head;
+    cursor->block_seq = log->config->index[log->head];
+    cursor->off = log->write_off;
+}
+
+int lfs_ring_log_seek(lfs_ring_log_t *log, lfs_ring_log_cursor_t *cursor, uint32_t seq)
+{
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(NULL != cursor);
+
+    const lfs_ring_log_config_t *config = log->config;
+    lfs_block_t count = 0U;
+    int32_t res = 0;
+
+    _lock(log);
+
+    lfs_block_t tail = _tail(log, &count);
+    uint32_t first_seq = (0U != count) ? config->index[tail] : log->next_seq;
+
+    if(_seq_before(seq, first_seq))
+    {
+        seq = first_seq;
+    }
+
+    if(!_seq_before(seq, log->next_seq))
+    {
+        _cursor_at_end(log, cursor);
+    }
+    else
+    {
+        /* The last block that starts at or before the record */
+        lfs_block_t low = 0U;
+        lfs_block_t high = count - 1U;
+
+        while(low < high)
+        {
+            lfs_block_t mid = (low + high + 1U) / 2U;
+
+            if(_seq_before(seq, config->index[(tail + mid) % config->block_count]))
+            {
+                high = mid - 1U;
+            }
+            else
+            {
+                low = mid;
+            }
+        }
+
+        lfs_block_t block = (tail + low) % config->block_count;
+        lfs_off_t off = LFS_RING_LOG_BLOCK_HEADER_SIZE;
+        uint32_t at = config->index[block];
+
+        while((0 == res) && (at != seq))
+        {
+            lfs_size_t size = 0U;
+            uint16_t crc = 0U;
+
+            res = _record_at(log, block, &off, &size, &crc);
+            if(RECORD_FOUND == res)
+            {
+                off += LFS_RING_LOG_RECORD_OVERHEAD + size;
+                at++;
+            }
+            else if(RECORD_END == res)
+            {
+                res = LFS_ERR_CORRUPT;
+            }
+            else
+            {
+                /* An error is returned. */
+            }
+        }
+
+        if(0 == res)
+        {
+            cursor->seq = seq;
+            cursor->block = block;
+            cursor->block_seq = config->index[block];
+            cursor->off = off;
+        }
+    }
+
+    _unlock(log);
+
+    return res;
+}
+
+lfs_ssize_t lfs_ring_log_next(lfs_ring_log_t *log, lfs_ring_log_cursor_t *cursor, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(NULL != cursor);
+    LFS_ASSERT(NULL != buffer);
+
+    const lfs_ring_log_config_t *config = log->config;
+    lfs_size_t record_size = 0U;
+    uint16_t crc = 0U;
+    int32_t res = 0;
+
+    _lock(log);
+
+    if(cursor->seq == log->next_seq)
+    {
+        res = 0;
+    }
+    else if(config->index[cursor->block] != cursor->block_seq)
+    {
+        res = LFS_ERR_NOENT;
+    }
+    else
+    {
+        res = _record_at(log, cursor->block, &cursor->off, &record_size, &crc);
+
+        /* The records continue at the start of the next block. */
+        while(RECORD_END == res)
+        {
+            lfs_block_t block = _next(log, cursor->block);
+
+            if((cursor->block == log->head) || (config->index[block] != cursor->seq))
+            {
+                res = (cursor->block == log->head) ? LFS_ERR_CORRUPT : LFS_ERR_NOENT;
+            }
+            else
+            {
+                cursor->block = block;
+                cursor->block_seq = config->index[block];
+                cursor->off = LFS_RING_LOG_BLOCK_HEADER_SIZE;
+                res = _record_at(log, cursor->block, &cursor->off, &record_size, &crc);
+            }
+        }
+
+        if((RECORD_FOUND == res) && (record_size > size))
+        {
+            res = LFS_ERR_NOSPC;
+        }
+        else if(RECORD_FOUND == res)
+        {
+            uint8_t header[RECORD_CRC_OFF];
+
+            header[0] = RECORD_TAG;
+            _put_le16(&header[RECORD_SIZE_OFF], (uint16_t)record_size);
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer buffer is cast to uint8_t* for byte-level access.');
+            res = _read(log, cursor->block, cursor->off + LFS_RING_LOG_RECORD_OVERHEAD, (uint8_t *)buffer, record_size);
+            if((0 == res) && (_record_crc(header, buffer, record_size) != crc))
+            {
+                res = LFS_ERR_CORRUPT;
+            }
+            else if(0 == res)
+            {
+                cursor->off += LFS_RING_LOG_RECORD_OVERHEAD + record_size;
+                cursor->seq++;
+                res = (int32_t)record_size;
+            }
+            else
+            {
+                /* A read error is returned. */
+            }
+        }
+        else
+        {
+            /* An error is returned. */
+        }
+
+        if(LFS_ERR_CORRUPT == res)
+        {
+            /* The rest of the block cannot be trusted. */
+            lfs_block_t block = _next(log, cursor->block);
+
+            if((cursor->block != log->head) && (INDEX_INVALID != config->index[block]))
+            {
+                cursor->block = block;
+                cursor->block_seq = config->index[block];
+                cursor->seq = cursor->block_seq;
+                cursor->off = LFS_RING_LOG_BLOCK_HEADER_SIZE;
+            }
+            else
+            {
+                _cursor_at_end(log, cursor);
+            }
+        }
+    }
+
+    _unlock(log);
+
+    return res;
+}
+
+void lfs_ring_log_get_info(lfs_ring_log_t *log, lfs_ring_log_info_t *info)
+{
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(NULL != info);
+
+    lfs_block_t count = 0U;
+
+    _lock(log);
+
+    lfs_block_t tail = _tail(log, &count);
+
+    info->first_seq = (0U != count) ? log->config->index[tail] : log->next_seq;
+    info->next_seq = log->next_seq;
+    info->used_blocks = count;
+    info->erased_blocks = log->erased_ahead;
+    info->programmed_pages = log->programmed_pages;
+    info->append_erases = log->append_erases;
+    info->maintain_erases = log->maintain_erases;
+
+    _unlock(log);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
@@ -0,0 +1,566 @@
+/***************************************************************************//**
+ * \file lfs_rw.c
+ *
+ * \brief
+ * Implements a shared/exclusive access wrapper for the littlefs API that lets
+ * read-only operations run concurrently.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_rw.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions _reader_unlock and _reader_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',22,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',20,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define BINARY_SEMA_MAX_COUNT                       (1UL)
+#define BINARY_SEMA_INIT_COUNT                      (1UL)
+#define SYNC_OBJECT_COUNT                           (5UL)
+
+/* Arguments of the wrapped littlefs operations */
+typedef struct
+{
+    const char *path;
+    const char *new_path;
+    struct lfs_info *info;
+    void *buffer;
+    const void *data;
+    lfs_size_t size;
+    lfs_rw_dir_fn_t dir_fn;
+    void *dir_arg;
+} _op_args_t;
+
+static inline lfs_rw_t *_get_rw(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_rw_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_rw_t instance.');
+    return (lfs_rw_t *)(lfs_cfg->context);
+}
+
+static inline void _take(cy_semaphore_t *sema)
+{
+    cy_rslt_t result = cy_rtos_get_semaphore(sema, CY_RTOS_NEVER_TIMEOUT, false);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+static inline void _give(cy_semaphore_t *sema)
+{
+    cy_rslt_t result = cy_rtos_set_semaphore(sema, false);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+static inline void _lock(cy_mutex_t *mutex)
+{
+    cy_rslt_t result = cy_rtos_get_mutex(mutex, CY_RTOS_NEVER_TIMEOUT);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+static inline void _unlock(cy_mutex_t *mutex)
+{
+    cy_rslt_t result = cy_rtos_set_mutex(mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+/* The lock gives preference to writers: a waiting writer holds the turnstile,
+ * which new readers have to pass. The last reader to leave lets the writer
+ * into the room.
+ */
+static void _shared_lock(lfs_rw_t *rw)
+{
+    _take(&rw->turnstile);
+    _give(&rw->turnstile);
+
+    _lock(&rw->state_mutex);
+    rw->active_readers++;
+    if(1U == rw->active_readers)
+    {
+        _take(&rw->room_empty);
+    }
+    _unlock(&rw->state_mutex);
+}
+
+static void _shared_unlock(lfs_rw_t *rw)
+{
+    _lock(&rw->state_mutex);
+    rw->active_readers--;
+    if(0U == rw->active_readers)
+    {
+        _give(&rw->room_empty);
+    }
+    _unlock(&rw->state_mutex);
+}
+
+static void _exclusive_lock(lfs_rw_t *rw)
+{
+    _take(&rw->turnstile);
+    _take(&rw->room_empty);
+}
+
+static void _exclusive_unlock(lfs_rw_t *rw)
+{
+    _give(&rw->turnstile);
+    _give(&rw->room_empty);
+}
+
+/* Block device operations of the reader instances. The reads of concurrent
+ * readers are serialized here instead of around each littlefs call. Readers
+ * never program or erase.
+ */
+static int _reader_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    lfs_rw_t *rw = _get_rw(lfs_cfg);
+
+    _lock(&rw->device_mutex);
+    int32_t res = rw->cfg->read(rw->cfg, block, off, buffer, size);
+    _unlock(&rw->device_mutex);
+
+    return res;
+}
+
+static int _reader_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    CY_UNUSED_PARAMETER(block);
+    CY_UNUSED_PARAMETER(off);
+    CY_UNUSED_PARAMETER(buffer);
+    CY_UNUSED_PARAMETER(size);
+    LFS_ASSERT(false);
+    return LFS_ERR_IO;
+}
+
+static int _reader_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    CY_UNUSED_PARAMETER(block);
+    LFS_ASSERT(false);
+    return LFS_ERR_IO;
+}
+
+static int _reader_sync(const struct lfs_config *lfs_cfg)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    return LFS_ERR_OK;
+}
+
+#if defined(LFS_THREADSAFE)
+static int _reader_lock(const struct lfs_config *lfs_cfg)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    return LFS_ERR_OK;
+}
+
+static int _reader_unlock(const struct lfs_config *lfs_cfg)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    return LFS_ERR_OK;
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+/* Takes a free reader instance. The number of free instances is counted by
+ * the free_readers semaphore, so one is always found.
+ */
+static lfs_rw_reader_t *_acquire_reader(lfs_rw_t *rw)
+{
+    lfs_rw_reader_t *reader = NULL;
+
+    _take(&rw->free_readers);
+    _lock(&rw->state_mutex);
+    for(uint32_t i = 0U; (i < rw->reader_count) && (NULL == reader); i++)
+    {
+        if(!rw->readers[i].busy)
+        {
+            reader = &rw->readers[i];
+            reader->busy = true;
+        }
+    }
+    _unlock(&rw->state_mutex);
+
+    LFS_ASSERT(NULL != reader);
+    return reader;
+}
+
+static void _release_reader(lfs_rw_t *rw, lfs_rw_reader_t *reader)
+{
+    _lock(&rw->state_mutex);
+    reader->busy = false;
+    _unlock(&rw->state_mutex);
+    _give(&rw->free_readers);
+}
+
+/* Deletes the first created synchronization objects, in the reverse order of
+ * their creation in lfs_rw_mount().
+ */
+static void _deinit_sync(lfs_rw_t *rw, uint32_t created)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if(created > 4U)
+    {
+        result = cy_rtos_deinit_mutex(&rw->device_mutex);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    }
+    if(created > 3U)
+    {
+        result = cy_rtos_deinit_mutex(&rw->state_mutex);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    }
+    if(created > 2U)
+    {
+        result = cy_rtos_deinit_semaphore(&rw->free_readers);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    }
+    if(created > 1U)
+    {
+        result = cy_rtos_deinit_semaphore(&rw->room_empty);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    }
+    if(created > 0U)
+    {
+        result = cy_rtos_deinit_semaphore(&rw->turnstile);
+        LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    }
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+int lfs_rw_mount(lfs_rw_t *rw, const struct lfs_config *cfg,
+        lfs_rw_reader_t *readers, uint32_t reader_count)
+{
+    LFS_ASSERT(NULL != rw);
+    LFS_ASSERT(NULL != cfg);
+    LFS_ASSERT(NULL != readers);
+    LFS_ASSERT(0U != reader_count);
+
+    (void)memset(rw, 0, sizeof(*rw));
+    (void)memset(readers, 0, reader_count * sizeof(*readers));
+    rw->cfg = cfg;
+    rw->readers = readers;
+    rw->reader_count = reader_count;
+
+    /* The readers use the geometry and the tuning of the filesystem, their own
+     * buffers, and the block device operations above.
+     */
+    rw->reader_cfg = *cfg;
+    rw->reader_cfg.context          = rw;
+    rw->reader_cfg.read             = _reader_read;
+    rw->reader_cfg.prog             = _reader_prog;
+    rw->reader_cfg.erase            = _reader_erase;
+    rw->reader_cfg.sync             = _reader_sync;
+#if defined(LFS_THREADSAFE)
+    rw->reader_cfg.lock             = _reader_lock;
+    rw->reader_cfg.unlock           = _reader_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+    rw->reader_cfg.read_buffer      = NULL;
+    rw->reader_cfg.prog_buffer      = NULL;
+    rw->reader_cfg.lookahead_buffer = NULL;
+
+    uint32_t created = 0U;
+    cy_rslt_t result = cy_rtos_init_semaphore(&rw->turnstile, BINARY_SEMA_MAX_COUNT, BINARY_SEMA_INIT_COUNT);
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        result = cy_rtos_init_semaphore(&rw->room_empty, BINARY_SEMA_MAX_COUNT, BINARY_SEMA_INIT_COUNT);
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        result = cy_rtos_init_semaphore(&rw->free_readers, reader_count, reader_count);
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        result = cy_rtos_init_mutex(&rw->state_mutex);
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        result = cy_rtos_init_mutex(&rw->device_mutex);
+    }
+
+    int32_t err = LFS_ERR_IO;
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        created++;
+        err = lfs_mount(&rw->writer, cfg);
+    }
+
+    if(0 != err)
+    {
+        _deinit_sync(rw, created);
+    }
+
+    return err;
+}
+
+int lfs_rw_unmount(lfs_rw_t *rw)
+{
+    LFS_ASSERT(NULL != rw);
+
+    _exclusive_lock(rw);
+
+    for(uint32_t i = 0U; i < rw->reader_count; i++)
+    {
+        if(rw->readers[i].mounted)
+        {
+            (void)lfs_unmount(&rw->readers[i].lfs);
+            rw->readers[i].mounted = false;
+        }
+    }
+
+    int32_t err = lfs_unmount(&rw->writer);
+
+    _exclusive_unlock(rw);
+
+    _deinit_sync(rw, SYNC_OBJECT_COUNT);
+
+    return err;
+}
+
+int lfs_rw_shared(lfs_rw_t *rw, lfs_rw_fn_t fn, void *arg)
+{
+    LFS_ASSERT(NULL != rw);
+    LFS_ASSERT(NULL != fn);
+
+    int32_t err = LFS_ERR_OK;
+
+    _shared_lock(rw);
+    lfs_rw_reader_t *reader = _acquire_reader(rw);
+
+    /* The generation does not change while the shared lock is held. A reader
+     * instance mounted before the last modification is mounted again, because
+     * littlefs does not expect the filesystem to change under it.
+     */
+    if(!reader->mounted || (reader->generation != rw->generation))
+    {
+        if(reader->mounted)
+        {
+            (void)lfs_unmount(&reader->lfs);
+        }
+        err = lfs_mount(&reader->lfs, &rw->reader_cfg);
+        reader->mounted = (LFS_ERR_OK == err);
+        reader->generation = rw->generation;
+    }
+
+    if(LFS_ERR_OK == err)
+    {
+        err = fn(&reader->lfs, arg);
+    }
+
+    _release_reader(rw, reader);
+    _shared_unlock(rw);
+
+    return err;
+}
+
+int lfs_rw_exclusive(lfs_rw_t *rw, lfs_rw_fn_t fn, void *arg)
+{
+    LFS_ASSERT(NULL != rw);
+    LFS_ASSERT(NULL != fn);
+
+    _exclusive_lock(rw);
+    int32_t err = fn(&rw->writer, arg);
+    /* Counted even if the operation failed, as it may have modified the
+     * filesystem before failing.
+     */
+    rw->generation++;
+    _exclusive_unlock(rw);
+
+    return err;
+}
+
+static int _stat_fn(lfs_t *lfs, void *arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast to _op_args_t*. It is guaranteed that arg points to a valid _op_args_t instance.');
+    const _op_args_t *args = (const _op_args_t *)arg;
+    return lfs_stat(lfs, args->path, args->info);
+}
+
+int lfs_rw_stat(lfs_rw_t *rw, const char *path, struct lfs_info *info)
+{
+    _op_args_t args = { .path = path, .info = info };
+    return lfs_rw_shared(rw, _stat_fn, &args);
+}
+
+static int _read_file_fn(lfs_t *lfs, void *arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast to _op_args_t*. It is guaranteed that arg points to a valid _op_args_t instance.');
+    const _op_args_t *args = (const _op_args_t *)arg;
+    lfs_file_t file;
+
+    int32_t err = lfs_file_open(lfs, &file, args->path, LFS_O_RDONLY);
+    if(LFS_ERR_OK == err)
+    {
+        lfs_ssize_t read = lfs_file_read(lfs, &file, args->buffer, args->size);
+        err = lfs_file_close(lfs, &file);
+        err = (read < 0) ? (int32_t)read : ((LFS_ERR_OK == err) ? (int32_t)read : err);
+    }
+
+    return err;
+}
+
+lfs_ssize_t lfs_rw_read_file(lfs_rw_t *rw, const char *path, void *buffer, lfs_size_t size)
+{
+    _op_args_t args = { .path = path, .buffer = buffer, .size = size };
+    return lfs_rw_shared(rw, _read_file_fn, &args);
+}
+
+static int _dir_foreach_fn(lfs_t *lfs, void *arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast to _op_args_t*. It is guaranteed that arg points to a valid _op_args_t instance.');
+    const _op_args_t *args = (const _op_args_t *)arg;
+    lfs_dir_t dir;
+    struct lfs_info info;
+
+    int32_t err = lfs_dir_open(lfs, &dir, args->path);
+    if(LFS_ERR_OK == err)
+    {
+        int32_t res = lfs_dir_read(lfs, &dir, &info);
+        while(res > 0)
+        {
+            res = args->dir_fn(&info, args->dir_arg);
+            if(0 == res)
+            {
+                res = lfs_dir_read(lfs, &dir, &info);
+            }
+        }
+
+        err = lfs_dir_close(lfs, &dir);
+        err = (0 != res) ? res : err;
+    }
+
+    return err;
+}
+
+int lfs_rw_dir_foreach(lfs_rw_t *rw, const char *path, lfs_rw_dir_fn_t fn, void *arg)
+{
+    LFS_ASSERT(NULL != fn);
+
+    _op_args_t args = { .path = path, .dir_fn = fn, .dir_arg = arg };
+    return lfs_rw_shared(rw, _dir_foreach_fn, &args);
+}
+
+static int _write_file_fn(lfs_t *lfs, void *arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast to _op_args_t*. It is guaranteed that arg points to a valid _op_args_t instance.');
+    const _op_args_t *args = (const _op_args_t *)arg;
+    lfs_file_t file;
+
+    int32_t err = lfs_file_open(lfs, &file, args->path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+    if(LFS_ERR_OK == err)
+    {
+        lfs_ssize_t written = lfs_file_write(lfs, &file, args->data, args->size);
+        err = lfs_file_close(lfs, &file);
+        err = (written < 0) ? (int32_t)written : ((LFS_ERR_OK == err) ? (int32_t)written : err);
+    }
+
+    return err;
+}
+
+lfs_ssize_t lfs_rw_write_file(lfs_rw_t *rw, const char *path, const void *data, lfs_size_t size)
+{
+    _op_args_t args = { .path = path, .data = data, .size = size };
+    return lfs_rw_exclusive(rw, _write_file_fn, &args);
+}
+
+static int _remove_fn(lfs_t *lfs, void *arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast to _op_args_t*. It is guaranteed that arg points to a valid _op_args_t instance.');
+    const _op_args_t *args = (const _op_args_t *)arg;
+    return lfs_remove(lfs, args->path);
+}
+
+int lfs_rw_remove(lfs_rw_t *rw, const char *path)
+{
+    _op_args_t args = { .path = path };
+    return lfs_rw_exclusive(rw, _remove_fn, &args);
+}
+
+static int _rename_fn(lfs_t *lfs, void *arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast to _op_args_t*. It is guaranteed that arg points to a valid _op_args_t instance.');
+    const _op_args_t *args = (const _op_args_t *)arg;
+    return lfs_rename(lfs, args->path, args->new_path);
+}
+
+int lfs_rw_rename(lfs_rw_t *rw, const char *old_path, const char *new_path)
+{
+    _op_args_t args = { .path = old_path, .new_path = new_path };
+    return lfs_rw_exclusive(rw, _rename_fn, &args);
+}
+
+static int _mkdir_fn(lfs_t *lfs, void *arg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast to _op_args_t*. It is guaranteed that arg points to a valid _op_args_t instance.');
+    const _op_args_t *args = (const _op_args_t *)arg;
+    return lfs_mkdir(lfs, args->path);
+}
+
+int lfs_rw_mkdir(lfs_rw_t *rw, const char *path)
+{
+    _op_args_t args = { .path = path };
+    return lfs_rw_exclusive(rw, _mkdir_fn, &args);
+}
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
@@ -71,8 +71,6 @@ extern "C"
 #define RESULT_ERROR                        (-1)
 #define GET_INT_RETURN_VALUE(result)        ((CY_RSLT_SUCCESS == (result)) ? RESULT_OK : RESULT_ERROR)
 
-#define LFS_CFG_LOOKAHEAD_SIZE_MIN          (64UL)    /* Must be a multiple of 8 */
-#define SDHC_BLOCK_SIZE                     (512UL)
 #define ONE_BLOCK                           (1U)
 
 #if defined(LFS_THREADSAFE)
@@ -126,38 +124,12 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
 #endif /* #if defined(LFS_THREADSAFE) */
 
         /* Block device configuration */
-        lfs_cfg->read_size   = SDHC_BLOCK_SIZE;
-        lfs_cfg->prog_size   = SDHC_BLOCK_SIZE;
-        lfs_cfg->block_size  = SDHC_BLOCK_SIZE;
+        uint32_t block_count = 0U;
 
-        result = mtb_hal_sdhc_get_block_count((mtb_hal_sdhc_t *) sdhc_obj, (uint32_t *) &lfs_cfg->block_count);
+        result = mtb_hal_sdhc_get_block_count((mtb_hal_sdhc_t *) sdhc_obj, &block_count);
         if(CY_RSLT_SUCCESS == result)
         {
-            /* Refer to lfs.h for the description of the following parameters. */
-
-            /* Set to -1 to disable wear leveling as the controller in the
-             * SD card may be handling wear leveling.
-             */
-            lfs_cfg->block_cycles = -1;
-
-            /* cache_size must be a multiple of prog & read sizes.
-             * i.e., cache_size % prog_size = 0 and cache_size % read_size = 0
-             * block_size must be a multiple of cache_size. i.e., block_size % cache_size = 0.
-             *
-             * littlefs allocates 1 cache for each file and 2 caches for
-             * internal operations.
-             * The higher the cache size, the better the performance is, but the
-             * RAM consumption is also higher.
-             */
-            lfs_cfg->cache_size = SDHC_BLOCK_SIZE;
-
-            /* A larger Lookahead size reduces the number of scans performed by
-             * the block allocation algorithm thus increasing the filesystem
-             * performance but results in higher RAM consumption.
-             *
-             * Must be a multiple of 8.
-             */
-            lfs_cfg->lookahead_size = lfs_min((lfs_size_t) LFS_CFG_LOOKAHEAD_SIZE_MIN, 8UL * ((lfs_cfg->block_count + 63UL)/64UL) );
+            lfs_sd_bd_set_geometry(lfs_cfg, block_count);
         }
 #if defined(LFS_THREADSAFE)
     }
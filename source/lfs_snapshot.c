@@ -0,0 +1,241 @@
+/***************************************************************************//**
+ * \file lfs_snapshot.c
+ *
+ * \brief
+ * Implements a block-level backup of a mounted filesystem that streams only
+ * the blocks in use.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_snapshot.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+/* This block of code ignores violations of Directive 4.6 MISRA. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',2,\
+'The third-party defines the function interface with basic numeral type')
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+/* State of an export. */
+typedef struct
+{
+    const lfs_snapshot_config_t *config;
+    lfs_block_t block_count;
+    uint32_t crc;
+    lfs_snapshot_stats_t stats;
+} _export_t;
+
+static inline bool _test(const uint8_t *map, lfs_block_t block)
+{
+    return (0U != (map[block / 8U] & (uint8_t)(1U << (block % 8U))));
+}
+
+static inline void _put_le32(uint8_t *p, uint32_t value)
+{
+    uint32_t le = lfs_tole32(value);
+    (void)memcpy(p, &le, sizeof(le));
+}
+
+static int _mark_in_use(void *data, lfs_block_t block)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer data is cast to _export_t*. It is guaranteed that data points to a valid _export_t instance.');
+    _export_t *exp = (_export_t *)data;
+
+    /* littlefs reports some blocks more than once. */
+    if((block < exp->block_count) && !_test(exp->config->bitmap, block))
+    {
+        exp->config->bitmap[block / 8U] |= (uint8_t)(1U << (block % 8U));
+        exp->stats.used_blocks++;
+    }
+
+    return 0;
+}
+
+static int32_t _emit(_export_t *exp, const void *data, lfs_size_t size)
+{
+    exp->crc = lfs_crc(exp->crc, data, size);
+    exp->stats.stream_bytes += size;
+
+    return exp->config->sink(exp->config->sink_context, data, size);
+}
+
+static int32_t _emit_words(_export_t *exp, uint32_t first, uint32_t second)
+{
+    uint8_t words[2U * sizeof(uint32_t)];
+
+    _put_le32(&words[0], first);
+    _put_le32(&words[sizeof(uint32_t)], second);
+
+    return _emit(exp, words, sizeof(words));
+}
+
+/* Streams a run of blocks in use. The blocks are read in pieces of up to a
+ * block, and the buffer is passed to the sink each time it is full.
+ */
+static int32_t _export_run(_export_t *exp, const struct lfs_config *lfs_cfg,
+        lfs_block_t first, lfs_block_t count)
+{
+    const lfs_snapshot_config_t *config = exp->config;
+    lfs_size_t fill = 0U;
+    int32_t res = _emit_words(exp, first, count);
+
+    for(lfs_block_t block = first; (block < (first + count)) && (0 == res); block++)
+    {
+        lfs_off_t off = 0U;
+
+        while((off < lfs_cfg->block_size) && (0 == res))
+        {
+            lfs_size_t size = lfs_min(lfs_cfg->block_size - off, config->buffer_size - fill);
+
+            res = lfs_cfg->read(lfs_cfg, block, off, &config->buffer[fill], size);
+            off += size;
+            fill += size;
+
+            if((0 == res) && (fill == config->buffer_size))
+            {
+                res = _emit(exp, config->buffer, fill);
+                fill = 0U;
+            }
+        }
+    }
+
+    if((0 == res) && (0U != fill))
+    {
+        res = _emit(exp, config->buffer, fill);
+    }
+
+    return res;
+}
+
+int lfs_snapshot_export(lfs_t *lfs, const struct lfs_config *lfs_cfg,
+        const lfs_snapshot_config_t *config, lfs_snapshot_stats_t *stats)
+{
+    LFS_ASSERT(NULL != lfs);
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->bitmap);
+    LFS_ASSERT(NULL != config->buffer);
+    LFS_ASSERT(NULL != config->sink);
+    LFS_ASSERT((0U != config->buffer_size) && (0U == (config->buffer_size % lfs_cfg->read_size)));
+
+    _export_t exp;
+    int32_t res = 0;
+
+    (void)memset(&exp, 0, sizeof(exp));
+    exp.config = config;
+    exp.block_count = lfs_cfg->block_count;
+    exp.crc = 0xFFFFFFFFUL;
+    (void)memset(config->bitmap, 0, LFS_SNAPSHOT_BITMAP_SIZE(lfs_cfg->block_count));
+
+#if defined(LFS_THREADSAFE)
+    /* The filesystem must not change between the traversal and the reads. */
+    res = lfs_cfg->lock(lfs_cfg);
+    if(0 == res)
+    {
+#endif /* #if defined(LFS_THREADSAFE) */
+        res = lfs_fs_traverse(lfs, _mark_in_use, &exp);
+
+        if(0 == res)
+        {
+            uint8_t header[LFS_SNAPSHOT_HEADER_SIZE];
+
+            _put_le32(&header[0U], LFS_SNAPSHOT_MAGIC);
+            _put_le32(&header[4U], LFS_SNAPSHOT_VERSION);
+            _put_le32(&header[8U], lfs_cfg->block_size);
+            _put_le32(&header[12U], lfs_cfg->block_count);
+            _put_le32(&header[16U], exp.stats.used_blocks);
+            res = _emit(&exp, header, sizeof(header));
+        }
+
+        lfs_block_t block = 0U;
+        while((block < lfs_cfg->block_count) && (0 == res))
+        {
+            if(_test(config->bitmap, block))
+            {
+                lfs_block_t first = block;
+
+                while((block < lfs_cfg->block_count) && _test(config->bitmap, block))
+                {
+                    block++;
+                }
+
+                res = _export_run(&exp, lfs_cfg, first, block - first);
+                exp.stats.runs++;
+            }
+            else
+            {
+                block++;
+            }
+        }
+
+        if(0 == res)
+        {
+            uint8_t crc[sizeof(uint32_t)];
+            uint8_t end[sizeof(uint32_t)];
+
+            _put_le32(end, LFS_SNAPSHOT_END);
+            res = _emit(&exp, end, sizeof(end));
+
+            /* The CRC covers everything before it. */
+            _put_le32(crc, exp.crc);
+            if(0 == res)
+            {
+                res = _emit(&exp, crc, sizeof(crc));
+            }
+        }
+
+#if defined(LFS_THREADSAFE)
+        (void)lfs_cfg->unlock(lfs_cfg);
+    }
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    if(NULL != stats)
+    {
+        *stats = exp.stats;
+    }
+
+    return res;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
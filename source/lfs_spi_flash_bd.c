@@ -48,6 +48,7 @@
 #include "lfs_spi_flash_bd.h"
 #include "lfs_util.h"
 #include "mtb_serial_memory.h"
+#include <string.h>
 
 #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
 #include "cyabs_rtos.h"
@@ -76,11 +77,6 @@ extern "C"
 #define GET_INT_RETURN_VALUE(result)                ((CY_RSLT_SUCCESS == (result)) ? RESULT_OK : RESULT_ERROR)
 
 #define DEFAULT_QSPI_FREQUENCY_HZ                   (50000000UL)
-#define QSPI_MIN_READ_SIZE                          (1UL)
-
-/* Recommended value as per the comment in lfs.c is in the range of 100-1000. */
-#define LFS_CFG_DEFAULT_BLOCK_CYCLES                (512)
-#define LFS_CFG_LOOKAHEAD_SIZE_MIN                  (64UL) /* Must be a multiple of 8. */
 
 #if (ASYNC_TRANSFER_IS_ENABLED) == 1U
 #define QSPI_READ_SEMA_MAX_COUNT                    (1UL)
@@ -116,21 +112,291 @@ CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer arg is cast t
 static cy_mutex_t _spi_flash_bd_mutex;
 #endif /* #if defined(LFS_THREADSAFE) */
 
+#if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY)
+/* The geometry is known at compile time, so the address of a block folds into
+ * a constant offset and a shift.
+ */
+#define BLOCK_ADDRESS(lfs_cfg, block)               \
+    (LFS_SPI_FLASH_BD_FIXED_ADDRESS_START + ((block) * LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE))
+#define BLOCK_SIZE(lfs_cfg)                         (LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE)
+#else
 /* The static variable to safe the memory configuration */
 static uint32_t lfs_spi_flash_address_start = 0U;
 static uint32_t lfs_spi_flash_region_size = 0U;
 static bool lfs_spi_flash_en_custom_config = false;
 
+#define BLOCK_ADDRESS(lfs_cfg, block)               \
+    (lfs_spi_flash_address_start + ((block) * (lfs_cfg)->block_size))
+#define BLOCK_SIZE(lfs_cfg)                         ((lfs_cfg)->block_size)
+#endif /* #if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY) */
+
+/* The static variables of the optional read cache */
+#define READ_CACHE_TAG_INVALID                      (0xFFFFFFFFUL)
+
+static uint32_t *lfs_spi_flash_read_cache_tags = NULL;
+static uint8_t *lfs_spi_flash_read_cache_lines = NULL;
+static uint32_t lfs_spi_flash_read_cache_line_size = 0U;
+static uint32_t lfs_spi_flash_read_cache_set_count = 0U;
+static lfs_spi_flash_bd_read_cache_stats_t lfs_spi_flash_read_cache_stats;
+
+static cy_rslt_t _read_memory(mtb_serial_memory_t *serial_memory_obj, uint32_t addr, uint32_t size, uint8_t *buffer);
+
+#if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH)
+/* The static variables of the optional erase wait */
+#define ERASE_WAIT_MAX_ADDR_BYTES                   (4UL)
+#define ERASE_WAIT_RSLT_ERR_COMMAND                 \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0300U))
+#define ERASE_WAIT_RSLT_ERR_TIMEOUT                 \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x0301U))
+
+static SMIF_Type *lfs_spi_flash_erase_wait_base = NULL;
+static cy_stc_smif_mem_config_t *lfs_spi_flash_erase_wait_mem_config = NULL;
+static cy_stc_smif_context_t *lfs_spi_flash_erase_wait_context = NULL;
+static lfs_spi_flash_bd_wait_fn_t lfs_spi_flash_erase_wait_fn = NULL;
+
+#if defined(COMPONENT_RTOS_AWARE)
+static void _rtos_wait(uint32_t delay_ms)
+{
+    cy_rslt_t result = cy_rtos_delay_milliseconds(delay_ms);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+#endif /* #if defined(COMPONENT_RTOS_AWARE) */
+#endif /* #if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH) */
+
 
 void lfs_spi_flash_bd_configure_memory(const struct lfs_config *lfs_cfg, uint32_t address, uint32_t region_size)
 {
     CY_UNUSED_PARAMETER(lfs_cfg);
+#if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY)
+    /* The region is fixed at compile time. */
+    LFS_ASSERT(LFS_SPI_FLASH_BD_FIXED_ADDRESS_START == address);
+    LFS_ASSERT((LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE * LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT) == region_size);
+    CY_UNUSED_PARAMETER(address);
+    CY_UNUSED_PARAMETER(region_size);
+#else
     lfs_spi_flash_en_custom_config = true;
 
     /* Save the address and region size to use during configuration
      * in lfs_spi_flash_bd_create */
     lfs_spi_flash_address_start = address;
     lfs_spi_flash_region_size = region_size;
+#endif /* #if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY) */
+}
+
+void lfs_spi_flash_bd_configure_read_cache(const struct lfs_config *lfs_cfg, void *buffer,
+        uint32_t line_size, uint32_t set_count)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((0U != line_size) && (0U == (line_size & (line_size - 1U))));
+    LFS_ASSERT(0U != set_count);
+
+    /* The tags are stored at the start of the buffer, followed by the lines. */
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer buffer is cast to uint32_t*. It is guaranteed that buffer is word-aligned.');
+    lfs_spi_flash_read_cache_tags = (uint32_t *)buffer;
+    lfs_spi_flash_read_cache_lines = (uint8_t *)&lfs_spi_flash_read_cache_tags[set_count];
+    lfs_spi_flash_read_cache_line_size = line_size;
+    lfs_spi_flash_read_cache_set_count = set_count;
+
+    for(uint32_t set = 0U; set < set_count; set++)
+    {
+        lfs_spi_flash_read_cache_tags[set] = READ_CACHE_TAG_INVALID;
+    }
+    (void)memset(&lfs_spi_flash_read_cache_stats, 0, sizeof(lfs_spi_flash_read_cache_stats));
+}
+
+void lfs_spi_flash_bd_get_read_cache_stats(const struct lfs_config *lfs_cfg,
+        lfs_spi_flash_bd_read_cache_stats_t *stats)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+
+    *stats = lfs_spi_flash_read_cache_stats;
+    stats->commands_saved = (stats->requests > stats->misses) ? (stats->requests - stats->misses) : 0U;
+}
+
+#if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH)
+void lfs_spi_flash_bd_configure_erase_wait(const struct lfs_config *lfs_cfg, SMIF_Type *base,
+        cy_stc_smif_mem_config_t *mem_config, cy_stc_smif_context_t *context,
+        lfs_spi_flash_bd_wait_fn_t wait)
+{
+    CY_UNUSED_PARAMETER(lfs_cfg);
+    LFS_ASSERT(NULL != base);
+    LFS_ASSERT(NULL != mem_config);
+    LFS_ASSERT(NULL != context);
+    LFS_ASSERT(mem_config->deviceCfg->numOfAddrBytes <= ERASE_WAIT_MAX_ADDR_BYTES);
+
+#if defined(COMPONENT_RTOS_AWARE)
+    if(NULL == wait)
+    {
+        wait = _rtos_wait;
+    }
+#endif /* #if defined(COMPONENT_RTOS_AWARE) */
+    LFS_ASSERT(NULL != wait);
+
+    lfs_spi_flash_erase_wait_base = base;
+    lfs_spi_flash_erase_wait_mem_config = mem_config;
+    lfs_spi_flash_erase_wait_context = context;
+    lfs_spi_flash_erase_wait_fn = wait;
+}
+
+/* Erases one sector with SMIF commands. The first status poll happens after a
+ * fraction of the maximum erase time, and the following polls are spaced by a
+ * smaller fraction. The wait function runs in between, so the calling thread
+ * does not keep the CPU busy.
+ */
+static cy_rslt_t _erase_with_wait(uint32_t addr)
+{
+    SMIF_Type *base = lfs_spi_flash_erase_wait_base;
+    cy_stc_smif_mem_config_t *mem_config = lfs_spi_flash_erase_wait_mem_config;
+    const cy_stc_smif_context_t *context = lfs_spi_flash_erase_wait_context;
+    uint32_t addr_bytes_count = mem_config->deviceCfg->numOfAddrBytes;
+    uint32_t erase_time = mem_config->deviceCfg->eraseTime;
+    uint8_t addr_bytes[ERASE_WAIT_MAX_ADDR_BYTES];
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    /* The address is sent most significant byte first. */
+    for(uint32_t i = 0U; i < addr_bytes_count; i++)
+    {
+        addr_bytes[i] = (uint8_t)(addr >> (8U * (addr_bytes_count - 1U - i)));
+    }
+
+    if((CY_SMIF_SUCCESS != Cy_SMIF_MemCmdWriteEnable(base, mem_config, context)) ||
+       (CY_SMIF_SUCCESS != Cy_SMIF_MemCmdSectorErase(base, mem_config, addr_bytes, context)))
+    {
+        result = ERASE_WAIT_RSLT_ERR_COMMAND;
+    }
+    else
+    {
+        uint32_t delay = lfs_max(1UL, erase_time / LFS_SPI_FLASH_BD_ERASE_WAIT_FIRST_DIVISOR);
+        uint32_t poll_delay = lfs_max(1UL, erase_time / LFS_SPI_FLASH_BD_ERASE_WAIT_POLL_DIVISOR);
+        uint32_t waited = 0U;
+
+        do
+        {
+            /* The maximum erase time from SFDP already has a margin; allow
+             * twice that before giving up.
+             */
+            if(waited > (2U * erase_time))
+            {
+                result = ERASE_WAIT_RSLT_ERR_TIMEOUT;
+            }
+            else
+            {
+                lfs_spi_flash_erase_wait_fn(delay);
+                waited += delay;
+                delay = poll_delay;
+            }
+        } while((CY_RSLT_SUCCESS == result) && Cy_SMIF_MemIsBusy(base, mem_config, context));
+    }
+
+    return result;
+}
+
+/* Checks whether a block can be erased with SMIF commands. The commands do not
+ * go through serial-flash, which does not expose its lock, so they are only
+ * issued when the SMIF block is in command mode and no transfer is in
+ * progress. Otherwise the block is erased through serial-flash.
+ */
+static bool _can_erase_with_wait(uint32_t size)
+{
+    bool can_erase = false;
+
+    if(NULL != lfs_spi_flash_erase_wait_base)
+    {
+        const cy_stc_smif_mem_device_cfg_t *device_cfg = lfs_spi_flash_erase_wait_mem_config->deviceCfg;
+
+        can_erase = (size == device_cfg->eraseSize) && (0U != device_cfg->eraseTime) &&
+                    (CY_SMIF_NORMAL == Cy_SMIF_GetMode(lfs_spi_flash_erase_wait_base)) &&
+                    !Cy_SMIF_BusyCheck(lfs_spi_flash_erase_wait_base);
+    }
+
+    return can_erase;
+}
+#endif /* #if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH) */
+
+static cy_rslt_t _erase_block(mtb_serial_memory_t *serial_memory_obj, uint32_t addr, uint32_t size)
+{
+    cy_rslt_t result;
+
+#if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH)
+    if(_can_erase_with_wait(size))
+    {
+        result = _erase_with_wait(addr);
+    }
+    else
+#endif /* #if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH) */
+    {
+        result = mtb_serial_memory_erase(serial_memory_obj, addr, size);
+    }
+
+    return result;
+}
+
+/* Serves a read smaller than a line from the read cache. Lines are aligned to
+ * the line size, which divides the block size, so a line never spans two
+ * blocks.
+ */
+static cy_rslt_t _read_cached(mtb_serial_memory_t *serial_memory_obj, uint32_t addr, uint32_t size, uint8_t *buffer)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t line_size = lfs_spi_flash_read_cache_line_size;
+
+    lfs_spi_flash_read_cache_stats.requests++;
+
+    while((CY_RSLT_SUCCESS == result) && (0U < size))
+    {
+        uint32_t line_addr = addr & ~(line_size - 1U);
+        uint32_t set = (line_addr / line_size) % lfs_spi_flash_read_cache_set_count;
+        uint8_t *line = &lfs_spi_flash_read_cache_lines[set * line_size];
+
+        if(line_addr != lfs_spi_flash_read_cache_tags[set])
+        {
+            lfs_spi_flash_read_cache_stats.misses++;
+            lfs_spi_flash_read_cache_tags[set] = READ_CACHE_TAG_INVALID;
+            result = _read_memory(serial_memory_obj, line_addr, line_size, line);
+            if(CY_RSLT_SUCCESS == result)
+            {
+                lfs_spi_flash_read_cache_tags[set] = line_addr;
+            }
+        }
+        else
+        {
+            lfs_spi_flash_read_cache_stats.hits++;
+        }
+
+        if(CY_RSLT_SUCCESS == result)
+        {
+            uint32_t chunk = lfs_min(size, (line_addr + line_size) - addr);
+            (void)memcpy(buffer, &line[addr - line_addr], chunk);
+            buffer = &buffer[chunk];
+            addr += chunk;
+            size -= chunk;
+        }
+    }
+
+    return result;
+}
+
+/* Invalidates the cached lines that overlap a programmed or erased range. The
+ * lines are not updated in place: littlefs reads programmed data back to
+ * verify it, and that read must reach the memory.
+ */
+static void _invalidate_cached(uint32_t addr, uint32_t size)
+{
+    uint32_t line_size = lfs_spi_flash_read_cache_line_size;
+
+    for(uint32_t set = 0U; set < lfs_spi_flash_read_cache_set_count; set++)
+    {
+        uint32_t tag = lfs_spi_flash_read_cache_tags[set];
+
+        if((READ_CACHE_TAG_INVALID != tag) && (tag < (addr + size)) && ((tag + line_size) > addr))
+        {
+            lfs_spi_flash_read_cache_tags[set] = READ_CACHE_TAG_INVALID;
+            lfs_spi_flash_read_cache_stats.invalidations++;
+        }
+    }
 }
 
 cy_rslt_t lfs_spi_flash_bd_create(struct lfs_config *lfs_cfg, mtb_serial_memory_t *serial_memory_obj)
@@ -173,42 +439,31 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
         * block. Also, if the hybrid memory is used, these parameters are
         * found for the first provided block (configured by lfs_spi_flash_bd_configure_memory()).
         */
-    lfs_cfg->read_size   = QSPI_MIN_READ_SIZE;
-    lfs_cfg->prog_size   = mtb_serial_memory_get_prog_size(serial_memory_obj, lfs_spi_flash_en_custom_config ?
-                                                                lfs_spi_flash_address_start : 0U);
-    lfs_cfg->block_size  = mtb_serial_memory_get_erase_size(serial_memory_obj, lfs_spi_flash_en_custom_config ?
-                                                                lfs_spi_flash_address_start : 0U);
-    lfs_cfg->block_count = (lfs_spi_flash_en_custom_config ? lfs_spi_flash_region_size :
-                            mtb_serial_memory_get_size(serial_memory_obj)) / lfs_cfg->block_size;
-
-    /* Refer to lfs.h for the description of the following parameters: */
-
-    /* The number of erase cycles before data is moved to a new block.
-        * A larger value results in more efficient filesystem performance, but
-        * causes less even-wear distribution.
-        *
-        * Setting this to -1 disables dynamic wear leveling.
-        */
-    lfs_cfg->block_cycles = LFS_CFG_DEFAULT_BLOCK_CYCLES;
-
-    /* cache_size must be a multiple of prog & read sizes.
-        * i.e., cache_size % prog_size = 0 and cache_size % read_size = 0
-        * block_size must be a multiple of cache_size. i.e., block_size % cache_size = 0.
-        *
-        * littlefs allocates 1 cache for each file and 2 caches for
-        * internal operations.
-        * The higher the cache size, the better the performance is, but the
-        * RAM consumption is also higher.
-        */
-    lfs_cfg->cache_size = lfs_cfg->prog_size;
+#if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY)
+    /* The memory is not queried. Debug builds check that the fixed geometry
+     * matches the discovered one.
+     */
+    lfs_spi_flash_bd_set_geometry(lfs_cfg, LFS_SPI_FLASH_BD_FIXED_PROG_SIZE,
+                                  LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE, LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT);
+
+    LFS_ASSERT(mtb_serial_memory_get_prog_size(serial_memory_obj, LFS_SPI_FLASH_BD_FIXED_ADDRESS_START) ==
+               LFS_SPI_FLASH_BD_FIXED_PROG_SIZE);
+    LFS_ASSERT(mtb_serial_memory_get_erase_size(serial_memory_obj, LFS_SPI_FLASH_BD_FIXED_ADDRESS_START) ==
+               LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE);
+    LFS_ASSERT(mtb_serial_memory_get_size(serial_memory_obj) >= (LFS_SPI_FLASH_BD_FIXED_ADDRESS_START +
+               (LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE * LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT)));
+#else
+    uint32_t address = lfs_spi_flash_en_custom_config ? lfs_spi_flash_address_start : 0U;
+    uint32_t block_size = mtb_serial_memory_get_erase_size(serial_memory_obj, address);
 
-    /* A larger Lookahead size reduces the number of scans performed by
-        * the block allocation algorithm thus increasing the filesystem
-        * performance, but results in higher RAM consumption.
-        *
-        * Must be a multiple of 8.
-        */
-    lfs_cfg->lookahead_size = lfs_min((lfs_size_t) LFS_CFG_LOOKAHEAD_SIZE_MIN, 8UL * ((lfs_cfg->block_count + 63UL)/64UL) );
+    lfs_spi_flash_bd_set_geometry(lfs_cfg, mtb_serial_memory_get_prog_size(serial_memory_obj, address),
+                                  block_size, (lfs_spi_flash_en_custom_config ? lfs_spi_flash_region_size :
+                                  mtb_serial_memory_get_size(serial_memory_obj)) / block_size);
+#endif /* #if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY) */
+
+    /* A cache line must not span two blocks. */
+    LFS_ASSERT((NULL == lfs_spi_flash_read_cache_tags) ||
+               (0U == (lfs_cfg->block_size % lfs_spi_flash_read_cache_line_size)));
 
 #if (ASYNC_TRANSFER_IS_ENABLED) == 1U
     result = cy_rtos_init_semaphore(&qspi_read_sema, QSPI_READ_SEMA_MAX_COUNT, QSPI_READ_SEMA_INIT_COUNT);
@@ -239,7 +494,14 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
      */
 
     /* Forget the settings of the custom configuration of the memory module */
+#if !defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY)
     lfs_spi_flash_en_custom_config = false;
+#endif /* #if !defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY) */
+    lfs_spi_flash_read_cache_tags = NULL;
+    lfs_spi_flash_read_cache_set_count = 0U;
+#if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH)
+    lfs_spi_flash_erase_wait_base = NULL;
+#endif /* #if !defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH) */
 
 #if (ASYNC_TRANSFER_IS_ENABLED) == 1U
     result = cy_rtos_deinit_semaphore(&qspi_read_sema);
@@ -259,6 +521,37 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
     CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
 }
 
+static cy_rslt_t _read_memory(mtb_serial_memory_t *serial_memory_obj, uint32_t addr, uint32_t size, uint8_t *buffer)
+{
+    cy_rslt_t result;
+
+#if (ASYNC_TRANSFER_IS_ENABLED) == 1U
+    cy_rslt_t qspi_read_status = CY_RSLT_SUCCESS;
+
+    /* Disable interrupts to ensure interrupt occurs only when we are ready to
+     * get the semaphore.
+     */
+    uint32_t saved_intr_status = mtb_hal_system_critical_section_enter();
+    result = mtb_serial_memory_read_async(serial_memory_obj, addr, size, buffer, qspi_read_complete_callback, (void *)&qspi_read_status);
+    mtb_hal_system_critical_section_exit(saved_intr_status);
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        /* Wait until the read semaphore is set. */
+        result = cy_rtos_get_semaphore(&qspi_read_sema, LFS_SPI_FLASH_BD_ASYNC_READ_TIMEOUT_MS, false);
+
+        if(CY_RSLT_SUCCESS == result)
+        {
+            result = qspi_read_status;
+        }
+    }
+#else
+    result = mtb_serial_memory_read(serial_memory_obj, addr, size, buffer);
+#endif /* #if (ASYNC_TRANSFER_IS_ENABLED) == 1U */
+
+    return result;
+}
+
 int lfs_spi_flash_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
         lfs_off_t off, void *buffer, lfs_size_t size)
 {
@@ -280,32 +573,21 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
 
 CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to mtb_serial_memory_t*. It is guaranteed that lfs_cfg->context points to a valid mtb_serial_memory_t instance.');
     mtb_serial_memory_t *serial_memory_obj = (mtb_serial_memory_t *)(lfs_cfg->context);
+    uint32_t addr = BLOCK_ADDRESS(lfs_cfg, block) + off;
 
-#if (ASYNC_TRANSFER_IS_ENABLED) == 1U
-    cy_rslt_t qspi_read_status = CY_RSLT_SUCCESS;
-
-    /* Disable interrupts to ensure interrupt occurs only when we are ready to
-     * get the semaphore.
-     */
-    uint32_t saved_intr_status = mtb_hal_system_critical_section_enter();
 CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer buffer is cast to uint8_t* for byte-level access. It is guaranteed that buffer points to a memory region containing uint8_t data.');
-    result = mtb_serial_memory_read_async(serial_memory_obj, lfs_spi_flash_address_start + (block * lfs_cfg->block_size) + off, size, (uint8_t*)buffer, qspi_read_complete_callback, (void *)&qspi_read_status);
-    mtb_hal_system_critical_section_exit(saved_intr_status);
-
-    if(CY_RSLT_SUCCESS == result)
+    if((NULL != lfs_spi_flash_read_cache_tags) && (size < lfs_spi_flash_read_cache_line_size))
     {
-        /* Wait until the read semaphore is set. */
-        result = cy_rtos_get_semaphore(&qspi_read_sema, LFS_SPI_FLASH_BD_ASYNC_READ_TIMEOUT_MS, false);
-
-        if(CY_RSLT_SUCCESS == result)
+        result = _read_cached(serial_memory_obj, addr, size, (uint8_t*)buffer);
+    }
+    else
+    {
+        if(NULL != lfs_spi_flash_read_cache_tags)
         {
-            result = qspi_read_status;
+            lfs_spi_flash_read_cache_stats.bypassed++;
         }
+        result = _read_memory(serial_memory_obj, addr, size, (uint8_t*)buffer);
     }
-#else
-    CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5','The third-party defines the function interface');
-    result = mtb_serial_memory_read(serial_memory_obj, lfs_spi_flash_address_start + (block * lfs_cfg->block_size) + off, size, buffer);
-#endif /* #if (ASYNC_TRANSFER_IS_ENABLED) == 1U */
 
     int32_t res = GET_INT_RETURN_VALUE(result);
 
@@ -338,8 +620,15 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
 CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to mtb_serial_memory_t*. It is guaranteed that lfs_cfg->context points to a valid mtb_serial_memory_t instance.');
     mtb_serial_memory_t *serial_memory_obj = (mtb_serial_memory_t *)(lfs_cfg->context);
 
+    uint32_t addr = BLOCK_ADDRESS(lfs_cfg, block) + off;
+
+    if(NULL != lfs_spi_flash_read_cache_tags)
+    {
+        _invalidate_cached(addr, size);
+    }
+
     CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5','The third-party defines the function interface');
-    cy_rslt_t result = mtb_serial_memory_write(serial_memory_obj, lfs_spi_flash_address_start + (block * lfs_cfg->block_size) + off, size, buffer);
+    cy_rslt_t result = mtb_serial_memory_write(serial_memory_obj, addr, size, buffer);
     int32_t res = GET_INT_RETURN_VALUE(result);
 
 CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
@@ -366,8 +655,14 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
 CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to mtb_serial_memory_t*. It is guaranteed that lfs_cfg->context points to a valid mtb_serial_memory_t instance.');
     mtb_serial_memory_t *serial_memory_obj = (mtb_serial_memory_t *)(lfs_cfg->context);
 
-    uint32_t addr = block * lfs_cfg->block_size;
-    cy_rslt_t result = mtb_serial_memory_erase(serial_memory_obj, lfs_spi_flash_address_start + addr, lfs_cfg->block_size);
+    uint32_t addr = BLOCK_ADDRESS(lfs_cfg, block);
+
+    if(NULL != lfs_spi_flash_read_cache_tags)
+    {
+        _invalidate_cached(addr, BLOCK_SIZE(lfs_cfg));
+    }
+
+    cy_rslt_t result = _erase_block(serial_memory_obj, addr, BLOCK_SIZE(lfs_cfg));
     int32_t res = GET_INT_RETURN_VALUE(result);
 
 CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
@@ -379,6 +674,111 @@ CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
     return res;
 }
 
+#if defined(COMPONENT_RTOS_AWARE)
+static uint32_t _rtos_time(void)
+{
+    cy_time_t now = 0U;
+    cy_rslt_t result = cy_rtos_get_time(&now);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+    return (uint32_t)now;
+}
+#endif /* #if defined(COMPONENT_RTOS_AWARE) */
+
+/* Serial-flash sends a chip erase when the request covers the whole memory
+ * and chains sector erases otherwise, so one request over the region is the
+ * largest erase that stays inside it. The sector erase fails rather than
+ * rounds when an end is not on a sector boundary; both ends are checked
+ * beforehand so nothing is erased in that case.
+ */
+cy_rslt_t lfs_spi_flash_bd_erase_region(const struct lfs_config *lfs_cfg, lfs_spi_flash_bd_time_fn_t get_time,
+        lfs_spi_flash_bd_erase_region_stats_t *stats)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_SPI_FLASH_BD_TRACE("lfs_spi_flash_bd_erase_region(%p, %p)", (void*)lfs_cfg, (void*)stats);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != lfs_cfg->context);
+
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to mtb_serial_memory_t*. It is guaranteed that lfs_cfg->context points to a valid mtb_serial_memory_t instance.');
+    mtb_serial_memory_t *serial_memory_obj = (mtb_serial_memory_t *)(lfs_cfg->context);
+
+    uint32_t addr = BLOCK_ADDRESS(lfs_cfg, 0U);
+    uint32_t size = lfs_cfg->block_count * BLOCK_SIZE(lfs_cfg);
+    uint32_t memory_size = (uint32_t)mtb_serial_memory_get_size(serial_memory_obj);
+    bool chip_erase = (0U == addr) && (memory_size == size);
+    uint32_t start_time = 0U;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+#if defined(COMPONENT_RTOS_AWARE)
+    if(NULL == get_time)
+    {
+        get_time = _rtos_time;
+    }
+#endif /* #if defined(COMPONENT_RTOS_AWARE) */
+
+    if((0U == size) || ((addr + size) > memory_size) ||
+       (0U != (addr % (uint32_t)mtb_serial_memory_get_erase_size(serial_memory_obj, addr))) ||
+       (0U != ((addr + size) % (uint32_t)mtb_serial_memory_get_erase_size(serial_memory_obj, (addr + size) - 1U))))
+    {
+        result = LFS_SPI_FLASH_BD_RSLT_ERR_REGION;
+    }
+#if defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH)
+    else if(chip_erase)
+    {
+        /* The code executed in place is in the same memory. */
+        result = LFS_SPI_FLASH_BD_RSLT_ERR_REGION;
+    }
+#endif /* #if defined(ENABLE_XIP_LITTLEFS_ON_SAME_NOR_FLASH) */
+    else
+    {
+#if defined(LFS_THREADSAFE)
+        result = cy_rtos_get_mutex(&_spi_flash_bd_mutex, LFS_SPI_FLASH_BD_GET_MUTEX_TIMEOUT_MS);
+#endif /* #if defined(LFS_THREADSAFE) */
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        if(NULL != lfs_spi_flash_read_cache_tags)
+        {
+            _invalidate_cached(addr, size);
+        }
+
+        if(NULL != get_time)
+        {
+            start_time = get_time();
+        }
+
+        result = mtb_serial_memory_erase(serial_memory_obj, addr, size);
+
+        if(NULL != stats)
+        {
+            stats->address = addr;
+            stats->erased_bytes = (CY_RSLT_SUCCESS == result) ? size : 0U;
+            stats->chip_erase = chip_erase;
+            stats->time_ms = (NULL != get_time) ? (get_time() - start_time) : 0U;
+        }
+
+#if defined(LFS_THREADSAFE)
+        cy_rslt_t unlock_result = cy_rtos_set_mutex(&_spi_flash_bd_mutex);
+        LFS_ASSERT(CY_RSLT_SUCCESS == unlock_result);
+        CY_UNUSED_PARAMETER(unlock_result); /* To avoid compiler warning in Release mode. */
+#endif /* #if defined(LFS_THREADSAFE) */
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_SPI_FLASH_BD_TRACE("lfs_spi_flash_bd_erase_region -> %"PRIu32"", result);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    return result;
+}
+
 /* Simply return zero because the QSPI block does not have any write cache in MMIO
  * mode.
  */
@@ -0,0 +1,296 @@
+/***************************************************************************//**
+ * \file lfs_stats_bd.c
+ *
+ * \brief
+ * Implements a block device that counts the calls, bytes and time spent in
+ * another block device, broken down by application-defined phases.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_stats_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_stats_bd_unlock and lfs_stats_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',6,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',4,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+static inline lfs_stats_bd_t *_get_stats(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_stats_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_stats_bd_t instance.');
+    return (lfs_stats_bd_t *)(lfs_cfg->context);
+}
+
+static inline uint32_t _now(const lfs_stats_bd_t *stats)
+{
+    return (NULL != stats->get_time) ? stats->get_time() : 0U;
+}
+
+/* Returns the counters of the current phase, or NULL when counting is
+ * stopped.
+ */
+static inline lfs_stats_bd_counters_t *_current(lfs_stats_bd_t *stats)
+{
+    return (stats->phase < LFS_STATS_BD_PHASES) ? &stats->counters[stats->phase] : NULL;
+}
+
+static inline void _add_bd_time(lfs_stats_bd_counters_t *counters, uint32_t start, const lfs_stats_bd_t *stats)
+{
+    if(NULL != counters)
+    {
+        counters->bd_time += _now(stats) - start;
+    }
+}
+
+cy_rslt_t lfs_stats_bd_create(struct lfs_config *lfs_cfg, lfs_stats_bd_t *stats,
+        const struct lfs_config *backing, lfs_stats_bd_time_fn_t get_time)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+    LFS_ASSERT(NULL != backing);
+
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->backing = backing;
+    stats->get_time = get_time;
+    stats->phase = LFS_STATS_BD_NO_PHASE;
+
+    lfs_cfg->context     = stats;
+
+    /* Block device operations */
+    lfs_cfg->read        = lfs_stats_bd_read;
+    lfs_cfg->prog        = lfs_stats_bd_prog;
+    lfs_cfg->erase       = lfs_stats_bd_erase;
+    lfs_cfg->sync        = lfs_stats_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+    lfs_cfg->lock        = lfs_stats_bd_lock;
+    lfs_cfg->unlock      = lfs_stats_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /* Start from the geometry and the littlefs tuning of the backing device.
+     * The tuning fields can be changed by the application to compare settings.
+     */
+    lfs_cfg->read_size      = backing->read_size;
+    lfs_cfg->prog_size      = backing->prog_size;
+    lfs_cfg->block_size     = backing->block_size;
+    lfs_cfg->block_count    = backing->block_count;
+    lfs_cfg->block_cycles   = backing->block_cycles;
+    lfs_cfg->cache_size     = backing->cache_size;
+    lfs_cfg->lookahead_size = backing->lookahead_size;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void lfs_stats_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_stats_bd_set_phase(lfs_cfg, LFS_STATS_BD_NO_PHASE);
+}
+
+void lfs_stats_bd_set_phase(const struct lfs_config *lfs_cfg, uint32_t phase)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT((phase < LFS_STATS_BD_PHASES) || (LFS_STATS_BD_NO_PHASE == phase));
+
+    lfs_stats_bd_t *stats = _get_stats(lfs_cfg);
+    lfs_stats_bd_counters_t *counters = _current(stats);
+    uint32_t now = _now(stats);
+
+    if(NULL != counters)
+    {
+        counters->elapsed += now - stats->phase_start;
+    }
+
+    stats->phase = phase;
+    stats->phase_start = now;
+}
+
+void lfs_stats_bd_get_phase(const struct lfs_config *lfs_cfg, uint32_t phase,
+        lfs_stats_bd_counters_t *counters)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(phase < LFS_STATS_BD_PHASES);
+    LFS_ASSERT(NULL != counters);
+
+    *counters = _get_stats(lfs_cfg)->counters[phase];
+}
+
+void lfs_stats_bd_get_total(const struct lfs_config *lfs_cfg, lfs_stats_bd_counters_t *counters)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != counters);
+
+    const lfs_stats_bd_t *stats = _get_stats(lfs_cfg);
+
+    (void)memset(counters, 0, sizeof(*counters));
+    for(uint32_t phase = 0U; phase < LFS_STATS_BD_PHASES; phase++)
+    {
+        const lfs_stats_bd_counters_t *c = &stats->counters[phase];
+
+        counters->read_count  += c->read_count;
+        counters->read_bytes  += c->read_bytes;
+        counters->block_scans += c->block_scans;
+        counters->prog_count  += c->prog_count;
+        counters->prog_bytes  += c->prog_bytes;
+        counters->erase_count += c->erase_count;
+        counters->sync_count  += c->sync_count;
+        counters->elapsed     += c->elapsed;
+        counters->bd_time     += c->bd_time;
+    }
+}
+
+void lfs_stats_bd_reset(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_stats_bd_t *stats = _get_stats(lfs_cfg);
+
+    (void)memset(stats->counters, 0, sizeof(stats->counters));
+    stats->phase_start = _now(stats);
+}
+
+int lfs_stats_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_stats_bd_t *stats = _get_stats(lfs_cfg);
+    lfs_stats_bd_counters_t *counters = _current(stats);
+    uint32_t start = _now(stats);
+
+    int res = stats->backing->read(stats->backing, block, off, buffer, size);
+
+    if(NULL != counters)
+    {
+        counters->read_count++;
+        counters->read_bytes += size;
+        counters->block_scans += (0U == off) ? 1U : 0U;
+    }
+    _add_bd_time(counters, start, stats);
+
+    return res;
+}
+
+int lfs_stats_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_stats_bd_t *stats = _get_stats(lfs_cfg);
+    lfs_stats_bd_counters_t *counters = _current(stats);
+    uint32_t start = _now(stats);
+
+    int res = stats->backing->prog(stats->backing, block, off, buffer, size);
+
+    if(NULL != counters)
+    {
+        counters->prog_count++;
+        counters->prog_bytes += size;
+    }
+    _add_bd_time(counters, start, stats);
+
+    return res;
+}
+
+int lfs_stats_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_stats_bd_t *stats = _get_stats(lfs_cfg);
+    lfs_stats_bd_counters_t *counters = _current(stats);
+    uint32_t start = _now(stats);
+
+    int res = stats->backing->erase(stats->backing, block);
+
+    if(NULL != counters)
+    {
+        counters->erase_count++;
+    }
+    _add_bd_time(counters, start, stats);
+
+    return res;
+}
+
+int lfs_stats_bd_sync(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_stats_bd_t *stats = _get_stats(lfs_cfg);
+    lfs_stats_bd_counters_t *counters = _current(stats);
+    uint32_t start = _now(stats);
+
+    int res = stats->backing->sync(stats->backing);
+
+    if(NULL != counters)
+    {
+        counters->sync_count++;
+    }
+    _add_bd_time(counters, start, stats);
+
+    return res;
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_stats_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_stats(lfs_cfg)->backing;
+    return backing->lock(backing);
+}
+
+int lfs_stats_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_stats(lfs_cfg)->backing;
+    return backing->unlock(backing);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
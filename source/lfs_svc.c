@@ -0,0 +1,772 @@
+/***************************************************************************//**
+ * \file lfs_svc.c
+ *
+ * \brief
+ * Implements a server and a client that run littlefs operations on another
+ * CPU core through shared memory.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_svc.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE)
+
+/* This block of code ignores violations of Directive 4.6 MISRA. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',12,\
+'The third-party defines the function interface with basic numeral type')
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define BINARY_SEMA_MAX_COUNT                       (1UL)
+#define BINARY_SEMA_INIT_COUNT                      (0UL)
+
+/* Operations of a request */
+#define OP_FILE_OPEN                                (1UL)
+#define OP_FILE_CLOSE                               (2UL)
+#define OP_FILE_READ                                (3UL)
+#define OP_FILE_WRITE                               (4UL)
+#define OP_FILE_SEEK                                (5UL)
+#define OP_FILE_SIZE                                (6UL)
+#define OP_FILE_SYNC                                (7UL)
+#define OP_FILE_TRUNCATE                            (8UL)
+#define OP_REMOVE                                   (9UL)
+#define OP_RENAME                                   (10UL)
+#define OP_MKDIR                                    (11UL)
+#define OP_STAT                                     (12UL)
+#define OP_DIR_OPEN                                 (13UL)
+#define OP_DIR_CLOSE                                (14UL)
+#define OP_DIR_READ                                 (15UL)
+#define OP_FS_SIZE                                  (16UL)
+
+
+/*******************************************************************************
+*                               Ring transport
+*******************************************************************************/
+
+static inline lfs_svc_ring_port_t *_get_port(void *context)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer context is cast to lfs_svc_ring_port_t*. It is guaranteed that context points to a valid lfs_svc_ring_port_t instance.');
+    return (lfs_svc_ring_port_t *)context;
+}
+
+static cy_rslt_t _ring_send(void *context, lfs_svc_request_t *request)
+{
+    lfs_svc_ring_port_t *port = _get_port(context);
+    lfs_svc_ring_t *ring = port->tx;
+    uint32_t head = ring->head;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if((head - ring->tail) >= LFS_SVC_RING_SIZE)
+    {
+        result = LFS_SVC_RSLT_ERR_RING_FULL;
+    }
+    else
+    {
+        ring->entries[head & (LFS_SVC_RING_SIZE - 1U)] = request;
+        /* The entry must be visible before the new head */
+        LFS_SVC_BARRIER();
+        ring->head = head + 1U;
+
+        if(NULL != port->notify)
+        {
+            port->notify(port->notify_arg);
+        }
+    }
+
+    return result;
+}
+
+static bool _ring_get(lfs_svc_ring_t *ring, lfs_svc_request_t **request)
+{
+    uint32_t tail = ring->tail;
+    bool found = (tail != ring->head);
+
+    if(found)
+    {
+        /* The entry is read only after the head that published it */
+        LFS_SVC_BARRIER();
+        *request = ring->entries[tail & (LFS_SVC_RING_SIZE - 1U)];
+        LFS_SVC_BARRIER();
+        ring->tail = tail + 1U;
+    }
+
+    return found;
+}
+
+static cy_rslt_t _ring_receive(void *context, lfs_svc_request_t **request, cy_time_t timeout_ms)
+{
+    lfs_svc_ring_port_t *port = _get_port(context);
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    /* A signal may be left from an entry that was already taken, so the ring
+     * is checked again after each wake-up.
+     */
+    while((CY_RSLT_SUCCESS == result) && !_ring_get(port->rx, request))
+    {
+        result = cy_rtos_get_semaphore(&port->event, timeout_ms, false);
+    }
+
+    return result;
+}
+
+void lfs_svc_ring_init(lfs_svc_ring_t *ring)
+{
+    LFS_ASSERT(NULL != ring);
+
+    ring->head = 0U;
+    ring->tail = 0U;
+    LFS_SVC_BARRIER();
+}
+
+cy_rslt_t lfs_svc_ring_port_init(lfs_svc_ring_port_t *port, lfs_svc_transport_t *transport,
+        lfs_svc_ring_t *tx, lfs_svc_ring_t *rx, lfs_svc_notify_fn_t notify, void *notify_arg)
+{
+    LFS_ASSERT(NULL != port);
+    LFS_ASSERT(NULL != transport);
+    LFS_ASSERT(NULL != tx);
+    LFS_ASSERT(NULL != rx);
+
+    port->tx = tx;
+    port->rx = rx;
+    port->notify = notify;
+    port->notify_arg = notify_arg;
+
+    transport->send = _ring_send;
+    transport->receive = _ring_receive;
+    transport->context = port;
+
+    return cy_rtos_init_semaphore(&port->event, BINARY_SEMA_MAX_COUNT, BINARY_SEMA_INIT_COUNT);
+}
+
+void lfs_svc_ring_port_deinit(lfs_svc_ring_port_t *port)
+{
+    LFS_ASSERT(NULL != port);
+
+    cy_rslt_t result = cy_rtos_deinit_semaphore(&port->event);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+void lfs_svc_ring_port_signal(lfs_svc_ring_port_t *port, bool in_isr)
+{
+    LFS_ASSERT(NULL != port);
+
+    /* Fails only if the semaphore is already given, which is not an error */
+    (void)cy_rtos_set_semaphore(&port->event, in_isr);
+}
+
+
+/*******************************************************************************
+*                                   Server
+*******************************************************************************/
+
+static int32_t _new_file(lfs_svc_server_t *server)
+{
+    int32_t handle = LFS_ERR_NOMEM;
+
+    for(uint32_t i = 0U; (i < LFS_SVC_MAX_FILES) && (handle < 0); i++)
+    {
+        if(!server->file_open[i])
+        {
+            handle = (int32_t)i;
+        }
+    }
+
+    return handle;
+}
+
+static int32_t _new_dir(lfs_svc_server_t *server)
+{
+    int32_t handle = LFS_ERR_NOMEM;
+
+    for(uint32_t i = 0U; (i < LFS_SVC_MAX_DIRS) && (handle < 0); i++)
+    {
+        if(!server->dir_open[i])
+        {
+            handle = (int32_t)i;
+        }
+    }
+
+    return handle;
+}
+
+static lfs_file_t *_get_file(lfs_svc_server_t *server, int32_t handle)
+{
+    lfs_file_t *file = NULL;
+
+    if((handle >= 0) && ((uint32_t)handle < LFS_SVC_MAX_FILES) && server->file_open[handle])
+    {
+        file = &server->files[handle];
+    }
+
+    return file;
+}
+
+static lfs_dir_t *_get_dir(lfs_svc_server_t *server, int32_t handle)
+{
+    lfs_dir_t *dir = NULL;
+
+    if((handle >= 0) && ((uint32_t)handle < LFS_SVC_MAX_DIRS) && server->dir_open[handle])
+    {
+        dir = &server->dirs[handle];
+    }
+
+    return dir;
+}
+
+static int32_t _run_file_op(lfs_svc_server_t *server, lfs_svc_request_t *request)
+{
+    lfs_file_t *file = _get_file(server, request->handle);
+    int32_t result = LFS_ERR_BADF;
+
+    if(NULL != file)
+    {
+        switch(request->op)
+        {
+            case OP_FILE_CLOSE:
+                result = lfs_file_close(server->lfs, file);
+                server->file_open[request->handle] = false;
+                break;
+
+            case OP_FILE_READ:
+                result = lfs_file_read(server->lfs, file, request->buffer, request->size);
+                if(result > 0)
+                {
+                    LFS_SVC_CLEAN_DCACHE(request->buffer, request->size);
+                }
+                break;
+
+            case OP_FILE_WRITE:
+                LFS_SVC_INVALIDATE_DCACHE(request->buffer, request->size);
+                result = lfs_file_write(server->lfs, file, request->buffer, request->size);
+                break;
+
+            case OP_FILE_SEEK:
+                result = lfs_file_seek(server->lfs, file, request->offset, request->flags);
+                break;
+
+            case OP_FILE_SIZE:
+                result = lfs_file_size(server->lfs, file);
+                break;
+
+            case OP_FILE_SYNC:
+                result = lfs_file_sync(server->lfs, file);
+                break;
+
+            case OP_FILE_TRUNCATE:
+                result = lfs_file_truncate(server->lfs, file, request->size);
+                break;
+
+            default:
+                result = LFS_ERR_INVAL;
+                break;
+        }
+    }
+
+    return result;
+}
+
+static int32_t _run_dir_op(lfs_svc_server_t *server, lfs_svc_request_t *request)
+{
+    lfs_dir_t *dir = _get_dir(server, request->handle);
+    int32_t result = LFS_ERR_BADF;
+
+    if(NULL != dir)
+    {
+        if(OP_DIR_CLOSE == request->op)
+        {
+            result = lfs_dir_close(server->lfs, dir);
+            server->dir_open[request->handle] = false;
+        }
+        else
+        {
+            result = lfs_dir_read(server->lfs, dir, &request->info);
+        }
+    }
+
+    return result;
+}
+
+static int32_t _run(lfs_svc_server_t *server, lfs_svc_request_t *request)
+{
+    int32_t result;
+
+    /* The paths come from the other core and are not trusted to be terminated */
+    request->path[LFS_SVC_PATH_MAX - 1U] = '\0';
+    request->new_path[LFS_SVC_PATH_MAX - 1U] = '\0';
+
+    switch(request->op)
+    {
+        case OP_FILE_OPEN:
+            result = _new_file(server);
+            if(result >= 0)
+            {
+                int32_t err = lfs_file_open(server->lfs, &server->files[result], request->path,
+                        request->flags);
+                if(0 == err)
+                {
+                    server->file_open[result] = true;
+                }
+                else
+                {
+                    result = err;
+                }
+            }
+            break;
+
+        case OP_DIR_OPEN:
+            result = _new_dir(server);
+            if(result >= 0)
+            {
+                int32_t err = lfs_dir_open(server->lfs, &server->dirs[result], request->path);
+                if(0 == err)
+                {
+                    server->dir_open[result] = true;
+                }
+                else
+                {
+                    result = err;
+                }
+            }
+            break;
+
+        case OP_DIR_CLOSE:
+        case OP_DIR_READ:
+            result = _run_dir_op(server, request);
+            break;
+
+        case OP_REMOVE:
+            result = lfs_remove(server->lfs, request->path);
+            break;
+
+        case OP_RENAME:
+            result = lfs_rename(server->lfs, request->path, request->new_path);
+            break;
+
+        case OP_MKDIR:
+            result = lfs_mkdir(server->lfs, request->path);
+            break;
+
+        case OP_STAT:
+            result = lfs_stat(server->lfs, request->path, &request->info);
+            break;
+
+        case OP_FS_SIZE:
+            result = lfs_fs_size(server->lfs);
+            break;
+
+        default:
+            result = _run_file_op(server, request);
+            break;
+    }
+
+    return result;
+}
+
+void lfs_svc_server_init(lfs_svc_server_t *server, lfs_t *lfs,
+        const lfs_svc_transport_t *transport)
+{
+    LFS_ASSERT(NULL != server);
+    LFS_ASSERT(NULL != lfs);
+    LFS_ASSERT(NULL != transport);
+
+    (void)memset(server, 0, sizeof(*server));
+    server->lfs = lfs;
+    server->transport = transport;
+}
+
+cy_rslt_t lfs_svc_server_process(lfs_svc_server_t *server, cy_time_t timeout_ms)
+{
+    LFS_ASSERT(NULL != server);
+
+    lfs_svc_request_t *request = NULL;
+    cy_rslt_t result = server->transport->receive(server->transport->context, &request, timeout_ms);
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        LFS_SVC_INVALIDATE_DCACHE(request, sizeof(*request));
+        request->result = _run(server, request);
+        LFS_SVC_CLEAN_DCACHE(request, sizeof(*request));
+
+        result = server->transport->send(server->transport->context, request);
+    }
+
+    return result;
+}
+
+void lfs_svc_server_deinit(lfs_svc_server_t *server)
+{
+    LFS_ASSERT(NULL != server);
+
+    for(uint32_t i = 0U; i < LFS_SVC_MAX_FILES; i++)
+    {
+        if(server->file_open[i])
+        {
+            (void)lfs_file_close(server->lfs, &server->files[i]);
+            server->file_open[i] = false;
+        }
+    }
+
+    for(uint32_t i = 0U; i < LFS_SVC_MAX_DIRS; i++)
+    {
+        if(server->dir_open[i])
+        {
+            (void)lfs_dir_close(server->lfs, &server->dirs[i]);
+            server->dir_open[i] = false;
+        }
+    }
+}
+
+
+/*******************************************************************************
+*                                   Client
+*******************************************************************************/
+
+static inline void _lock(lfs_svc_client_t *client)
+{
+    cy_rslt_t result = cy_rtos_get_mutex(&client->mutex, CY_RTOS_NEVER_TIMEOUT);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+static inline void _unlock(lfs_svc_client_t *client)
+{
+    cy_rslt_t result = cy_rtos_set_mutex(&client->mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+static int32_t _set_path(char *dest, const char *path)
+{
+    size_t length = strlen(path);
+    int32_t err = 0;
+
+    if(length >= LFS_SVC_PATH_MAX)
+    {
+        err = LFS_ERR_NAMETOOLONG;
+    }
+    else
+    {
+        (void)memcpy(dest, path, length + 1U);
+    }
+
+    return err;
+}
+
+/* Sends the request of the client and waits for its response. Called with the
+ * mutex of the client taken.
+ */
+static int32_t _transact(lfs_svc_client_t *client)
+{
+    lfs_svc_request_t *request = client->request;
+    lfs_svc_request_t *response = NULL;
+    int32_t err = LFS_ERR_IO;
+
+    if(!client->failed)
+    {
+        if(OP_FILE_WRITE == request->op)
+        {
+            LFS_SVC_CLEAN_DCACHE(request->buffer, request->size);
+        }
+        else if(OP_FILE_READ == request->op)
+        {
+            /* Dirty lines must not be written back over the data of the server */
+            LFS_SVC_INVALIDATE_DCACHE(request->buffer, request->size);
+        }
+        else
+        {
+            /* No data buffer */
+        }
+        LFS_SVC_CLEAN_DCACHE(request, sizeof(*request));
+
+        cy_rslt_t result = client->transport->send(client->transport->context, request);
+
+        if(CY_RSLT_SUCCESS == result)
+        {
+            result = client->transport->receive(client->transport->context, &response,
+                    client->timeout_ms);
+        }
+
+        if((CY_RSLT_SUCCESS == result) && (response == request))
+        {
+            LFS_SVC_INVALIDATE_DCACHE(request, sizeof(*request));
+            if((OP_FILE_READ == request->op) && (request->result > 0))
+            {
+                LFS_SVC_INVALIDATE_DCACHE(request->buffer, request->size);
+            }
+            err = request->result;
+        }
+        else
+        {
+            /* The server may still use the request */
+            client->failed = true;
+        }
+    }
+
+    return err;
+}
+
+/* Runs an operation that takes a handle and optionally a buffer */
+static int32_t _handle_op(lfs_svc_client_t *client, uint32_t op, int32_t handle,
+        void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != client);
+
+    _lock(client);
+
+    lfs_svc_request_t *request = client->request;
+    request->op = op;
+    request->handle = handle;
+    request->buffer = buffer;
+    request->size = size;
+
+    int32_t err = _transact(client);
+
+    _unlock(client);
+
+    return err;
+}
+
+/* Runs an operation that takes paths */
+static int32_t _path_op(lfs_svc_client_t *client, uint32_t op, const char *path,
+        const char *new_path, struct lfs_info *info)
+{
+    LFS_ASSERT(NULL != client);
+    LFS_ASSERT(NULL != path);
+
+    _lock(client);
+
+    lfs_svc_request_t *request = client->request;
+    request->op = op;
+
+    int32_t err = _set_path(request->path, path);
+
+    if((0 == err) && (NULL != new_path))
+    {
+        err = _set_path(request->new_path, new_path);
+    }
+
+    if(0 == err)
+    {
+        err = _transact(client);
+    }
+
+    if((0 == err) && (NULL != info))
+    {
+        *info = request->info;
+    }
+
+    _unlock(client);
+
+    return err;
+}
+
+cy_rslt_t lfs_svc_client_init(lfs_svc_client_t *client, const lfs_svc_transport_t *transport,
+        lfs_svc_request_t *request, cy_time_t timeout_ms)
+{
+    LFS_ASSERT(NULL != client);
+    LFS_ASSERT(NULL != transport);
+    LFS_ASSERT(NULL != request);
+
+    client->transport = transport;
+    client->request = request;
+    client->timeout_ms = timeout_ms;
+    client->failed = false;
+
+    return cy_rtos_init_mutex(&client->mutex);
+}
+
+void lfs_svc_client_deinit(lfs_svc_client_t *client)
+{
+    LFS_ASSERT(NULL != client);
+
+    cy_rslt_t result = cy_rtos_deinit_mutex(&client->mutex);
+    LFS_ASSERT(CY_RSLT_SUCCESS == result);
+    CY_UNUSED_PARAMETER(result); /* To avoid compiler warning in Release mode. */
+}
+
+int lfs_svc_file_open(lfs_svc_client_t *client, const char *path, int flags)
+{
+    LFS_ASSERT(NULL != client);
+    LFS_ASSERT(NULL != path);
+
+    _lock(client);
+
+    client->request->op = OP_FILE_OPEN;
+    client->request->flags = flags;
+
+    int32_t err = _set_path(client->request->path, path);
+
+    if(0 == err)
+    {
+        err = _transact(client);
+    }
+
+    _unlock(client);
+
+    return err;
+}
+
+int lfs_svc_file_close(lfs_svc_client_t *client, int32_t file)
+{
+    return _handle_op(client, OP_FILE_CLOSE, file, NULL, 0U);
+}
+
+lfs_ssize_t lfs_svc_file_read(lfs_svc_client_t *client, int32_t file, void *buffer,
+        lfs_size_t size)
+{
+    LFS_ASSERT(NULL != buffer);
+
+    return _handle_op(client, OP_FILE_READ, file, buffer, size);
+}
+
+lfs_ssize_t lfs_svc_file_write(lfs_svc_client_t *client, int32_t file, const void *buffer,
+        lfs_size_t size)
+{
+    LFS_ASSERT(NULL != buffer);
+
+    /* The server only reads the buffer of a write request */
+    CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.8', 'The const qualifier of buffer is removed to store it in the request. The server does not modify the data of a write request.');
+    return _handle_op(client, OP_FILE_WRITE, file, (void *)buffer, size);
+}
+
+lfs_soff_t lfs_svc_file_seek(lfs_svc_client_t *client, int32_t file, lfs_soff_t off,
+        int whence)
+{
+    LFS_ASSERT(NULL != client);
+
+    _lock(client);
+
+    client->request->op = OP_FILE_SEEK;
+    client->request->handle = file;
+    client->request->offset = off;
+    client->request->flags = whence;
+
+    int32_t err = _transact(client);
+
+    _unlock(client);
+
+    return err;
+}
+
+lfs_soff_t lfs_svc_file_size(lfs_svc_client_t *client, int32_t file)
+{
+    return _handle_op(client, OP_FILE_SIZE, file, NULL, 0U);
+}
+
+int lfs_svc_file_sync(lfs_svc_client_t *client, int32_t file)
+{
+    return _handle_op(client, OP_FILE_SYNC, file, NULL, 0U);
+}
+
+int lfs_svc_file_truncate(lfs_svc_client_t *client, int32_t file, lfs_off_t size)
+{
+    return _handle_op(client, OP_FILE_TRUNCATE, file, NULL, size);
+}
+
+int lfs_svc_remove(lfs_svc_client_t *client, const char *path)
+{
+    return _path_op(client, OP_REMOVE, path, NULL, NULL);
+}
+
+int lfs_svc_rename(lfs_svc_client_t *client, const char *old_path, const char *new_path)
+{
+    LFS_ASSERT(NULL != new_path);
+
+    return _path_op(client, OP_RENAME, old_path, new_path, NULL);
+}
+
+int lfs_svc_mkdir(lfs_svc_client_t *client, const char *path)
+{
+    return _path_op(client, OP_MKDIR, path, NULL, NULL);
+}
+
+int lfs_svc_stat(lfs_svc_client_t *client, const char *path, struct lfs_info *info)
+{
+    LFS_ASSERT(NULL != info);
+
+    return _path_op(client, OP_STAT, path, NULL, info);
+}
+
+int lfs_svc_dir_open(lfs_svc_client_t *client, const char *path)
+{
+    return _path_op(client, OP_DIR_OPEN, path, NULL, NULL);
+}
+
+int lfs_svc_dir_close(lfs_svc_client_t *client, int32_t dir)
+{
+    return _handle_op(client, OP_DIR_CLOSE, dir, NULL, 0U);
+}
+
+int lfs_svc_dir_read(lfs_svc_client_t *client, int32_t dir, struct lfs_info *info)
+{
+    LFS_ASSERT(NULL != client);
+    LFS_ASSERT(NULL != info);
+
+    _lock(client);
+
+    client->request->op = OP_DIR_READ;
+    client->request->handle = dir;
+
+    int32_t err = _transact(client);
+
+    if(err > 0)
+    {
+        *info = client->request->info;
+    }
+
+    _unlock(client);
+
+    return err;
+}
+
+lfs_ssize_t lfs_svc_fs_size(lfs_svc_client_t *client)
+{
+    return _handle_op(client, OP_FS_SIZE, 0, NULL, 0U);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
+
+#endif /* #if defined(COMPONENT_RTOS_AWARE) || defined(LFS_THREADSAFE) */
@@ -0,0 +1,747 @@
+/***************************************************************************//**
+ * \file lfs_tiered_bd.c
+ *
+ * \brief
+ * Implements a tiered block device for use with the littlefs API. Frequently
+ * used blocks of a backing block device are kept resident in a RAM region.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_tiered_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_tiered_bd_unlock and lfs_tiered_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',11,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',9,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#define RESULT_OK                                   (0)
+#define RESULT_ERROR                                (-1)
+
+/* Slot flags */
+#define SLOT_VALID                                  (0x01U)
+#define SLOT_DIRTY                                  (0x02U)
+#define SLOT_PINNED                                 (0x04U)
+#define SLOT_ERASE_PENDING                          (0x08U)
+
+/* Blocks holding the superblock and the root directory */
+#define ROOT_PAIR_LAST_BLOCK                        (1U)
+
+static inline lfs_tiered_bd_t *_get_tiered(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_tiered_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_tiered_bd_t instance.');
+    return (lfs_tiered_bd_t *)(lfs_cfg->context);
+}
+
+static inline uint8_t *_slot_data(const lfs_tiered_bd_t *tiered, uint32_t slot)
+{
+    return &tiered->ram[slot * tiered->backing->block_size];
+}
+
+static uint32_t _find_slot(const lfs_tiered_bd_t *tiered, lfs_block_t block)
+{
+    uint32_t slot = tiered->slot_count;
+
+    for(uint32_t i = 0U; i < tiered->slot_count; i++)
+    {
+        if((0U != (tiered->slots[i].flags & SLOT_VALID)) && (block == tiered->slots[i].block))
+        {
+            slot = i;
+            break;
+        }
+    }
+
+    return slot;
+}
+
+static inline void _touch(lfs_tiered_bd_t *tiered, uint32_t slot)
+{
+    tiered->tick++;
+    tiered->slots[slot].last_use = tiered->tick;
+}
+
+static void _mark_dirty(lfs_tiered_bd_t *tiered, uint32_t slot)
+{
+    lfs_tiered_bd_slot_t *s = &tiered->slots[slot];
+
+    /* The sequence number of the first modification decides the write-back
+     * order, which keeps the backing device updated in the order littlefs
+     * issued the operations.
+     */
+    if(0U == (s->flags & SLOT_DIRTY))
+    {
+        tiered->dirty_seq++;
+        s->dirty_seq = tiered->dirty_seq;
+        s->flags |= SLOT_DIRTY;
+    }
+}
+
+static int _write_back(lfs_tiered_bd_t *tiered, uint32_t slot)
+{
+    const struct lfs_config *backing = tiered->backing;
+    lfs_tiered_bd_slot_t *s = &tiered->slots[slot];
+    int res = RESULT_OK;
+
+    if(0U != (s->flags & SLOT_DIRTY))
+    {
+        if(0U != (s->flags & SLOT_ERASE_PENDING))
+        {
+            res = backing->erase(backing, s->block);
+            if(RESULT_OK == res)
+            {
+                s->flags &= (uint8_t)~SLOT_ERASE_PENDING;
+            }
+        }
+
+        if((RESULT_OK == res) && (s->dirty_end > s->dirty_start))
+        {
+            res = backing->prog(backing, s->block, s->dirty_start, &_slot_data(tiered, slot)[s->dirty_start],
+                                s->dirty_end - s->dirty_start);
+        }
+
+        if(RESULT_OK == res)
+        {
+            s->dirty_start = 0U;
+            s->dirty_end = 0U;
+            s->flags &= (uint8_t)~SLOT_DIRTY;
+            tiered->stats.write_backs++;
+        }
+    }
+
+    return res;
+}
+
+/* Writes back the dirty slots in the order in which they were first
+ * modified, up to and including the slot first modified at last_seq.
+ */
+static int _write_back_through(lfs_tiered_bd_t *tiered, uint32_t last_seq)
+{
+    int res = RESULT_OK;
+
+    while(RESULT_OK == res)
+    {
+        uint32_t oldest = tiered->slot_count;
+
+        for(uint32_t i = 0U; i < tiered->slot_count; i++)
+        {
+            if((0U != (tiered->slots[i].flags & SLOT_DIRTY)) &&
+               ((oldest == tiered->slot_count) || (tiered->slots[i].dirty_seq < tiered->slots[oldest].dirty_seq)))
+            {
+                oldest = i;
+            }
+        }
+
+        if((oldest == tiered->slot_count) || (tiered->slots[oldest].dirty_seq > last_seq))
+        {
+            break;
+        }
+
+        res = _write_back(tiered, oldest);
+    }
+
+    return res;
+}
+
+static inline int _write_back_all(lfs_tiered_bd_t *tiered)
+{
+    return _write_back_through(tiered, tiered->dirty_seq);
+}
+
+/* A deferred operation keeps the write-back in the order of the operations
+ * only if it applies to the block modified last. Otherwise the pending
+ * operations are written back first, and the block starts a new sequence.
+ */
+static int _prepare_modify(lfs_tiered_bd_t *tiered, uint32_t slot)
+{
+    const lfs_tiered_bd_slot_t *s = &tiered->slots[slot];
+    int res = RESULT_OK;
+
+    if((0U != (s->flags & SLOT_DIRTY)) && (s->dirty_seq != tiered->dirty_seq))
+    {
+        res = _write_back_all(tiered);
+    }
+
+    return res;
+}
+
+/* Returns a free slot, or evicts the least recently used slot that is not
+ * pinned. Returns slot_count when every slot is pinned or the write-back of
+ * the victim failed.
+ */
+static uint32_t _alloc_slot(lfs_tiered_bd_t *tiered)
+{
+    uint32_t victim = tiered->slot_count;
+
+    for(uint32_t i = 0U; i < tiered->slot_count; i++)
+    {
+        const lfs_tiered_bd_slot_t *s = &tiered->slots[i];
+
+        if(0U == (s->flags & SLOT_VALID))
+        {
+            victim = i;
+            break;
+        }
+
+        if((0U == (s->flags & SLOT_PINNED)) &&
+           ((victim == tiered->slot_count) || (s->last_use < tiered->slots[victim].last_use)))
+        {
+            victim = i;
+        }
+    }
+
+    if((victim != tiered->slot_count) && (0U != (tiered->slots[victim].flags & SLOT_VALID)))
+    {
+        int res = RESULT_OK;
+
+        /* The blocks modified before the victim are written back first. */
+        if(0U != (tiered->slots[victim].flags & SLOT_DIRTY))
+        {
+            res = _write_back_through(tiered, tiered->slots[victim].dirty_seq);
+        }
+
+        if(RESULT_OK == res)
+        {
+            tiered->slots[victim].flags = 0U;
+            tiered->stats.evictions++;
+        }
+        else
+        {
+            victim = tiered->slot_count;
+        }
+    }
+
+    return victim;
+}
+
+static void _assign_slot(lfs_tiered_bd_t *tiered, uint32_t slot, lfs_block_t block)
+{
+    lfs_tiered_bd_slot_t *s = &tiered->slots[slot];
+
+    s->block = block;
+    s->flags = SLOT_VALID;
+    s->dirty_start = 0U;
+    s->dirty_end = 0U;
+
+    if((LFS_TIERED_BD_POLICY_LRU_PIN_ROOT == tiered->policy) && (block <= ROOT_PAIR_LAST_BLOCK))
+    {
+        s->flags |= SLOT_PINNED;
+    }
+
+    _touch(tiered, slot);
+}
+
+/* Loads a whole block from the backing device. Returns slot_count when no slot
+ * is available or the read failed.
+ */
+static uint32_t _load_slot(lfs_tiered_bd_t *tiered, lfs_block_t block)
+{
+    const struct lfs_config *backing = tiered->backing;
+    uint32_t slot = _alloc_slot(tiered);
+
+    if(slot != tiered->slot_count)
+    {
+        if(RESULT_OK == backing->read(backing, block, 0U, _slot_data(tiered, slot), backing->block_size))
+        {
+            _assign_slot(tiered, slot, block);
+            tiered->stats.fills++;
+        }
+        else
+        {
+            slot = tiered->slot_count;
+        }
+    }
+
+    return slot;
+}
+
+cy_rslt_t lfs_tiered_bd_create(struct lfs_config *lfs_cfg, lfs_tiered_bd_t *tiered,
+        const lfs_tiered_bd_config_t *config)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_create(%p, %p, %p)", (void*)lfs_cfg, (void*)tiered, (void*)config);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != tiered);
+    LFS_ASSERT(NULL != config);
+    LFS_ASSERT(NULL != config->backing);
+    LFS_ASSERT(NULL != config->ram);
+    LFS_ASSERT((NULL != config->slots) && (0U < config->slot_count));
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    const struct lfs_config *backing = config->backing;
+
+    if((config->ram_size / backing->block_size) < config->slot_count)
+    {
+        result = LFS_TIERED_BD_RSLT_ERR_RAM_SIZE;
+    }
+
+    if(CY_RSLT_SUCCESS == result)
+    {
+        (void)memset(tiered, 0, sizeof(*tiered));
+        (void)memset(config->slots, 0, config->slot_count * sizeof(lfs_tiered_bd_slot_t));
+
+        tiered->backing     = backing;
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The void* pointer ram is cast to uint8_t* for byte-level access.');
+        tiered->ram         = (uint8_t *)config->ram;
+        tiered->slots       = config->slots;
+        tiered->slot_count  = config->slot_count;
+        tiered->policy      = config->policy;
+        tiered->deferred    = config->deferred;
+
+        lfs_cfg->context     = tiered;
+
+        /* Block device operations */
+        lfs_cfg->read        = lfs_tiered_bd_read;
+        lfs_cfg->prog        = lfs_tiered_bd_prog;
+        lfs_cfg->erase       = lfs_tiered_bd_erase;
+        lfs_cfg->sync        = lfs_tiered_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+        lfs_cfg->lock        = lfs_tiered_bd_lock;
+        lfs_cfg->unlock      = lfs_tiered_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+        /* The tiered device exposes the geometry and the littlefs tuning of
+         * the backing device unchanged.
+         */
+        lfs_cfg->read_size      = backing->read_size;
+        lfs_cfg->prog_size      = backing->prog_size;
+        lfs_cfg->block_size     = backing->block_size;
+        lfs_cfg->block_count    = backing->block_count;
+        lfs_cfg->block_cycles   = backing->block_cycles;
+        lfs_cfg->cache_size     = backing->cache_size;
+        lfs_cfg->lookahead_size = backing->lookahead_size;
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_create -> %"PRIu32"", result);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    return result;
+}
+
+void lfs_tiered_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_destroy(%p)", (void*)lfs_cfg);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+    int res = _write_back_all(tiered);
+    LFS_ASSERT(RESULT_OK == res);
+    CY_UNUSED_PARAMETER(res); /* To avoid compiler warning in Release mode. */
+
+    tiered->slot_count = 0U;
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_destroy -> %d", 0);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+}
+
+int lfs_tiered_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_read(%p, "
+                    "0x%"PRIx32", %"PRIu32", %p, %"PRIu32")",
+                (void*)lfs_cfg, block, off, buffer, size);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+    LFS_ASSERT((off % lfs_cfg->read_size) == 0);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((size % lfs_cfg->read_size) == 0);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+    int res = RESULT_OK;
+    uint32_t slot = _find_slot(tiered, block);
+
+    if(slot != tiered->slot_count)
+    {
+        tiered->stats.read_hits++;
+    }
+    else
+    {
+        tiered->stats.read_misses++;
+        slot = _load_slot(tiered, block);
+    }
+
+    if(slot != tiered->slot_count)
+    {
+        (void)memcpy(buffer, &_slot_data(tiered, slot)[off], size);
+        _touch(tiered, slot);
+    }
+    else
+    {
+        /* No slot available: read through to the backing device. */
+        res = tiered->backing->read(tiered->backing, block, off, buffer, size);
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_read -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_tiered_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_prog(%p, "
+                    "0x%"PRIx32", %"PRIu32", %p, %"PRIu32")",
+                (void*)lfs_cfg, block, off, buffer, size);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+    LFS_ASSERT((off % lfs_cfg->prog_size) == 0);
+    LFS_ASSERT(NULL != buffer);
+    LFS_ASSERT((size % lfs_cfg->prog_size) == 0);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+    const struct lfs_config *backing = tiered->backing;
+    int res = RESULT_OK;
+    uint32_t slot = _find_slot(tiered, block);
+
+    if(tiered->deferred)
+    {
+        if(slot == tiered->slot_count)
+        {
+            slot = _load_slot(tiered, block);
+        }
+
+        if(slot != tiered->slot_count)
+        {
+            lfs_tiered_bd_slot_t *s = &tiered->slots[slot];
+
+            /* littlefs programs a block sequentially. A program that does not
+             * extend the pending range is preceded by a write-back so that
+             * every byte of the backing device is programmed once.
+             */
+            res = _prepare_modify(tiered, slot);
+            if((RESULT_OK == res) && (s->dirty_end > s->dirty_start) && (off != s->dirty_end))
+            {
+                res = _write_back_all(tiered);
+            }
+
+            if(RESULT_OK == res)
+            {
+                if(s->dirty_end <= s->dirty_start)
+                {
+                    s->dirty_start = off;
+                }
+                s->dirty_end = off + size;
+                _mark_dirty(tiered, slot);
+                tiered->stats.deferred_writes++;
+            }
+        }
+    }
+
+    if((!tiered->deferred) || (slot == tiered->slot_count))
+    {
+        /* A deferred program without a usable slot goes to the backing device
+         * directly, after the pending write-backs, so it does not pass them.
+         */
+        res = tiered->deferred ? _write_back_all(tiered) : RESULT_OK;
+        if(RESULT_OK == res)
+        {
+            res = backing->prog(backing, block, off, buffer, size);
+        }
+
+        /* The resident copy is refreshed from the backing device, not from
+         * the buffer, so the read-back with which littlefs verifies a program
+         * still detects a bad program or a bad block.
+         */
+        if((RESULT_OK == res) && (slot != tiered->slot_count))
+        {
+            if(RESULT_OK == backing->read(backing, block, off, &_slot_data(tiered, slot)[off], size))
+            {
+                _touch(tiered, slot);
+            }
+            else
+            {
+                tiered->slots[slot].flags = 0U;
+            }
+        }
+    }
+    else if(RESULT_OK == res)
+    {
+        (void)memcpy(&_slot_data(tiered, slot)[off], buffer, size);
+        _touch(tiered, slot);
+    }
+    else
+    {
+        /* The write-back error is returned. */
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_prog -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_tiered_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_erase(%p, 0x%"PRIx32")", (void*)lfs_cfg, block);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    /* Check if parameters are valid. */
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+    const struct lfs_config *backing = tiered->backing;
+    int res = RESULT_OK;
+    uint32_t slot = _find_slot(tiered, block);
+
+    if(tiered->deferred)
+    {
+        /* The erased content is known, so a missing block is not loaded. */
+        if(slot == tiered->slot_count)
+        {
+            slot = _alloc_slot(tiered);
+            if(slot != tiered->slot_count)
+            {
+                _assign_slot(tiered, slot, block);
+            }
+        }
+
+        if(slot != tiered->slot_count)
+        {
+            lfs_tiered_bd_slot_t *s = &tiered->slots[slot];
+
+            res = _prepare_modify(tiered, slot);
+            if(RESULT_OK == res)
+            {
+                /* A pending erase supersedes any pending program of the block. */
+                s->dirty_start = 0U;
+                s->dirty_end = 0U;
+                s->flags |= SLOT_ERASE_PENDING;
+                _mark_dirty(tiered, slot);
+                tiered->stats.deferred_writes++;
+            }
+        }
+    }
+
+    if((!tiered->deferred) || (slot == tiered->slot_count))
+    {
+        /* As for a program, the pending write-backs go first. */
+        res = tiered->deferred ? _write_back_all(tiered) : RESULT_OK;
+        if(RESULT_OK == res)
+        {
+            res = backing->erase(backing, block);
+        }
+    }
+
+    if((RESULT_OK == res) && (slot != tiered->slot_count))
+    {
+        (void)memset(_slot_data(tiered, slot), (int)LFS_TIERED_BD_ERASE_VALUE, lfs_cfg->block_size);
+        _touch(tiered, slot);
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_erase -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_tiered_bd_sync(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_sync(%p)", (void*)lfs_cfg);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+    int res = _write_back_all(tiered);
+
+    if(RESULT_OK == res)
+    {
+        res = tiered->backing->sync(tiered->backing);
+    }
+
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Rule 17.7',1,\
+    'Impossible to cast due-to the macros wrapper of printf')
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 21.6','Using the safe wrapper of printf');
+    LFS_TIERED_BD_TRACE("lfs_tiered_bd_sync -> %d", res);
+CY_MISRA_BLOCK_END('MISRA C-2012 Rule 17.7')
+    return res;
+}
+
+int lfs_tiered_bd_flush(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    return _write_back_all(_get_tiered(lfs_cfg));
+}
+
+int lfs_tiered_bd_pin(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(block < lfs_cfg->block_count);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+    int res = RESULT_ERROR;
+    uint32_t slot = _find_slot(tiered, block);
+
+    if(slot == tiered->slot_count)
+    {
+        slot = _load_slot(tiered, block);
+    }
+
+    if(slot != tiered->slot_count)
+    {
+        tiered->slots[slot].flags |= SLOT_PINNED;
+        res = RESULT_OK;
+    }
+
+    return res;
+}
+
+void lfs_tiered_bd_unpin(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+    uint32_t slot = _find_slot(tiered, block);
+
+    if(slot != tiered->slot_count)
+    {
+        tiered->slots[slot].flags &= (uint8_t)~SLOT_PINNED;
+    }
+}
+
+bool lfs_tiered_bd_is_resident(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+
+    return (_find_slot(tiered, block) != tiered->slot_count);
+}
+
+void lfs_tiered_bd_get_stats(const struct lfs_config *lfs_cfg, lfs_tiered_bd_stats_t *stats)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+
+    const lfs_tiered_bd_t *tiered = _get_tiered(lfs_cfg);
+
+    *stats = tiered->stats;
+    stats->resident = 0U;
+    stats->pinned = 0U;
+    stats->dirty = 0U;
+
+    for(uint32_t i = 0U; i < tiered->slot_count; i++)
+    {
+        uint8_t flags = tiered->slots[i].flags;
+
+        if(0U != (flags & SLOT_VALID))
+        {
+            stats->resident++;
+            stats->pinned += (0U != (flags & SLOT_PINNED)) ? 1U : 0U;
+            stats->dirty += (0U != (flags & SLOT_DIRTY)) ? 1U : 0U;
+        }
+    }
+}
+
+void lfs_tiered_bd_reset_stats(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    (void)memset(&_get_tiered(lfs_cfg)->stats, 0, sizeof(lfs_tiered_bd_stats_t));
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_tiered_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_tiered(lfs_cfg)->backing;
+    return backing->lock(backing);
+}
+
+int lfs_tiered_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_tiered(lfs_cfg)->backing;
+    return backing->unlock(backing);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
@@ -0,0 +1,481 @@
+/***************************************************************************//**
+ * \file lfs_wa_bd.c
+ *
+ * \brief
+ * Implements a block device that attributes the bytes programmed and erased on
+ * another block device to the littlefs operation and file that caused them.
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_wa_bd.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+#if defined(LFS_THREADSAFE) /* This block of code ignores violations of Directive 4.6 MISRA. Functions lfs_wa_bd_unlock and lfs_wa_bd_lock don't reproduce violations if LFS_THREADSAFE not defined. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',9,\
+'The third-party defines the function interface with basic numeral type')
+#else
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',7,\
+'The third-party defines the function interface with basic numeral type')
+#endif /* #if defined(LFS_THREADSAFE) */
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+static inline lfs_wa_bd_t *_get_wa(const struct lfs_config *lfs_cfg)
+{
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The pointer lfs_cfg->context is cast to lfs_wa_bd_t*. It is guaranteed that lfs_cfg->context points to a valid lfs_wa_bd_t instance.');
+    return (lfs_wa_bd_t *)(lfs_cfg->context);
+}
+
+/* Returns the index of the tracked handle, or LFS_WA_BD_MAX_OPEN. */
+static uint32_t _find_open(const lfs_wa_bd_t *wa, const lfs_file_t *file)
+{
+    uint32_t i = 0U;
+
+    while((i < LFS_WA_BD_MAX_OPEN) && (wa->open_handles[i] != file))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/* Returns the index of the file name, adding it if there is room, or
+ * LFS_WA_BD_MAX_FILES.
+ */
+static uint32_t _find_name(lfs_wa_bd_t *wa, const char *path)
+{
+    uint32_t i = 0U;
+
+    while((i < wa->file_count) &&
+          (0 != strncmp(wa->files[i].name, path, LFS_WA_BD_NAME_SIZE - 1U)))
+    {
+        i++;
+    }
+
+    if((i == wa->file_count) && (i < LFS_WA_BD_MAX_FILES))
+    {
+        (void)strncpy(wa->files[i].name, path, LFS_WA_BD_NAME_SIZE - 1U);
+        wa->files[i].name[LFS_WA_BD_NAME_SIZE - 1U] = '\0';
+        wa->file_count++;
+    }
+
+    return i;
+}
+
+static inline void _add(lfs_wa_bd_counters_t *total, const lfs_wa_bd_counters_t *counters)
+{
+    total->calls += counters->calls;
+    total->logical_bytes += counters->logical_bytes;
+    total->prog_bytes += counters->prog_bytes;
+    total->erases += counters->erases;
+    total->erased_bytes += counters->erased_bytes;
+}
+
+/* Returns numerator / denominator times 100, saturated to 32 bits. */
+static inline uint32_t _ratio(uint64_t numerator, uint64_t denominator)
+{
+    uint64_t ratio = 0U;
+
+    if(0U != denominator)
+    {
+        /* The remainder is multiplied instead of the numerator, which may use
+         * all 64 bits.
+         */
+        uint64_t quotient = numerator / denominator;
+        ratio = (quotient > (UINT64_MAX / 100U)) ? UINT64_MAX :
+                ((quotient * 100U) + (((numerator % denominator) * 100U) / denominator));
+    }
+
+    return (ratio > UINT32_MAX) ? UINT32_MAX : (uint32_t)ratio;
+}
+
+cy_rslt_t lfs_wa_bd_create(struct lfs_config *lfs_cfg, lfs_wa_bd_t *wa,
+        const struct lfs_config *backing)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != wa);
+    LFS_ASSERT(NULL != backing);
+
+    (void)memset(wa, 0, sizeof(*wa));
+    wa->backing = backing;
+    wa->op = LFS_WA_BD_OP_UNTAGGED;
+
+    lfs_cfg->context     = wa;
+
+    /* Block device operations */
+    lfs_cfg->read        = lfs_wa_bd_read;
+    lfs_cfg->prog        = lfs_wa_bd_prog;
+    lfs_cfg->erase       = lfs_wa_bd_erase;
+    lfs_cfg->sync        = lfs_wa_bd_sync;
+
+#if defined(LFS_THREADSAFE)
+    lfs_cfg->lock        = lfs_wa_bd_lock;
+    lfs_cfg->unlock      = lfs_wa_bd_unlock;
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    /* Block device configuration */
+    lfs_cfg->read_size      = backing->read_size;
+    lfs_cfg->prog_size      = backing->prog_size;
+    lfs_cfg->block_size     = backing->block_size;
+    lfs_cfg->block_count    = backing->block_count;
+    lfs_cfg->block_cycles   = backing->block_cycles;
+    lfs_cfg->cache_size     = backing->cache_size;
+    lfs_cfg->lookahead_size = backing->lookahead_size;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void lfs_wa_bd_destroy(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    wa->op = LFS_WA_BD_OP_UNTAGGED;
+    wa->file = NULL;
+    wa->backing = NULL;
+}
+
+bool lfs_wa_bd_track(const struct lfs_config *lfs_cfg, const lfs_file_t *file, const char *path)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != file);
+    LFS_ASSERT(NULL != path);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    uint32_t open = _find_open(wa, file);
+    bool tracked = false;
+
+    if(LFS_WA_BD_MAX_OPEN == open)
+    {
+        open = _find_open(wa, NULL);
+    }
+
+    if(LFS_WA_BD_MAX_OPEN != open)
+    {
+        uint32_t slot = _find_name(wa, path);
+
+        if(LFS_WA_BD_MAX_FILES != slot)
+        {
+            wa->open_handles[open] = file;
+            wa->open_slots[open] = slot;
+            tracked = true;
+        }
+    }
+
+    return tracked;
+}
+
+void lfs_wa_bd_untrack(const struct lfs_config *lfs_cfg, const lfs_file_t *file)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != file);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    uint32_t open = _find_open(wa, file);
+
+    if(LFS_WA_BD_MAX_OPEN != open)
+    {
+        wa->open_handles[open] = NULL;
+    }
+}
+
+int lfs_wa_bd_begin(const struct lfs_config *lfs_cfg, lfs_wa_bd_op_t op, const lfs_file_t *file)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(op < LFS_WA_BD_OP_COUNT);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    uint32_t open = LFS_WA_BD_MAX_OPEN;
+    int32_t err = 0;
+
+#if defined(LFS_THREADSAFE)
+    /* Held until lfs_wa_bd_end() so the programs of other tasks are not
+     * attributed to this call.
+     */
+    err = lfs_wa_bd_lock(lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+
+    if(0 == err)
+    {
+        if(NULL != file)
+        {
+            open = _find_open(wa, file);
+        }
+
+        wa->op = op;
+        wa->file = (LFS_WA_BD_MAX_OPEN != open) ? &wa->files[wa->open_slots[open]].counters : NULL;
+    }
+
+    return err;
+}
+
+void lfs_wa_bd_end(const struct lfs_config *lfs_cfg, lfs_size_t logical_bytes)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+
+    wa->ops[wa->op].calls++;
+    wa->ops[wa->op].logical_bytes += logical_bytes;
+    if(NULL != wa->file)
+    {
+        wa->file->calls++;
+        wa->file->logical_bytes += logical_bytes;
+    }
+
+    wa->op = LFS_WA_BD_OP_UNTAGGED;
+    wa->file = NULL;
+
+#if defined(LFS_THREADSAFE)
+    (void)lfs_wa_bd_unlock(lfs_cfg);
+#endif /* #if defined(LFS_THREADSAFE) */
+}
+
+lfs_ssize_t lfs_wa_bd_file_write(const struct lfs_config *lfs_cfg, lfs_t *lfs, lfs_file_t *file,
+        const void *buffer, lfs_size_t size)
+{
+    lfs_ssize_t res = lfs_wa_bd_begin(lfs_cfg, LFS_WA_BD_OP_WRITE, file);
+
+    if(0 == res)
+    {
+        res = lfs_file_write(lfs, file, buffer, size);
+        lfs_wa_bd_end(lfs_cfg, (res > 0) ? (lfs_size_t)res : 0U);
+    }
+
+    return res;
+}
+
+int lfs_wa_bd_file_sync(const struct lfs_config *lfs_cfg, lfs_t *lfs, lfs_file_t *file)
+{
+    int32_t res = lfs_wa_bd_begin(lfs_cfg, LFS_WA_BD_OP_SYNC, file);
+
+    if(0 == res)
+    {
+        res = lfs_file_sync(lfs, file);
+        lfs_wa_bd_end(lfs_cfg, 0U);
+    }
+
+    return res;
+}
+
+int lfs_wa_bd_file_close(const struct lfs_config *lfs_cfg, lfs_t *lfs, lfs_file_t *file)
+{
+    int32_t res = lfs_wa_bd_begin(lfs_cfg, LFS_WA_BD_OP_SYNC, file);
+
+    if(0 == res)
+    {
+        res = lfs_file_close(lfs, file);
+        lfs_wa_bd_end(lfs_cfg, 0U);
+
+        /* The handle is released by lfs_file_close() even if it fails. */
+        lfs_wa_bd_untrack(lfs_cfg, file);
+    }
+
+    return res;
+}
+
+void lfs_wa_bd_get_op(const struct lfs_config *lfs_cfg, lfs_wa_bd_op_t op,
+        lfs_wa_bd_counters_t *counters)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(op < LFS_WA_BD_OP_COUNT);
+    LFS_ASSERT(NULL != counters);
+
+    *counters = _get_wa(lfs_cfg)->ops[op];
+}
+
+void lfs_wa_bd_get_total(const struct lfs_config *lfs_cfg, lfs_wa_bd_counters_t *counters)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != counters);
+
+    const lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+
+    (void)memset(counters, 0, sizeof(*counters));
+    for(uint32_t i = 0U; i < (uint32_t)LFS_WA_BD_OP_COUNT; i++)
+    {
+        _add(counters, &wa->ops[i]);
+    }
+}
+
+bool lfs_wa_bd_get_file(const struct lfs_config *lfs_cfg, uint32_t index,
+        lfs_wa_bd_file_stats_t *stats)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+    LFS_ASSERT(NULL != stats);
+
+    const lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    bool found = (index < wa->file_count);
+
+    if(found)
+    {
+        *stats = wa->files[index];
+    }
+
+    return found;
+}
+
+void lfs_wa_bd_reset(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    lfs_wa_bd_file_stats_t *files = wa->files;
+    uint32_t count = 0U;
+
+    (void)memset(wa->ops, 0, sizeof(wa->ops));
+
+    /* Keep the names of the tracked files, packed at the start of the table. */
+    for(uint32_t slot = 0U; slot < wa->file_count; slot++)
+    {
+        bool tracked = false;
+
+        for(uint32_t open = 0U; open < LFS_WA_BD_MAX_OPEN; open++)
+        {
+            if((NULL != wa->open_handles[open]) && (slot == wa->open_slots[open]))
+            {
+                wa->open_slots[open] = count;
+                tracked = true;
+            }
+        }
+
+        if(tracked)
+        {
+            (void)memmove(files[count].name, files[slot].name, LFS_WA_BD_NAME_SIZE);
+            count++;
+        }
+    }
+
+    (void)memset(&files[count], 0, (LFS_WA_BD_MAX_FILES - count) * sizeof(files[0]));
+    for(uint32_t slot = 0U; slot < count; slot++)
+    {
+        (void)memset(&files[slot].counters, 0, sizeof(files[slot].counters));
+    }
+    wa->file_count = count;
+}
+
+uint32_t lfs_wa_bd_prog_ratio(const lfs_wa_bd_counters_t *counters)
+{
+    LFS_ASSERT(NULL != counters);
+
+    return _ratio(counters->prog_bytes, counters->logical_bytes);
+}
+
+uint32_t lfs_wa_bd_erase_ratio(const lfs_wa_bd_counters_t *counters)
+{
+    LFS_ASSERT(NULL != counters);
+
+    return _ratio(counters->erased_bytes, counters->logical_bytes);
+}
+
+int lfs_wa_bd_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    const struct lfs_config *backing = _get_wa(lfs_cfg)->backing;
+    return backing->read(backing, block, off, buffer, size);
+}
+
+int lfs_wa_bd_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    int32_t res = wa->backing->prog(wa->backing, block, off, buffer, size);
+
+    /* Failed programs are counted too: the bytes may be partly programmed. */
+    wa->ops[wa->op].prog_bytes += size;
+    if(NULL != wa->file)
+    {
+        wa->file->prog_bytes += size;
+    }
+
+    return res;
+}
+
+int lfs_wa_bd_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    lfs_wa_bd_t *wa = _get_wa(lfs_cfg);
+    int32_t res = wa->backing->erase(wa->backing, block);
+
+    wa->ops[wa->op].erases++;
+    wa->ops[wa->op].erased_bytes += lfs_cfg->block_size;
+    if(NULL != wa->file)
+    {
+        wa->file->erases++;
+        wa->file->erased_bytes += lfs_cfg->block_size;
+    }
+
+    return res;
+}
+
+int lfs_wa_bd_sync(const struct lfs_config *lfs_cfg)
+{
+    LFS_ASSERT(NULL != lfs_cfg);
+
+    const struct lfs_config *backing = _get_wa(lfs_cfg)->backing;
+    return backing->sync(backing);
+}
+
+#if defined(LFS_THREADSAFE)
+
+int lfs_wa_bd_lock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_wa(lfs_cfg)->backing;
+    return backing->lock(backing);
+}
+
+int lfs_wa_bd_unlock(const struct lfs_config *lfs_cfg)
+{
+    const struct lfs_config *backing = _get_wa(lfs_cfg)->backing;
+    return backing->unlock(backing);
+}
+#endif /* #if defined(LFS_THREADSAFE) */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
@@ -0,0 +1,856 @@
+/***************************************************************************//**
+ * \file lfs_zlog.c
+ *
+ * \brief
+ * Compressed append-only log files on top of littlefs
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "lfs_zlog.h"
+#include "lfs_util.h"
+#include "cy_utils.h"
+#include <string.h>
+
+/* This block of code ignores violations of Directive 4.6 MISRA. */
+CY_MISRA_DEVIATE_BLOCK_START('MISRA C-2012 Directive 4.6',12,\
+'The third-party defines the function interface with basic numeral type')
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#if (LFS_ZLOG_CHUNK_SIZE < 16UL) || (LFS_ZLOG_CHUNK_SIZE > 32768UL)
+#error "LFS_ZLOG_CHUNK_SIZE must be in the range 16 to 32768"
+#endif
+
+/* Chunk header: raw size (2), stored size (2), CRC of the raw data (4) */
+#define HEADER_SIZE                                 (8UL)
+/* Index entry: raw offset of the chunk (4), offset in the data file (4) */
+#define INDEX_ENTRY_SIZE                            (8UL)
+#define HASH_SIZE                                   (1UL << LFS_ZLOG_HASH_BITS)
+#define HASH_MULTIPLIER                             (2654435761UL)
+#define CRC_INIT                                    (0xFFFFFFFFUL)
+
+/* Limits of the LZ4 block format */
+#define MIN_MATCH                                   (4UL)
+#define LAST_LITERALS                               (5UL)
+#define MATCH_FIND_LIMIT                            (12UL)
+#define RUN_MASK                                    (15UL)
+#define LENGTH_BYTE_MAX                             (255UL)
+
+static inline uint32_t _min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static inline void _put_le16(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)(value & 0xFFUL);
+    p[1] = (uint8_t)((value >> 8U) & 0xFFUL);
+}
+
+static inline void _put_le32(uint8_t *p, uint32_t value)
+{
+    _put_le16(p, value & 0xFFFFUL);
+    _put_le16(&p[2], value >> 16U);
+}
+
+static inline uint32_t _get_le16(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8U);
+}
+
+static inline uint32_t _get_le32(const uint8_t *p)
+{
+    return _get_le16(p) | (_get_le16(&p[2]) << 16U);
+}
+
+static inline uint32_t _hash(const uint8_t *p)
+{
+    return (uint32_t)(_get_le32(p) * HASH_MULTIPLIER) >> (32UL - LFS_ZLOG_HASH_BITS);
+}
+
+/* Number of bytes of a sequence with the given literal and match lengths. A
+ * match length of zero is the last sequence, which has no match.
+ */
+static uint32_t _sequence_size(uint32_t literal_len, uint32_t match_len)
+{
+    uint32_t size = 1UL + literal_len;
+
+    if(literal_len >= RUN_MASK)
+    {
+        size += ((literal_len - RUN_MASK) / LENGTH_BYTE_MAX) + 1UL;
+    }
+
+    if(0UL != match_len)
+    {
+        size += 2UL;
+        if((match_len - MIN_MATCH) >= RUN_MASK)
+        {
+            size += ((match_len - MIN_MATCH - RUN_MASK) / LENGTH_BYTE_MAX) + 1UL;
+        }
+    }
+
+    return size;
+}
+
+static uint32_t _put_length(uint8_t *dst, uint32_t op, uint32_t len)
+{
+    uint32_t pos = op;
+    uint32_t rest = len;
+
+    while(rest >= LENGTH_BYTE_MAX)
+    {
+        dst[pos] = (uint8_t)LENGTH_BYTE_MAX;
+        pos++;
+        rest -= LENGTH_BYTE_MAX;
+    }
+    dst[pos] = (uint8_t)rest;
+
+    return pos + 1UL;
+}
+
+/* Writes one sequence and returns the new output position. The space is
+ * checked by the caller with _sequence_size().
+ */
+static uint32_t _put_sequence(uint8_t *dst, uint32_t op, const uint8_t *literals,
+        uint32_t literal_len, uint32_t offset, uint32_t match_len)
+{
+    uint32_t pos = op;
+    uint32_t match_code = (0UL != match_len) ? _min(match_len - MIN_MATCH, RUN_MASK) : 0UL;
+
+    dst[pos] = (uint8_t)((_min(literal_len, RUN_MASK) << 4U) | match_code);
+    pos++;
+    if(literal_len >= RUN_MASK)
+    {
+        pos = _put_length(dst, pos, literal_len - RUN_MASK);
+    }
+    (void)memcpy(&dst[pos], literals, literal_len);
+    pos += literal_len;
+
+    if(0UL != match_len)
+    {
+        _put_le16(&dst[pos], offset);
+        pos += 2UL;
+        if(RUN_MASK == match_code)
+        {
+            pos = _put_length(dst, pos, match_len - MIN_MATCH - RUN_MASK);
+        }
+    }
+
+    return pos;
+}
+
+/* Compresses a chunk in the LZ4 block format with a greedy single-probe
+ * matcher. Returns the compressed size, or zero if the result would not be
+ * smaller than the input; the chunk is then stored as is.
+ */
+static uint32_t _compress(const uint8_t *src, uint32_t size, uint8_t *dst, uint16_t *table)
+{
+    uint32_t capacity = size - 1UL;
+    uint32_t ip = 0UL;
+    uint32_t anchor = 0UL;
+    uint32_t op = 0UL;
+    bool fits = true;
+
+    (void)memset(table, 0, HASH_SIZE * sizeof(uint16_t));
+
+    if(size > MATCH_FIND_LIMIT)
+    {
+        uint32_t limit = size - MATCH_FIND_LIMIT;
+
+        while(fits && (ip <= limit))
+        {
+            uint32_t hash = _hash(&src[ip]);
+            uint32_t ref = table[hash];
+
+            table[hash] = (uint16_t)ip;
+            if((ref < ip) && (0 == memcmp(&src[ref], &src[ip], MIN_MATCH)))
+            {
+                uint32_t len = MIN_MATCH;
+                uint32_t max_len = size - LAST_LITERALS - ip;
+
+                while((len < max_len) && (src[ref + len] == src[ip + len]))
+                {
+                    len++;
+                }
+
+                if((op + _sequence_size(ip - anchor, len)) > capacity)
+                {
+                    fits = false;
+                }
+                else
+                {
+                    op = _put_sequence(dst, op, &src[anchor], ip - anchor, ip - ref, len);
+                    ip += len;
+                    anchor = ip;
+                }
+            }
+            else
+            {
+                ip++;
+            }
+        }
+    }
+
+    if(fits && ((op + _sequence_size(size - anchor, 0UL)) <= capacity))
+    {
+        op = _put_sequence(dst, op, &src[anchor], size - anchor, 0UL, 0UL);
+    }
+    else
+    {
+        op = 0UL;
+    }
+
+    return op;
+}
+
+static bool _get_length(const uint8_t *src, uint32_t size, uint32_t *ip, uint32_t *len)
+{
+    bool valid = true;
+    uint32_t value = LENGTH_BYTE_MAX;
+
+    while(valid && (LENGTH_BYTE_MAX == value))
+    {
+        if(*ip < size)
+        {
+            value = src[*ip];
+            (*ip)++;
+            *len += value;
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+
+    return valid;
+}
+
+/* Decompresses a chunk. Returns true if the input is valid and decompresses
+ * to exactly raw_size bytes.
+ */
+static bool _decompress(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t raw_size)
+{
+    uint32_t ip = 0UL;
+    uint32_t op = 0UL;
+    bool valid = true;
+    bool last = false;
+
+    while(valid && !last && (ip < size))
+    {
+        uint32_t token = src[ip];
+        uint32_t literal_len = token >> 4U;
+        uint32_t match_len = token & RUN_MASK;
+        uint32_t offset;
+
+        ip++;
+        if(RUN_MASK == literal_len)
+        {
+            valid = _get_length(src, size, &ip, &literal_len);
+        }
+
+        if(valid && ((literal_len > (size - ip)) || (literal_len > (raw_size - op))))
+        {
+            valid = false;
+        }
+
+        if(valid)
+        {
+            (void)memcpy(&dst[op], &src[ip], literal_len);
+            ip += literal_len;
+            op += literal_len;
+            last = (ip == size);
+        }
+
+        if(valid && !last)
+        {
+            if((size - ip) < 2UL)
+            {
+                valid = false;
+            }
+            else
+            {
+                offset = _get_le16(&src[ip]);
+                ip += 2UL;
+                if(RUN_MASK == match_len)
+                {
+                    valid = _get_length(src, size, &ip, &match_len);
+                }
+                match_len += MIN_MATCH;
+
+                if(valid && ((0UL == offset) || (offset > op) || (match_len > (raw_size - op))))
+                {
+                    valid = false;
+                }
+
+                /* Byte by byte, as the match can overlap the output */
+                while(valid && (0UL != match_len))
+                {
+                    dst[op] = dst[op - offset];
+                    op++;
+                    match_len--;
+                }
+            }
+        }
+    }
+
+    return valid && last && (op == raw_size);
+}
+
+static int _read_at(lfs_t *lfs, lfs_file_t *file, uint32_t off, void *buffer, uint32_t size)
+{
+    int32_t err = 0;
+    lfs_soff_t pos = lfs_file_seek(lfs, file, (lfs_soff_t)off, LFS_SEEK_SET);
+    lfs_ssize_t read;
+
+    if(pos < 0)
+    {
+        err = (int32_t)pos;
+    }
+    else
+    {
+        read = lfs_file_read(lfs, file, buffer, size);
+        if(read < 0)
+        {
+            err = (int32_t)read;
+        }
+        else if((uint32_t)read != size)
+        {
+            err = LFS_ERR_CORRUPT;
+        }
+        else
+        {
+            /* Complete */
+        }
+    }
+
+    return err;
+}
+
+static int _write_all(lfs_t *lfs, lfs_file_t *file, const void *data, uint32_t size)
+{
+    int32_t err = 0;
+    lfs_ssize_t written = lfs_file_write(lfs, file, data, size);
+
+    if(written < 0)
+    {
+        err = (int32_t)written;
+    }
+    else if((uint32_t)written != size)
+    {
+        err = LFS_ERR_NOSPC;
+    }
+    else
+    {
+        /* Complete */
+    }
+
+    return err;
+}
+
+static int _read_index(lfs_zlog_t *log, uint32_t chunk, uint32_t *raw_offset, uint32_t *file_offset)
+{
+    uint8_t entry[INDEX_ENTRY_SIZE];
+    int32_t err = _read_at(log->lfs, &log->index, chunk * INDEX_ENTRY_SIZE, entry, INDEX_ENTRY_SIZE);
+
+    if(0 == err)
+    {
+        *raw_offset = _get_le32(entry);
+        *file_offset = _get_le32(&entry[4]);
+    }
+
+    return err;
+}
+
+static int _read_header(lfs_zlog_t *log, uint32_t file_offset, uint32_t *raw_size,
+        uint32_t *stored_size, uint32_t *crc)
+{
+    uint8_t header[HEADER_SIZE];
+    int32_t err = _read_at(log->lfs, &log->data, file_offset, header, HEADER_SIZE);
+
+    if(0 == err)
+    {
+        *raw_size = _get_le16(header);
+        *stored_size = _get_le16(&header[2]);
+        *crc = _get_le32(&header[4]);
+
+        if((0UL == *raw_size) || (*raw_size > LFS_ZLOG_CHUNK_SIZE) || (*stored_size > *raw_size))
+        {
+            err = LFS_ERR_CORRUPT;
+        }
+    }
+
+    return err;
+}
+
+/* Cuts both files back to the last complete chunk and moves their positions
+ * to the end. Removes what a failed or interrupted chunk write left behind.
+ */
+static int _trim_to_index(lfs_zlog_t *log)
+{
+    int32_t err = 0;
+    lfs_soff_t index_size = lfs_file_size(log->lfs, &log->index);
+    lfs_soff_t data_size = lfs_file_size(log->lfs, &log->data);
+
+    if(index_size < 0)
+    {
+        err = (int32_t)index_size;
+    }
+    else if((uint32_t)index_size != (log->chunk_count * INDEX_ENTRY_SIZE))
+    {
+        err = lfs_file_truncate(log->lfs, &log->index, log->chunk_count * INDEX_ENTRY_SIZE);
+    }
+    else
+    {
+        /* The index holds complete entries only */
+    }
+
+    if(0 != err)
+    {
+        /* Error already set */
+    }
+    else if(data_size < 0)
+    {
+        err = (int32_t)data_size;
+    }
+    else if((uint32_t)data_size != log->data_end)
+    {
+        err = lfs_file_truncate(log->lfs, &log->data, log->data_end);
+    }
+    else
+    {
+        /* The data file matches the index */
+    }
+
+    if(0 == err)
+    {
+        data_size = lfs_file_seek(log->lfs, &log->data, 0, LFS_SEEK_END);
+        index_size = lfs_file_seek(log->lfs, &log->index, 0, LFS_SEEK_END);
+        err = (data_size < 0) ? (int32_t)data_size : ((index_size < 0) ? (int32_t)index_size : 0);
+    }
+
+    log->trim_pending = (0 != err);
+
+    return err;
+}
+
+/* Restores the sizes from the last index entry. When appending, a partial
+ * index entry and data that is not covered by the index, both left by a power
+ * loss during a flush, are removed.
+ */
+static int _load_state(lfs_zlog_t *log)
+{
+    int32_t err = 0;
+    lfs_soff_t index_size = lfs_file_size(log->lfs, &log->index);
+    uint32_t raw_offset;
+    uint32_t file_offset;
+    uint32_t raw_size;
+    uint32_t stored_size;
+    uint32_t crc;
+
+    if(index_size < 0)
+    {
+        err = (int32_t)index_size;
+    }
+    else
+    {
+        log->chunk_count = (uint32_t)index_size / INDEX_ENTRY_SIZE;
+        if(0UL != log->chunk_count)
+        {
+            err = _read_index(log, log->chunk_count - 1UL, &raw_offset, &file_offset);
+            if(0 == err)
+            {
+                err = _read_header(log, file_offset, &raw_size, &stored_size, &crc);
+            }
+            if(0 == err)
+            {
+                log->raw_total = raw_offset + raw_size;
+                log->data_end = file_offset + HEADER_SIZE + stored_size;
+            }
+        }
+    }
+
+    if((0 == err) && (LFS_ZLOG_APPEND == log->mode))
+    {
+        err = _trim_to_index(log);
+    }
+
+    return err;
+}
+
+/* The data is written and synced before the index entry, so that a chunk in
+ * the index is always complete in the data file.
+ */
+static int _write_chunk(lfs_zlog_t *log)
+{
+    uint8_t header[HEADER_SIZE];
+    uint8_t entry[INDEX_ENTRY_SIZE];
+    uint32_t stored_size = _compress(log->raw, log->raw_fill, log->packed, log->hash);
+    const uint8_t *payload = log->packed;
+    int32_t err;
+
+    if(0UL == stored_size)
+    {
+        stored_size = log->raw_fill;
+        payload = log->raw;
+    }
+
+    _put_le16(header, log->raw_fill);
+    _put_le16(&header[2], stored_size);
+    _put_le32(&header[4], lfs_crc(CRC_INIT, log->raw, log->raw_fill));
+    _put_le32(entry, log->raw_total);
+    _put_le32(&entry[4], log->data_end);
+
+    /* A failed write, for example LFS_ERR_NOSPC, can leave part of a chunk
+     * or of an entry in the files. It is removed before the chunk is written
+     * again, so the index entry points at the chunk.
+     */
+    err = log->trim_pending ? _trim_to_index(log) : 0;
+    if(0 == err)
+    {
+        err = _write_all(log->lfs, &log->data, header, HEADER_SIZE);
+    }
+    if(0 == err)
+    {
+        err = _write_all(log->lfs, &log->data, payload, stored_size);
+    }
+    if(0 == err)
+    {
+        err = lfs_file_sync(log->lfs, &log->data);
+    }
+    if(0 == err)
+    {
+        err = _write_all(log->lfs, &log->index, entry, INDEX_ENTRY_SIZE);
+    }
+
+    if(0 == err)
+    {
+        log->data_end += HEADER_SIZE + stored_size;
+        log->raw_total += log->raw_fill;
+        log->chunk_count++;
+        log->raw_fill = 0UL;
+    }
+    else if(!log->trim_pending)
+    {
+        /* If the files cannot be cut back now, the next write retries. */
+        (void)_trim_to_index(log);
+    }
+    else
+    {
+        /* The files could not be cut back before the write */
+    }
+
+    return err;
+}
+
+/* Finds the last chunk that starts at or before the position. */
+static int _find_chunk(lfs_zlog_t *log, uint32_t pos, uint32_t *chunk)
+{
+    int32_t err = 0;
+    uint32_t low = 0UL;
+    uint32_t high = log->chunk_count - 1UL;
+    uint32_t raw_offset;
+    uint32_t file_offset;
+
+    while((0 == err) && (low < high))
+    {
+        uint32_t mid = low + (((high - low) + 1UL) / 2UL);
+
+        err = _read_index(log, mid, &raw_offset, &file_offset);
+        if(0 == err)
+        {
+            if(raw_offset <= pos)
+            {
+                low = mid;
+            }
+            else
+            {
+                high = mid - 1UL;
+            }
+        }
+    }
+    *chunk = low;
+
+    return err;
+}
+
+/* Loads and decompresses the chunk that contains the read position. */
+static int _load_chunk(lfs_zlog_t *log)
+{
+    int32_t err = 0;
+    uint32_t chunk = 0UL;
+    uint32_t raw_offset = 0UL;
+    uint32_t file_offset = 0UL;
+    uint32_t raw_size = 0UL;
+    uint32_t stored_size = 0UL;
+    uint32_t crc = 0UL;
+
+    /* A sequential read continues with the next chunk without a search */
+    if(log->loaded && (log->pos == (log->loaded_start + log->loaded_size)))
+    {
+        chunk = log->loaded_chunk + 1UL;
+    }
+    else
+    {
+        err = _find_chunk(log, log->pos, &chunk);
+    }
+    log->loaded = false;
+
+    if(0 == err)
+    {
+        err = _read_index(log, chunk, &raw_offset, &file_offset);
+    }
+    if(0 == err)
+    {
+        err = _read_header(log, file_offset, &raw_size, &stored_size, &crc);
+    }
+    if((0 == err) && ((log->pos < raw_offset) || (log->pos >= (raw_offset + raw_size))))
+    {
+        err = LFS_ERR_CORRUPT;
+    }
+
+    if(0 == err)
+    {
+        if(stored_size < raw_size)
+        {
+            err = _read_at(log->lfs, &log->data, file_offset + HEADER_SIZE, log->packed, stored_size);
+            if((0 == err) && !_decompress(log->packed, stored_size, log->raw, raw_size))
+            {
+                err = LFS_ERR_CORRUPT;
+            }
+        }
+        else
+        {
+            err = _read_at(log->lfs, &log->data, file_offset + HEADER_SIZE, log->raw, raw_size);
+        }
+    }
+
+    if((0 == err) && (crc != lfs_crc(CRC_INIT, log->raw, raw_size)))
+    {
+        err = LFS_ERR_CORRUPT;
+    }
+
+    if(0 == err)
+    {
+        log->loaded = true;
+        log->loaded_chunk = chunk;
+        log->loaded_start = raw_offset;
+        log->loaded_size = raw_size;
+    }
+
+    return err;
+}
+
+int lfs_zlog_open(lfs_t *lfs, lfs_zlog_t *log, const char *data_path, const char *index_path,
+        lfs_zlog_mode_t mode, void *work_buffer)
+{
+    int32_t err;
+    int32_t flags = (LFS_ZLOG_APPEND == mode) ? ((int32_t)LFS_O_RDWR | (int32_t)LFS_O_CREAT) : (int32_t)LFS_O_RDONLY;
+
+    LFS_ASSERT(NULL != lfs);
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(NULL != data_path);
+    LFS_ASSERT(NULL != index_path);
+    LFS_ASSERT(NULL != work_buffer);
+
+    (void)memset(log, 0, sizeof(*log));
+    log->lfs = lfs;
+    log->mode = mode;
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The work buffer is documented to be word-aligned and LFS_ZLOG_WORK_BUFFER_SIZE bytes long.');
+    log->hash = (uint16_t *)work_buffer;
+    log->raw = (uint8_t *)&log->hash[HASH_SIZE];
+    log->packed = &log->raw[LFS_ZLOG_CHUNK_SIZE];
+
+    err = lfs_file_open(lfs, &log->data, data_path, flags);
+    if(0 == err)
+    {
+        err = lfs_file_open(lfs, &log->index, index_path, flags);
+        if(0 == err)
+        {
+            err = _load_state(log);
+            if(0 != err)
+            {
+                (void)lfs_file_close(lfs, &log->index);
+            }
+        }
+
+        if(0 != err)
+        {
+            (void)lfs_file_close(lfs, &log->data);
+        }
+    }
+
+    return err;
+}
+
+lfs_ssize_t lfs_zlog_write(lfs_zlog_t *log, const void *data, lfs_size_t size)
+{
+    int32_t err = 0;
+    uint32_t done = 0UL;
+    uint32_t count;
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The data is read as bytes.');
+    const uint8_t *src = (const uint8_t *)data;
+
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(LFS_ZLOG_APPEND == log->mode);
+    LFS_ASSERT((NULL != data) || (0U == size));
+
+    while((0 == err) && (done < size))
+    {
+        count = _min(size - done, LFS_ZLOG_CHUNK_SIZE - log->raw_fill);
+        (void)memcpy(&log->raw[log->raw_fill], &src[done], count);
+        log->raw_fill += count;
+        done += count;
+
+        if(LFS_ZLOG_CHUNK_SIZE == log->raw_fill)
+        {
+            err = _write_chunk(log);
+            if(0 != err)
+            {
+                /* The bytes of this call that did not reach the files are
+                 * given back, so the caller can retry them.
+                 */
+                log->raw_fill -= count;
+                done -= count;
+            }
+        }
+    }
+
+    return ((0 == err) || (0UL != done)) ? (lfs_ssize_t)done : err;
+}
+
+int lfs_zlog_flush(lfs_zlog_t *log)
+{
+    int32_t err = 0;
+
+    LFS_ASSERT(NULL != log);
+
+    if(LFS_ZLOG_APPEND == log->mode)
+    {
+        if(0UL != log->raw_fill)
+        {
+            err = _write_chunk(log);
+        }
+        if(0 == err)
+        {
+            err = lfs_file_sync(log->lfs, &log->index);
+        }
+    }
+
+    return err;
+}
+
+int lfs_zlog_close(lfs_zlog_t *log)
+{
+    int32_t err;
+    int32_t close_err;
+
+    LFS_ASSERT(NULL != log);
+
+    err = lfs_zlog_flush(log);
+
+    close_err = lfs_file_close(log->lfs, &log->index);
+    err = (0 == err) ? close_err : err;
+    close_err = lfs_file_close(log->lfs, &log->data);
+    err = (0 == err) ? close_err : err;
+
+    return err;
+}
+
+lfs_ssize_t lfs_zlog_read(lfs_zlog_t *log, void *buffer, lfs_size_t size)
+{
+    int32_t err = 0;
+    uint32_t done = 0UL;
+    uint32_t count;
+CY_MISRA_DEVIATE_LINE('MISRA C-2012 Rule 11.5', 'The buffer is written as bytes.');
+    uint8_t *dst = (uint8_t *)buffer;
+
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(LFS_ZLOG_READ == log->mode);
+    LFS_ASSERT((NULL != buffer) || (0U == size));
+
+    while((0 == err) && (done < size) && (log->pos < log->raw_total))
+    {
+        if(!log->loaded || (log->pos < log->loaded_start) ||
+                (log->pos >= (log->loaded_start + log->loaded_size)))
+        {
+            err = _load_chunk(log);
+        }
+
+        if(0 == err)
+        {
+            count = _min(size - done, (log->loaded_start + log->loaded_size) - log->pos);
+            (void)memcpy(&dst[done], &log->raw[log->pos - log->loaded_start], count);
+            done += count;
+            log->pos += count;
+        }
+    }
+
+    return (0 == err) ? (lfs_ssize_t)done : err;
+}
+
+lfs_soff_t lfs_zlog_seek(lfs_zlog_t *log, lfs_off_t off)
+{
+    LFS_ASSERT(NULL != log);
+
+    log->pos = _min(off, log->raw_total);
+
+    return (lfs_soff_t)log->pos;
+}
+
+lfs_soff_t lfs_zlog_size(const lfs_zlog_t *log)
+{
+    LFS_ASSERT(NULL != log);
+
+    return (lfs_soff_t)(log->raw_total + log->raw_fill);
+}
+
+void lfs_zlog_get_stats(const lfs_zlog_t *log, lfs_zlog_stats_t *stats)
+{
+    LFS_ASSERT(NULL != log);
+    LFS_ASSERT(NULL != stats);
+
+    stats->raw_bytes = log->raw_total;
+    stats->stored_bytes = log->data_end + (log->chunk_count * INDEX_ENTRY_SIZE);
+    stats->chunks = log->chunk_count;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+CY_MISRA_BLOCK_END('MISRA C-2012 Directive 4.6')
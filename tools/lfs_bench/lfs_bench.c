@@ -0,0 +1,682 @@
+/***************************************************************************//**
+ * \file lfs_bench.c
+ *
+ * \brief
+ * Host tool that measures littlefs configurations on a simulated memory
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Measures littlefs configurations on a simulated memory. Each combination of
+ * block size, cache size, lookahead size and block cycles runs a set of
+ * workloads on a freshly formatted filesystem. The time of the memory is
+ * computed from a timing model, so the results do not depend on the host.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_bd_geometry.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ERASED_VALUE                                (0xFFU)
+#define MAX_VALUES                                  (16U)
+#define LOG_RECORD_SIZE                             (64U)
+#define LOG_RECORDS                                 (2000U)
+#define LOG_SYNC_INTERVAL                           (16U)
+#define SMALL_FILES                                 (100U)
+#define SMALL_REWRITES                              (300U)
+#define SMALL_MIN_SIZE                              (16U)
+#define SMALL_MAX_SIZE                              (1024U)
+#define SEQ_FILE_SIZE                               (256UL * 1024UL)
+#define SEQ_CHUNK_SIZE                              (4096U)
+#define DIR_FILES                                   (200U)
+#define DIR_FILE_SIZE                               (32U)
+
+/* Timing model of the memory, in nanoseconds */
+typedef struct
+{
+    uint64_t read_setup_ns;    /* Per read command */
+    uint64_t read_byte_ns;     /* Per byte read */
+    uint64_t prog_page_ns;     /* Per program page */
+    uint64_t erase_base_ns;    /* Per erase */
+    uint64_t erase_kb_ns;      /* Per KB erased */
+} timing_t;
+
+/* Simulated NOR memory */
+typedef struct
+{
+    uint8_t *mem;
+    lfs_size_t page_size;
+    const timing_t *timing;
+    uint64_t time_ns;
+    uint64_t read_bytes;
+    uint64_t prog_bytes;
+    uint64_t erases;
+    uint64_t bad_progs;        /* Programs of bits that were not erased */
+} sim_t;
+
+/* Results of one workload */
+typedef struct
+{
+    uint64_t ops;
+    uint64_t written;
+    uint64_t read;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t op_start_ns;
+} result_t;
+
+typedef struct
+{
+    const char *name;
+    int (*run)(lfs_t *lfs, sim_t *sim, result_t *result, uint32_t scale);
+} workload_t;
+
+typedef struct
+{
+    long values[MAX_VALUES];
+    uint32_t count;
+} list_t;
+
+static uint32_t rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, so the workloads are the same for every configuration */
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static int _sim_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    sim_t *sim = lfs_cfg->context;
+
+    memcpy(buffer, &sim->mem[(size_t)block * lfs_cfg->block_size + off], size);
+    sim->time_ns += sim->timing->read_setup_ns + (sim->timing->read_byte_ns * size);
+    sim->read_bytes += size;
+    return 0;
+}
+
+static int _sim_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    sim_t *sim = lfs_cfg->context;
+    uint8_t *dest = &sim->mem[(size_t)block * lfs_cfg->block_size + off];
+    const uint8_t *src = buffer;
+
+    for(lfs_size_t i = 0U; i < size; i++)
+    {
+        /* NOR programming only clears bits */
+        if((src[i] & dest[i]) != src[i])
+        {
+            sim->bad_progs++;
+        }
+        dest[i] &= src[i];
+    }
+
+    /* Each page touched by the range is a program command */
+    lfs_size_t pages = ((off + size - 1U) / sim->page_size) - (off / sim->page_size) + 1U;
+    sim->time_ns += sim->timing->prog_page_ns * pages;
+    sim->prog_bytes += size;
+    return 0;
+}
+
+static int _sim_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    sim_t *sim = lfs_cfg->context;
+
+    memset(&sim->mem[(size_t)block * lfs_cfg->block_size], ERASED_VALUE, lfs_cfg->block_size);
+    sim->time_ns += sim->timing->erase_base_ns +
+                    (sim->timing->erase_kb_ns * (lfs_cfg->block_size / 1024U));
+    sim->erases++;
+    return 0;
+}
+
+static int _sim_sync(const struct lfs_config *lfs_cfg)
+{
+    (void)lfs_cfg;
+    return 0;
+}
+
+static void _op_begin(const sim_t *sim, result_t *result)
+{
+    result->op_start_ns = sim->time_ns;
+}
+
+static void _op_end(const sim_t *sim, result_t *result)
+{
+    uint64_t op_ns = sim->time_ns - result->op_start_ns;
+
+    result->ops++;
+    result->total_ns += op_ns;
+    if(op_ns > result->max_ns)
+    {
+        result->max_ns = op_ns;
+    }
+}
+
+static void _fill(uint8_t *buffer, lfs_size_t size)
+{
+    for(lfs_size_t i = 0U; i < size; i++)
+    {
+        buffer[i] = (uint8_t)_rand();
+    }
+}
+
+/* Appends records to one file and syncs it periodically */
+static int _run_append_log(lfs_t *lfs, sim_t *sim, result_t *result, uint32_t scale)
+{
+    uint8_t record[LOG_RECORD_SIZE];
+    lfs_file_t file;
+    int err = lfs_file_open(lfs, &file, "log", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
+
+    for(uint32_t i = 0U; (0 == err) && (i < (LOG_RECORDS * scale)); i++)
+    {
+        _fill(record, sizeof(record));
+        _op_begin(sim, result);
+
+        lfs_ssize_t written = lfs_file_write(lfs, &file, record, sizeof(record));
+        err = (written < 0) ? (int)written : 0;
+        if((0 == err) && (0U == ((i + 1U) % LOG_SYNC_INTERVAL)))
+        {
+            err = lfs_file_sync(lfs, &file);
+        }
+
+        _op_end(sim, result);
+        result->written += sizeof(record);
+    }
+
+    if(0 == err)
+    {
+        err = lfs_file_close(lfs, &file);
+    }
+    return err;
+}
+
+static int _write_file(lfs_t *lfs, const char *path, const uint8_t *data, lfs_size_t size)
+{
+    lfs_file_t file;
+    int err = lfs_file_open(lfs, &file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+
+    if(0 == err)
+    {
+        lfs_ssize_t written = lfs_file_write(lfs, &file, data, size);
+        err = (written < 0) ? (int)written : 0;
+
+        int close_err = lfs_file_close(lfs, &file);
+        err = (0 == err) ? close_err : err;
+    }
+    return err;
+}
+
+/* Creates small files of random sizes, then rewrites random ones */
+static int _run_small_files(lfs_t *lfs, sim_t *sim, result_t *result, uint32_t scale)
+{
+    uint8_t data[SMALL_MAX_SIZE];
+    uint32_t files = SMALL_FILES * scale;
+    int err = 0;
+
+    for(uint32_t i = 0U; (0 == err) && (i < (files + (SMALL_REWRITES * scale))); i++)
+    {
+        char path[16];
+        uint32_t index = (i < files) ? i : (_rand() % files);
+        lfs_size_t size = SMALL_MIN_SIZE + (_rand() % (SMALL_MAX_SIZE - SMALL_MIN_SIZE + 1U));
+
+        (void)snprintf(path, sizeof(path), "f%05u", (unsigned)index);
+        _fill(data, size);
+
+        _op_begin(sim, result);
+        err = _write_file(lfs, path, data, size);
+        _op_end(sim, result);
+        result->written += size;
+    }
+    return err;
+}
+
+/* Reads a large file in chunks. Writing the file is not measured. */
+static int _run_seq_read(lfs_t *lfs, sim_t *sim, result_t *result, uint32_t scale)
+{
+    static uint8_t chunk[SEQ_CHUNK_SIZE];
+    lfs_size_t size = SEQ_FILE_SIZE * scale;
+    lfs_file_t file;
+    int err = lfs_file_open(lfs, &file, "big", LFS_O_WRONLY | LFS_O_CREAT);
+
+    for(lfs_size_t done = 0U; (0 == err) && (done < size); done += sizeof(chunk))
+    {
+        _fill(chunk, sizeof(chunk));
+        lfs_ssize_t written = lfs_file_write(lfs, &file, chunk, sizeof(chunk));
+        err = (written < 0) ? (int)written : 0;
+    }
+    if(0 == err)
+    {
+        err = lfs_file_close(lfs, &file);
+    }
+
+    sim->time_ns = 0U;
+    sim->read_bytes = 0U;
+    sim->prog_bytes = 0U;
+    sim->erases = 0U;
+
+    if(0 == err)
+    {
+        err = lfs_file_open(lfs, &file, "big", LFS_O_RDONLY);
+    }
+    for(lfs_size_t done = 0U; (0 == err) && (done < size); done += sizeof(chunk))
+    {
+        _op_begin(sim, result);
+        lfs_ssize_t read = lfs_file_read(lfs, &file, chunk, sizeof(chunk));
+        _op_end(sim, result);
+
+        err = (read < 0) ? (int)read : (((lfs_size_t)read == sizeof(chunk)) ? 0 : LFS_ERR_CORRUPT);
+        result->read += sizeof(chunk);
+    }
+    if(0 == err)
+    {
+        err = lfs_file_close(lfs, &file);
+    }
+    return err;
+}
+
+/* Creates many files in one directory, then lists it and finds each file */
+static int _run_many_files(lfs_t *lfs, sim_t *sim, result_t *result, uint32_t scale)
+{
+    uint8_t data[DIR_FILE_SIZE];
+    uint32_t files = DIR_FILES * scale;
+    int err = lfs_mkdir(lfs, "dir");
+
+    for(uint32_t i = 0U; (0 == err) && (i < files); i++)
+    {
+        char path[32];
+
+        (void)snprintf(path, sizeof(path), "dir/entry%05u", (unsigned)i);
+        _fill(data, sizeof(data));
+
+        _op_begin(sim, result);
+        err = _write_file(lfs, path, data, sizeof(data));
+        _op_end(sim, result);
+        result->written += sizeof(data);
+    }
+
+    lfs_dir_t dir;
+    struct lfs_info info;
+    if(0 == err)
+    {
+        err = lfs_dir_open(lfs, &dir, "dir");
+    }
+    if(0 == err)
+    {
+        int res;
+        do
+        {
+            _op_begin(sim, result);
+            res = lfs_dir_read(lfs, &dir, &info);
+            _op_end(sim, result);
+        } while(res > 0);
+
+        err = (res < 0) ? res : lfs_dir_close(lfs, &dir);
+    }
+
+    for(uint32_t i = 0U; (0 == err) && (i < files); i++)
+    {
+        char path[32];
+
+        (void)snprintf(path, sizeof(path), "dir/entry%05u", (unsigned)(_rand() % files));
+        _op_begin(sim, result);
+        err = lfs_stat(lfs, path, &info);
+        _op_end(sim, result);
+    }
+    return err;
+}
+
+static const workload_t workloads[] =
+{
+    { "append-log",  _run_append_log  },
+    { "small-files", _run_small_files },
+    { "seq-read",    _run_seq_read    },
+    { "many-files",  _run_many_files  },
+};
+
+#define WORKLOAD_COUNT                              (sizeof(workloads) / sizeof(workloads[0]))
+
+static int _parse_list(const char *text, list_t *list)
+{
+    const char *p = text;
+
+    list->count = 0U;
+    while('\0' != *p)
+    {
+        char *end;
+        long value = strtol(p, &end, 0);
+
+        if((end == p) || (list->count == MAX_VALUES) || ((',' != *end) && ('\0' != *end)))
+        {
+            fprintf(stderr, "invalid list: %s\n", text);
+            return -1;
+        }
+        list->values[list->count++] = value;
+        p = (',' == *end) ? (end + 1) : end;
+    }
+    return (0U == list->count) ? -1 : 0;
+}
+
+static int _parse_u64(const char *text, uint64_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 0);
+
+    if((end == text) || ('\0' != *end))
+    {
+        fprintf(stderr, "invalid number: %s\n", text);
+        return -1;
+    }
+    *value = parsed;
+    return 0;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "\n"
+        "Memory:\n"
+        "  --prog-size N          program (page) size in bytes (default 256)\n"
+        "  --size N               size of the region used by littlefs in bytes\n"
+        "                         (default 0x400000)\n"
+        "  --read-setup-ns N      time of a read command (default 1000)\n"
+        "  --read-byte-ns N       time per byte read (default 20)\n"
+        "  --prog-page-ns N       time to program a page (default 400000)\n"
+        "  --erase-base-ns N      fixed time of an erase (default 30000000)\n"
+        "  --erase-kb-ns N        time per KB erased (default 2000000)\n"
+        "\n"
+        "Sweep, as comma-separated lists:\n"
+        "  --block-sizes L        erase sizes in bytes (default 4096,65536)\n"
+        "  --cache-sizes L        cache sizes in bytes (default 256,512,1024,4096)\n"
+        "  --lookahead-sizes L    lookahead sizes in bytes (default 16,64,256)\n"
+        "  --block-cycles L       block cycles, -1 disables wear leveling\n"
+        "                         (default 100,512,-1)\n"
+        "\n"
+        "  --workloads L          subset of append-log,small-files,seq-read,many-files\n"
+        "  --scale N              multiplies the amount of work (default 1)\n"
+        "  --seed N               seed of the random data (default 1)\n"
+        "\n"
+        "Numbers can be given in decimal or with a 0x prefix.\n", name);
+}
+
+static uint32_t _select_workloads(const char *text)
+{
+    uint32_t mask = 0U;
+    char copy[256];
+
+    (void)snprintf(copy, sizeof(copy), "%s", text);
+    for(char *name = strtok(copy, ","); NULL != name; name = strtok(NULL, ","))
+    {
+        uint32_t i = 0U;
+        while((i < WORKLOAD_COUNT) && (0 != strcmp(name, workloads[i].name)))
+        {
+            i++;
+        }
+        if(i == WORKLOAD_COUNT)
+        {
+            fprintf(stderr, "unknown workload: %s\n", name);
+            return 0U;
+        }
+        mask |= 1UL << i;
+    }
+    return mask;
+}
+
+/* RAM used by littlefs with one open file: the read and program caches, the
+ * cache of the file and the lookahead buffer, plus the lfs_t and lfs_file_t
+ * structures.
+ */
+static size_t _ram_used(const struct lfs_config *cfg)
+{
+    return (3U * cfg->cache_size) + cfg->lookahead_size + sizeof(lfs_t) + sizeof(lfs_file_t);
+}
+
+static int _run(const struct lfs_config *base, sim_t *sim, size_t mem_size,
+        const workload_t *workload, uint32_t scale, uint32_t seed)
+{
+    struct lfs_config cfg = *base;
+    result_t result;
+    lfs_t lfs;
+
+    memset(&result, 0, sizeof(result));
+    memset(sim->mem, ERASED_VALUE, mem_size);
+    rand_state = seed;
+
+    int err = lfs_format(&lfs, &cfg);
+    if(0 == err)
+    {
+        err = lfs_mount(&lfs, &cfg);
+    }
+    if(0 == err)
+    {
+        sim->time_ns = 0U;
+        sim->read_bytes = 0U;
+        sim->prog_bytes = 0U;
+        sim->erases = 0U;
+        sim->bad_progs = 0U;
+
+        err = workload->run(&lfs, sim, &result, scale);
+
+        int unmount_err = lfs_unmount(&lfs);
+        err = (0 == err) ? unmount_err : err;
+    }
+
+    double seconds = (double)sim->time_ns / 1e9;
+    double bytes = (double)(result.written + result.read);
+
+    printf("%s,%u,%u,%u,%d,%zu,%llu,%llu,%llu,%.3f,%.1f,%.1f,%.1f,%llu,%llu,%.2f,%llu,%d\n",
+           workload->name, (unsigned)cfg.block_size, (unsigned)cfg.cache_size,
+           (unsigned)cfg.lookahead_size, (int)cfg.block_cycles, _ram_used(&cfg),
+           (unsigned long long)result.ops, (unsigned long long)result.written,
+           (unsigned long long)result.read, (double)sim->time_ns / 1e6,
+           (seconds > 0.0) ? (bytes / 1024.0 / seconds) : 0.0,
+           (result.ops > 0U) ? ((double)result.total_ns / 1e3 / (double)result.ops) : 0.0,
+           (double)result.max_ns / 1e3,
+           (unsigned long long)sim->prog_bytes, (unsigned long long)sim->erases,
+           (result.written > 0U) ? ((double)sim->prog_bytes / (double)result.written) : 0.0,
+           (unsigned long long)sim->bad_progs, err);
+
+    return err;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option options[] =
+    {
+        { "prog-size",       required_argument, NULL, 'p' },
+        { "size",            required_argument, NULL, 's' },
+        { "read-setup-ns",   required_argument, NULL, 'r' },
+        { "read-byte-ns",    required_argument, NULL, 'b' },
+        { "prog-page-ns",    required_argument, NULL, 'g' },
+        { "erase-base-ns",   required_argument, NULL, 'e' },
+        { "erase-kb-ns",     required_argument, NULL, 'k' },
+        { "block-sizes",     required_argument, NULL, 'B' },
+        { "cache-sizes",     required_argument, NULL, 'C' },
+        { "lookahead-sizes", required_argument, NULL, 'L' },
+        { "block-cycles",    required_argument, NULL, 'Y' },
+        { "workloads",       required_argument, NULL, 'w' },
+        { "scale",           required_argument, NULL, 'x' },
+        { "seed",            required_argument, NULL, 'd' },
+        { "help",            no_argument,       NULL, 'h' },
+        { NULL,              0,                 NULL, 0   }
+    };
+    timing_t timing = { 1000U, 20U, 400000U, 30000000U, 2000000U };
+    uint64_t prog_size = 256U;
+    uint64_t mem_size = 0x400000U;
+    uint64_t scale = 1U;
+    uint64_t seed = 1U;
+    list_t block_sizes = { { 4096, 65536 }, 2U };
+    list_t cache_sizes = { { 256, 512, 1024, 4096 }, 4U };
+    list_t lookahead_sizes = { { 16, 64, 256 }, 3U };
+    list_t block_cycles = { { 100, 512, -1 }, 3U };
+    uint32_t selected = (1UL << WORKLOAD_COUNT) - 1U;
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", options, NULL)))
+    {
+        int res = 0;
+
+        switch(opt)
+        {
+            case 'p': res = _parse_u64(optarg, &prog_size); break;
+            case 's': res = _parse_u64(optarg, &mem_size); break;
+            case 'r': res = _parse_u64(optarg, &timing.read_setup_ns); break;
+            case 'b': res = _parse_u64(optarg, &timing.read_byte_ns); break;
+            case 'g': res = _parse_u64(optarg, &timing.prog_page_ns); break;
+            case 'e': res = _parse_u64(optarg, &timing.erase_base_ns); break;
+            case 'k': res = _parse_u64(optarg, &timing.erase_kb_ns); break;
+            case 'B': res = _parse_list(optarg, &block_sizes); break;
+            case 'C': res = _parse_list(optarg, &cache_sizes); break;
+            case 'L': res = _parse_list(optarg, &lookahead_sizes); break;
+            case 'Y': res = _parse_list(optarg, &block_cycles); break;
+            case 'w': selected = _select_workloads(optarg); res = (0U == selected) ? -1 : 0; break;
+            case 'x': res = _parse_u64(optarg, &scale); break;
+            case 'd': res = _parse_u64(optarg, &seed); break;
+            case 'h': _usage(argv[0]); return EXIT_SUCCESS;
+            default: res = -1; break;
+        }
+        if(0 != res)
+        {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if((optind != argc) || (0U == prog_size) || (0U == mem_size) || (0U == scale) ||
+       (0U == (uint32_t)seed) || (mem_size > 0xFFFFFFFFU))
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    sim_t sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.mem = malloc(mem_size);
+    sim.page_size = (lfs_size_t)prog_size;
+    sim.timing = &timing;
+    if(NULL == sim.mem)
+    {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("workload,block_size,cache_size,lookahead_size,block_cycles,ram_bytes,"
+           "ops,written_bytes,read_bytes,device_ms,throughput_kbps,mean_latency_us,"
+           "max_latency_us,prog_bytes,erases,write_amp,bad_progs,error\n");
+
+    int failures = 0;
+    for(uint32_t b = 0U; b < block_sizes.count; b++)
+    {
+        lfs_size_t block_size = (lfs_size_t)block_sizes.values[b];
+
+        if((block_sizes.values[b] <= 0) || (0U != (block_size % prog_size)) ||
+           (0U != (mem_size % block_size)))
+        {
+            fprintf(stderr, "skipped block size %ld: not a multiple of the program size "
+                            "or not a divisor of the size\n", block_sizes.values[b]);
+            continue;
+        }
+
+        /* The configuration of lfs_spi_flash_bd_create(); the swept fields
+         * are replaced below.
+         */
+        struct lfs_config cfg;
+        memset(&cfg, 0, sizeof(cfg));
+        lfs_spi_flash_bd_set_geometry(&cfg, (lfs_size_t)prog_size, block_size,
+                                      (lfs_size_t)(mem_size / block_size));
+        cfg.context = &sim;
+        cfg.read    = _sim_read;
+        cfg.prog    = _sim_prog;
+        cfg.erase   = _sim_erase;
+        cfg.sync    = _sim_sync;
+
+        for(uint32_t c = 0U; c < cache_sizes.count; c++)
+        {
+            lfs_size_t cache_size = (lfs_size_t)cache_sizes.values[c];
+
+            if((cache_sizes.values[c] <= 0) || (0U != (cache_size % prog_size)) ||
+               (0U != (block_size % cache_size)))
+            {
+                fprintf(stderr, "skipped cache size %ld with block size %u: must be a multiple "
+                                "of the program size and a divisor of the block size\n",
+                        cache_sizes.values[c], (unsigned)block_size);
+                continue;
+            }
+            cfg.cache_size = cache_size;
+
+            for(uint32_t l = 0U; l < lookahead_sizes.count; l++)
+            {
+                if((lookahead_sizes.values[l] <= 0) || (0 != (lookahead_sizes.values[l] % 8)))
+                {
+                    fprintf(stderr, "skipped lookahead size %ld: not a multiple of 8\n",
+                            lookahead_sizes.values[l]);
+                    continue;
+                }
+                cfg.lookahead_size = (lfs_size_t)lookahead_sizes.values[l];
+
+                for(uint32_t y = 0U; y < block_cycles.count; y++)
+                {
+                    cfg.block_cycles = (int32_t)block_cycles.values[y];
+
+                    for(uint32_t w = 0U; w < WORKLOAD_COUNT; w++)
+                    {
+                        if(0U != (selected & (1UL << w)))
+                        {
+                            if(0 != _run(&cfg, &sim, (size_t)mem_size, &workloads[w],
+                                         (uint32_t)scale, (uint32_t)seed))
+                            {
+                                failures++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    free(sim.mem);
+    return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
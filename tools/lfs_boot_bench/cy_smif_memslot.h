@@ -0,0 +1,101 @@
+/***************************************************************************//**
+ * \file cy_smif_memslot.h
+ *
+ * \brief
+ * Host subset of the SMIF memory slot driver used by lfs_boot_bench
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Host replacement of the SMIF memory slot declarations of the PDL for
+ * lfs_boot_bench. It declares only the types, fields and functions that
+ * lfs_spi_flash_bd.c uses. The benchmark does not configure the erase wait,
+ * so lfs_boot_bench.c implements the functions as failing stubs. It is found
+ * before the one of the PDL because this directory is first in the include
+ * path.
+ */
+
+#ifndef CY_SMIF_MEMSLOT_H            /* Guard against multiple inclusion */
+#define CY_SMIF_MEMSLOT_H
+
+#include "cy_result.h"
+#include "cy_utils.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t reserved;
+} SMIF_Type;
+
+typedef struct
+{
+    uint32_t reserved;
+} cy_stc_smif_context_t;
+
+typedef struct
+{
+    uint32_t numOfAddrBytes;
+    uint32_t memSize;
+    uint32_t eraseSize;
+    uint32_t eraseTime;
+} cy_stc_smif_mem_device_cfg_t;
+
+typedef struct
+{
+    cy_stc_smif_mem_device_cfg_t *deviceCfg;
+} cy_stc_smif_mem_config_t;
+
+typedef enum
+{
+    CY_SMIF_SUCCESS,
+    CY_SMIF_BAD_PARAM,
+} cy_en_smif_status_t;
+
+typedef enum
+{
+    CY_SMIF_NORMAL,
+    CY_SMIF_MEMORY,
+} cy_en_smif_mode_t;
+
+cy_en_smif_status_t Cy_SMIF_MemCmdWriteEnable(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+        cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_MemCmdSectorErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+        uint8_t const *sectorAddr, cy_stc_smif_context_t const *context);
+cy_en_smif_mode_t Cy_SMIF_GetMode(SMIF_Type const *base);
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base);
+bool Cy_SMIF_MemIsBusy(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+        cy_stc_smif_context_t const *context);
+
+#endif /* CY_SMIF_MEMSLOT_H */
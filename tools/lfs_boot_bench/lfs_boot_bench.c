@@ -0,0 +1,511 @@
+/***************************************************************************//**
+ * \file lfs_boot_bench.c
+ *
+ * \brief
+ * Host tool that breaks down the boot time of littlefs on serial NOR flash
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Breaks the boot-to-ready time of littlefs on serial NOR flash down into the
+ * serial-flash setup, lfs_spi_flash_bd_create() and lfs_mount(), as a function
+ * of the fill level of the filesystem.
+ *
+ * The driver and littlefs run unmodified on a simulated memory. serial-memory
+ * is replaced by the functions of this file, see mtb_serial_memory.h in this
+ * directory. Each memory command is counted and timed with a model of a quad
+ * SPI NOR flash. The SFDP discovery that mtb_serial_memory_setup() performs is
+ * not part of the driver, so the setup phase is modeled from the commands it
+ * sends: a reset, a JEDEC ID read and the SFDP table reads.
+ *
+ * Build the tool with and without LFS_SPI_FLASH_BD_FIXED_GEOMETRY to compare
+ * the discovered and the fixed geometry.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_spi_flash_bd.h"
+#include "mtb_serial_memory.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ERASED_VALUE                                (0xFFU)
+#define MAX_VALUES                                  (16U)
+#define PROG_SIZE                                   (256U)
+#define BLOCK_SIZE                                  (4096U)
+#define FILL_CHUNK_SIZE                             (4096U)
+
+#if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY)
+#define GEOMETRY_NAME                               "fixed"
+#else
+#define GEOMETRY_NAME                               "discovered"
+#endif /* #if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY) */
+
+typedef enum
+{
+    PHASE_SETUP,        /* mtb_serial_memory_setup(), modeled */
+    PHASE_CREATE,       /* lfs_spi_flash_bd_create() */
+    PHASE_MOUNT,        /* lfs_mount() */
+    PHASE_COUNT
+} phase_t;
+
+/* Timing model of the memory, in nanoseconds */
+typedef struct
+{
+    uint64_t command_ns;        /* Per command: opcode, address and dummy cycles */
+    uint64_t read_byte_ns;      /* Per byte read in quad mode */
+    uint64_t sfdp_byte_ns;      /* Per byte read in single mode, as SFDP is */
+    uint64_t reset_ns;          /* Recovery time after a software reset */
+    uint64_t page_prog_ns;      /* Per page programmed */
+    uint64_t erase_ns;          /* Per sector erased */
+} timing_t;
+
+typedef struct
+{
+    uint64_t commands;
+    uint64_t bytes;
+    uint64_t time_ns;
+} counters_t;
+
+struct mtb_serial_memory
+{
+    uint8_t *mem;
+    size_t size;
+    counters_t counters;
+};
+
+typedef struct
+{
+    long values[MAX_VALUES];
+    uint32_t count;
+} list_t;
+
+static timing_t timing =
+{
+    1000U, 40U, 160U, 30000U, 700000U, 45000000U
+};
+
+static const char *phase_names[PHASE_COUNT] = { "setup", "create", "mount" };
+
+/*******************************************************************************
+*                     Simulated serial-memory and SMIF
+*******************************************************************************/
+
+static void _charge(mtb_serial_memory_t *obj, uint64_t commands, uint64_t bytes, uint64_t time_ns)
+{
+    obj->counters.commands += commands;
+    obj->counters.bytes += bytes;
+    obj->counters.time_ns += time_ns;
+}
+
+size_t mtb_serial_memory_get_size(mtb_serial_memory_t *obj)
+{
+    /* Found at setup; no command is sent */
+    return obj->size;
+}
+
+size_t mtb_serial_memory_get_erase_size(mtb_serial_memory_t *obj, uint32_t addr)
+{
+    (void)obj;
+    (void)addr;
+    return BLOCK_SIZE;
+}
+
+size_t mtb_serial_memory_get_prog_size(mtb_serial_memory_t *obj, uint32_t addr)
+{
+    (void)obj;
+    (void)addr;
+    return PROG_SIZE;
+}
+
+cy_rslt_t mtb_serial_memory_read(mtb_serial_memory_t *obj, uint32_t addr, size_t length, uint8_t *buf)
+{
+    if((addr > obj->size) || (length > (obj->size - addr)))
+    {
+        return (cy_rslt_t)1U;
+    }
+    memcpy(buf, &obj->mem[addr], length);
+    _charge(obj, 1U, length, timing.command_ns + (timing.read_byte_ns * length));
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_serial_memory_write(mtb_serial_memory_t *obj, uint32_t addr, size_t length, const uint8_t *buf)
+{
+    if((addr > obj->size) || (length > (obj->size - addr)))
+    {
+        return (cy_rslt_t)1U;
+    }
+    for(size_t i = 0U; i < length; i++)
+    {
+        obj->mem[addr + i] &= buf[i];
+    }
+
+    /* A write enable and a program command per page */
+    uint64_t pages = (length + PROG_SIZE - 1U) / PROG_SIZE;
+    _charge(obj, 2U * pages, length, pages * ((2U * timing.command_ns) + timing.page_prog_ns));
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_serial_memory_erase(mtb_serial_memory_t *obj, uint32_t addr, size_t length)
+{
+    if((addr > obj->size) || (length > (obj->size - addr)) || (0U != (addr % BLOCK_SIZE)) ||
+       (0U != (length % BLOCK_SIZE)))
+    {
+        return (cy_rslt_t)1U;
+    }
+    memset(&obj->mem[addr], ERASED_VALUE, length);
+
+    uint64_t sectors = length / BLOCK_SIZE;
+    _charge(obj, 2U * sectors, 0U, sectors * ((2U * timing.command_ns) + timing.erase_ns));
+    return CY_RSLT_SUCCESS;
+}
+
+/* The erase wait is not configured, so the driver never sends SMIF commands
+ * itself.
+ */
+cy_en_smif_status_t Cy_SMIF_MemCmdWriteEnable(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+        cy_stc_smif_context_t const *context)
+{
+    (void)base;
+    (void)memDevice;
+    (void)context;
+    return CY_SMIF_BAD_PARAM;
+}
+
+cy_en_smif_status_t Cy_SMIF_MemCmdSectorErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+        uint8_t const *sectorAddr, cy_stc_smif_context_t const *context)
+{
+    (void)base;
+    (void)memDevice;
+    (void)sectorAddr;
+    (void)context;
+    return CY_SMIF_BAD_PARAM;
+}
+
+cy_en_smif_mode_t Cy_SMIF_GetMode(SMIF_Type const *base)
+{
+    (void)base;
+    return CY_SMIF_MEMORY;
+}
+
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base)
+{
+    (void)base;
+    return true;
+}
+
+bool Cy_SMIF_MemIsBusy(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+        cy_stc_smif_context_t const *context)
+{
+    (void)base;
+    (void)memDevice;
+    (void)context;
+    return false;
+}
+
+/* Charges the commands that mtb_serial_memory_setup() sends to discover the
+ * memory: a software reset (two commands and the recovery time), a JEDEC ID
+ * read and the SFDP reads. The parameters found are kept in the serial-memory
+ * object, which is why the driver does not send commands in create.
+ */
+static void _model_setup(mtb_serial_memory_t *obj, uint64_t sfdp_reads, uint64_t sfdp_bytes)
+{
+    _charge(obj, 2U, 0U, (2U * timing.command_ns) + timing.reset_ns);
+    _charge(obj, 1U, 3U, timing.command_ns + (3U * timing.sfdp_byte_ns));
+    _charge(obj, sfdp_reads, sfdp_bytes, (sfdp_reads * timing.command_ns) + (sfdp_bytes * timing.sfdp_byte_ns));
+}
+
+/*******************************************************************************
+*                                 Benchmark
+*******************************************************************************/
+
+static int _fill(mtb_serial_memory_t *obj, long fill)
+{
+    struct lfs_config cfg;
+    lfs_t lfs;
+    lfs_file_t file;
+    uint8_t chunk[FILL_CHUNK_SIZE];
+    int err;
+
+    memset(obj->mem, ERASED_VALUE, obj->size);
+    memset(&cfg, 0, sizeof(cfg));
+    if(CY_RSLT_SUCCESS != lfs_spi_flash_bd_create(&cfg, obj))
+    {
+        return LFS_ERR_IO;
+    }
+
+    err = lfs_format(&lfs, &cfg);
+    if(0 == err)
+    {
+        err = lfs_mount(&lfs, &cfg);
+    }
+    if(0 == err)
+    {
+        err = lfs_file_open(&lfs, &file, "/fill.bin", LFS_O_WRONLY | LFS_O_CREAT);
+        if(0 == err)
+        {
+            memset(chunk, 0x5A, sizeof(chunk));
+
+            /* Pass by pass, so lfs_fs_size() is not called for every chunk */
+            lfs_ssize_t used = lfs_fs_size(&lfs);
+            while((0 == err) && (used >= 0) && (((long)used * 100L) < (fill * (long)cfg.block_count)))
+            {
+                long chunks = (((fill * (long)cfg.block_count) / 100L) - (long)used) *
+                              (long)(cfg.block_size / FILL_CHUNK_SIZE);
+                for(long i = 0L; (0 == err) && (i < lfs_max(chunks, 1L)); i++)
+                {
+                    lfs_ssize_t res = lfs_file_write(&lfs, &file, chunk, sizeof(chunk));
+                    err = (res < 0) ? (int)res : 0;
+                }
+                if(0 == err)
+                {
+                    err = lfs_file_sync(&lfs, &file);
+                }
+                used = lfs_fs_size(&lfs);
+            }
+            if(LFS_ERR_NOSPC == err)
+            {
+                /* The filesystem is full; the fill level is as high as it goes */
+                err = 0;
+            }
+            int close_err = lfs_file_close(&lfs, &file);
+            err = (0 != err) ? err : close_err;
+        }
+        int unmount_err = lfs_unmount(&lfs);
+        err = (0 != err) ? err : unmount_err;
+    }
+
+    lfs_spi_flash_bd_destroy(&cfg);
+    return err;
+}
+
+/* Runs the boot sequence once and stores the counters of each phase */
+static int _boot(mtb_serial_memory_t *obj, uint64_t sfdp_reads, uint64_t sfdp_bytes,
+        counters_t counters[PHASE_COUNT])
+{
+    struct lfs_config cfg;
+    lfs_t lfs;
+    int err = 0;
+
+    memset(&cfg, 0, sizeof(cfg));
+    memset(&obj->counters, 0, sizeof(obj->counters));
+    _model_setup(obj, sfdp_reads, sfdp_bytes);
+    counters[PHASE_SETUP] = obj->counters;
+
+    memset(&obj->counters, 0, sizeof(obj->counters));
+    if(CY_RSLT_SUCCESS != lfs_spi_flash_bd_create(&cfg, obj))
+    {
+        err = LFS_ERR_IO;
+    }
+    counters[PHASE_CREATE] = obj->counters;
+
+    memset(&obj->counters, 0, sizeof(obj->counters));
+    if(0 == err)
+    {
+        err = lfs_mount(&lfs, &cfg);
+        if(0 == err)
+        {
+            (void)lfs_unmount(&lfs);
+        }
+        lfs_spi_flash_bd_destroy(&cfg);
+    }
+    counters[PHASE_MOUNT] = obj->counters;
+
+    return err;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options] > results.csv\n"
+        "\n"
+        "  --size N            size of the memory in bytes (default 0x800000)\n"
+        "  --fills L           comma-separated fill levels in percent (default 0,50,90)\n"
+        "  --sfdp-reads N      SFDP read commands sent by the setup (default 4)\n"
+        "  --sfdp-bytes N      SFDP bytes read by the setup (default 160)\n"
+        "  --command-ns N      time of the command phase of a transfer (default 1000)\n"
+        "  --read-byte-ns N    time per byte read in quad mode (default 40)\n"
+        "  --sfdp-byte-ns N    time per byte read in single mode (default 160)\n"
+        "  --reset-ns N        recovery time after a software reset (default 30000)\n"
+        "  --help              show this help\n"
+        "\n"
+        "Numbers can be given in decimal or with a 0x prefix.\n", name);
+}
+
+static int _parse_u64(const char *text, uint64_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 0);
+
+    if((end == text) || ('\0' != *end))
+    {
+        fprintf(stderr, "invalid number: %s\n", text);
+        return -1;
+    }
+    *value = parsed;
+    return 0;
+}
+
+static int _parse_list(const char *text, list_t *list)
+{
+    const char *p = text;
+
+    list->count = 0U;
+    while('\0' != *p)
+    {
+        char *end;
+        long value = strtol(p, &end, 0);
+
+        if((end == p) || (list->count == MAX_VALUES) || ((',' != *end) && ('\0' != *end)) ||
+           (value < 0L) || (value > 100L))
+        {
+            fprintf(stderr, "invalid list: %s\n", text);
+            return -1;
+        }
+        list->values[list->count++] = value;
+        p = (',' == *end) ? (end + 1) : end;
+    }
+    return (0U == list->count) ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        { "size",         required_argument, NULL, 's' },
+        { "fills",        required_argument, NULL, 'f' },
+        { "sfdp-reads",   required_argument, NULL, 'r' },
+        { "sfdp-bytes",   required_argument, NULL, 'b' },
+        { "command-ns",   required_argument, NULL, 'c' },
+        { "read-byte-ns", required_argument, NULL, 'q' },
+        { "sfdp-byte-ns", required_argument, NULL, 'p' },
+        { "reset-ns",     required_argument, NULL, 'x' },
+        { "help",         no_argument,       NULL, 'h' },
+        { NULL,           0,                 NULL, 0   }
+    };
+    list_t fills = { { 0L, 50L, 90L }, 3U };
+    uint64_t size = 0x800000U;
+    uint64_t sfdp_reads = 4U;
+    uint64_t sfdp_bytes = 160U;
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", long_options, NULL)))
+    {
+        int res = 0;
+
+        switch(opt)
+        {
+            case 's': res = _parse_u64(optarg, &size); break;
+            case 'f': res = _parse_list(optarg, &fills); break;
+            case 'r': res = _parse_u64(optarg, &sfdp_reads); break;
+            case 'b': res = _parse_u64(optarg, &sfdp_bytes); break;
+            case 'c': res = _parse_u64(optarg, &timing.command_ns); break;
+            case 'q': res = _parse_u64(optarg, &timing.read_byte_ns); break;
+            case 'p': res = _parse_u64(optarg, &timing.sfdp_byte_ns); break;
+            case 'x': res = _parse_u64(optarg, &timing.reset_ns); break;
+            case 'h': _usage(argv[0]); return EXIT_SUCCESS;
+            default: res = -1; break;
+        }
+        if(0 != res)
+        {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if((optind != argc) || (size < (16U * BLOCK_SIZE)) || (size > 0x10000000U) ||
+       (0U != (size % BLOCK_SIZE)))
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+#if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY)
+    if((LFS_SPI_FLASH_BD_FIXED_PROG_SIZE != PROG_SIZE) || (LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE != BLOCK_SIZE) ||
+       (size < (LFS_SPI_FLASH_BD_FIXED_ADDRESS_START +
+                ((uint64_t)LFS_SPI_FLASH_BD_FIXED_BLOCK_SIZE * LFS_SPI_FLASH_BD_FIXED_BLOCK_COUNT))))
+    {
+        fprintf(stderr, "the fixed geometry does not fit a memory of %llu bytes with %u-byte pages "
+                "and %u-byte sectors\n", (unsigned long long)size, PROG_SIZE, BLOCK_SIZE);
+        return EXIT_FAILURE;
+    }
+#endif /* #if defined(LFS_SPI_FLASH_BD_FIXED_GEOMETRY) */
+
+    mtb_serial_memory_t memory;
+    memset(&memory, 0, sizeof(memory));
+    memory.size = (size_t)size;
+    memory.mem = malloc(memory.size);
+    if(NULL == memory.mem)
+    {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("geometry,fill,phase,commands,bytes,device_us,error\n");
+
+    int status = EXIT_SUCCESS;
+    for(uint32_t f = 0U; f < fills.count; f++)
+    {
+        counters_t counters[PHASE_COUNT];
+        uint64_t total_ns = 0U;
+
+        memset(counters, 0, sizeof(counters));
+        int err = _fill(&memory, fills.values[f]);
+        if(0 == err)
+        {
+            err = _boot(&memory, sfdp_reads, sfdp_bytes, counters);
+        }
+        if(0 != err)
+        {
+            status = EXIT_FAILURE;
+        }
+
+        for(uint32_t p = 0U; p < (uint32_t)PHASE_COUNT; p++)
+        {
+            total_ns += counters[p].time_ns;
+            printf("%s,%ld,%s,%llu,%llu,%.1f,%d\n", GEOMETRY_NAME, fills.values[f], phase_names[p],
+                   (unsigned long long)counters[p].commands, (unsigned long long)counters[p].bytes,
+                   (double)counters[p].time_ns / 1000.0, err);
+        }
+        printf("%s,%ld,total,,,%.1f,%d\n", GEOMETRY_NAME, fills.values[f], (double)total_ns / 1000.0, err);
+    }
+
+    free(memory.mem);
+    return status;
+}
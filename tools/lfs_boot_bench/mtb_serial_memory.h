@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ * \file mtb_serial_memory.h
+ *
+ * \brief
+ * Host subset of serial-memory used by lfs_boot_bench
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Host replacement of serial-memory for lfs_boot_bench. It declares only the
+ * functions that lfs_spi_flash_bd.c uses, implemented on a simulated memory
+ * in lfs_boot_bench.c. It is found before the one of serial-memory because
+ * this directory is first in the include path.
+ */
+
+#ifndef MTB_SERIAL_MEMORY_H            /* Guard against multiple inclusion */
+#define MTB_SERIAL_MEMORY_H
+
+#include "cy_result.h"
+#include "cy_smif_memslot.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Defined in lfs_boot_bench.c */
+typedef struct mtb_serial_memory mtb_serial_memory_t;
+
+size_t mtb_serial_memory_get_size(mtb_serial_memory_t *obj);
+size_t mtb_serial_memory_get_erase_size(mtb_serial_memory_t *obj, uint32_t addr);
+size_t mtb_serial_memory_get_prog_size(mtb_serial_memory_t *obj, uint32_t addr);
+cy_rslt_t mtb_serial_memory_read(mtb_serial_memory_t *obj, uint32_t addr, size_t length, uint8_t *buf);
+cy_rslt_t mtb_serial_memory_write(mtb_serial_memory_t *obj, uint32_t addr, size_t length, const uint8_t *buf);
+cy_rslt_t mtb_serial_memory_erase(mtb_serial_memory_t *obj, uint32_t addr, size_t length);
+
+#endif /* MTB_SERIAL_MEMORY_H */
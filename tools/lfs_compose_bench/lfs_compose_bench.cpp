@@ -0,0 +1,315 @@
+/***************************************************************************//**
+ * \file lfs_compose_bench.cpp
+ *
+ * \brief
+ * Host tool that measures block device stacks built with lfs_bd_compose.hpp
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Measures the time per call of block device stacks built with
+ * lfs_bd_compose.hpp against the same stacks built from the C block devices.
+ * Every stack is called through its lfs_config structure, as littlefs calls
+ * it, and runs on lfs_ram_bd so that the memory takes the same time in all
+ * stacks.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#include "lfs_bd_compose.hpp"
+#include "lfs_ram_bd.h"
+#include "lfs_stats_bd.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PROG_SIZE                                   (16U)
+#define BLOCK_SIZE                                  (4096U)
+#define BLOCK_COUNT                                 (16U)
+#define SMALL_READ_SIZE                             (16U)
+#define SMALL_READ_BLOCKS                           (2U)
+#define PROG_CHUNK_SIZE                             (256U)
+
+typedef lfs_compose::BlockDevice<lfs_compose::RamBackend> cpp_ram_t;
+typedef lfs_compose::BlockDevice<lfs_compose::RamBackend, lfs_compose::Stats> cpp_stats_t;
+typedef lfs_compose::BlockDevice<lfs_compose::RamBackend, lfs_compose::LineCache<256U, 16U>,
+        lfs_compose::Stats> cpp_cache_stats_t;
+
+typedef struct
+{
+    const char *name;
+    /* Fills lfs_cfg; returns CY_RSLT_SUCCESS if successful. */
+    cy_rslt_t (*create)(struct lfs_config **lfs_cfg, const lfs_ram_bd_config_t *ram_config);
+} bench_stack_t;
+
+static uint8_t mem[BLOCK_SIZE * BLOCK_COUNT];
+static uint8_t buffer[BLOCK_SIZE];
+static uint32_t rand_state;
+
+static struct lfs_config ram_cfg;
+static lfs_ram_bd_t ram;
+static struct lfs_config stats_cfg;
+static lfs_stats_bd_t stats;
+static cpp_ram_t cpp_ram;
+static cpp_stats_t cpp_stats;
+static cpp_cache_stats_t cpp_cache_stats;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32 */
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static uint64_t _now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static cy_rslt_t _create_c_ram(struct lfs_config **lfs_cfg, const lfs_ram_bd_config_t *ram_config)
+{
+    *lfs_cfg = &ram_cfg;
+    return lfs_ram_bd_create(&ram_cfg, &ram, ram_config);
+}
+
+static cy_rslt_t _create_c_stats(struct lfs_config **lfs_cfg, const lfs_ram_bd_config_t *ram_config)
+{
+    cy_rslt_t result = lfs_ram_bd_create(&ram_cfg, &ram, ram_config);
+
+    *lfs_cfg = &stats_cfg;
+    if(CY_RSLT_SUCCESS == result)
+    {
+        result = lfs_stats_bd_create(&stats_cfg, &stats, &ram_cfg, NULL);
+        lfs_stats_bd_set_phase(&stats_cfg, 0U);
+    }
+    return result;
+}
+
+static cy_rslt_t _create_cpp_ram(struct lfs_config **lfs_cfg, const lfs_ram_bd_config_t *ram_config)
+{
+    *lfs_cfg = cpp_ram.config();
+    return cpp_ram.create(ram_config);
+}
+
+static cy_rslt_t _create_cpp_stats(struct lfs_config **lfs_cfg, const lfs_ram_bd_config_t *ram_config)
+{
+    *lfs_cfg = cpp_stats.config();
+    return cpp_stats.create(ram_config);
+}
+
+static cy_rslt_t _create_cpp_cache_stats(struct lfs_config **lfs_cfg, const lfs_ram_bd_config_t *ram_config)
+{
+    *lfs_cfg = cpp_cache_stats.config();
+    return cpp_cache_stats.create(ram_config);
+}
+
+static const bench_stack_t stacks[] =
+{
+    { "c-ram",               _create_c_ram },
+    { "c-stats-ram",         _create_c_stats },
+    { "cpp-ram",             _create_cpp_ram },
+    { "cpp-stats-ram",       _create_cpp_stats },
+    { "cpp-cache-stats-ram", _create_cpp_cache_stats },
+};
+
+#define STACK_COUNT                                 (sizeof(stacks) / sizeof(stacks[0]))
+
+/* The calls go through the function pointers of lfs_cfg, as in littlefs. The
+ * functions are not inlined into main() so that the compiler cannot resolve
+ * the pointers.
+ */
+static __attribute__((noinline)) int _small_reads(const struct lfs_config *lfs_cfg, uint32_t count)
+{
+    int err = 0;
+
+    for(uint32_t i = 0U; (i < count) && (0 == err); i++)
+    {
+        uint32_t r = _rand();
+        lfs_block_t block = r % SMALL_READ_BLOCKS;
+        lfs_off_t off = ((r >> 8) % (BLOCK_SIZE / SMALL_READ_SIZE)) * SMALL_READ_SIZE;
+
+        err = lfs_cfg->read(lfs_cfg, block, off, buffer, SMALL_READ_SIZE);
+    }
+    return err;
+}
+
+static __attribute__((noinline)) int _block_reads(const struct lfs_config *lfs_cfg, uint32_t count)
+{
+    int err = 0;
+
+    for(uint32_t i = 0U; (i < count) && (0 == err); i++)
+    {
+        err = lfs_cfg->read(lfs_cfg, i % BLOCK_COUNT, 0U, buffer, BLOCK_SIZE);
+    }
+    return err;
+}
+
+static __attribute__((noinline)) int _erase_progs(const struct lfs_config *lfs_cfg, uint32_t count)
+{
+    int err = 0;
+
+    for(uint32_t i = 0U; (i < count) && (0 == err); i++)
+    {
+        lfs_block_t block = i % BLOCK_COUNT;
+
+        err = lfs_cfg->erase(lfs_cfg, block);
+        for(lfs_off_t off = 0U; (off < BLOCK_SIZE) && (0 == err); off += PROG_CHUNK_SIZE)
+        {
+            err = lfs_cfg->prog(lfs_cfg, block, off, &buffer[off], PROG_CHUNK_SIZE);
+        }
+    }
+    return err;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "\n"
+        "  --iterations N         calls per measurement (default 1000000)\n"
+        "  --seed N               seed of the read offsets (default 1)\n"
+        "\n"
+        "Numbers can be given in decimal or with a 0x prefix.\n", name);
+}
+
+static int _parse_u32(const char *text, uint32_t *value)
+{
+    char *end;
+    unsigned long parsed = strtoul(text, &end, 0);
+
+    if((end == text) || ('\0' != *end) || (parsed > 0xFFFFFFFFUL))
+    {
+        fprintf(stderr, "invalid number: %s\n", text);
+        return -1;
+    }
+    *value = (uint32_t)parsed;
+    return 0;
+}
+
+static void _report(const char *stack, const char *op, uint32_t calls, uint64_t ns, int err)
+{
+    printf("%s,%s,%u,%.1f,%d\n", stack, op, (unsigned)calls,
+           (calls > 0U) ? ((double)ns / (double)calls) : 0.0, err);
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option options[] =
+    {
+        { "iterations", required_argument, NULL, 'n' },
+        { "seed",       required_argument, NULL, 'd' },
+        { "help",       no_argument,       NULL, 'h' },
+        { NULL,         0,                 NULL, 0   }
+    };
+    uint32_t iterations = 1000000U;
+    uint32_t seed = 1U;
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", options, NULL)))
+    {
+        int res = 0;
+
+        switch(opt)
+        {
+            case 'n': res = _parse_u32(optarg, &iterations); break;
+            case 'd': res = _parse_u32(optarg, &seed); break;
+            case 'h': _usage(argv[0]); return EXIT_SUCCESS;
+            default: res = -1; break;
+        }
+        if(0 != res)
+        {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if((optind != argc) || (0U == iterations) || (0U == seed))
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    lfs_ram_bd_config_t ram_config;
+    memset(&ram_config, 0, sizeof(ram_config));
+    ram_config.buffer = mem;
+    ram_config.prog_size = PROG_SIZE;
+    ram_config.block_size = BLOCK_SIZE;
+    ram_config.block_count = BLOCK_COUNT;
+
+    printf("stack,operation,calls,ns_per_call,error\n");
+
+    int failures = 0;
+    for(uint32_t s = 0U; s < STACK_COUNT; s++)
+    {
+        struct lfs_config *lfs_cfg;
+
+        if(CY_RSLT_SUCCESS != stacks[s].create(&lfs_cfg, &ram_config))
+        {
+            fprintf(stderr, "%s: create failed\n", stacks[s].name);
+            failures++;
+            continue;
+        }
+
+        /* The block operations move 4 KB per call, so they run fewer times. */
+        uint32_t block_calls = (iterations / 64U) + 1U;
+        uint64_t start;
+        int err;
+
+        rand_state = seed;
+        start = _now_ns();
+        err = _small_reads(lfs_cfg, iterations);
+        _report(stacks[s].name, "read-16", iterations, _now_ns() - start, err);
+        failures += (0 != err) ? 1 : 0;
+
+        start = _now_ns();
+        err = _block_reads(lfs_cfg, block_calls);
+        _report(stacks[s].name, "read-4096", block_calls, _now_ns() - start, err);
+        failures += (0 != err) ? 1 : 0;
+
+        start = _now_ns();
+        err = _erase_progs(lfs_cfg, block_calls);
+        _report(stacks[s].name, "erase-prog-4096", block_calls, _now_ns() - start, err);
+        failures += (0 != err) ? 1 : 0;
+    }
+
+    return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,431 @@
+/***************************************************************************//**
+ * \file lfs_image.c
+ *
+ * \brief
+ * Host tool that builds littlefs images with the geometry of the block device drivers
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Builds a littlefs image of a host directory for factory programming. The
+ * lfs_config structure is populated by the functions that the drivers use on
+ * the device, so the image matches the filesystem that the device mounts.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#define _DEFAULT_SOURCE
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_bd_geometry.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ERASED_VALUE                                (0xFFU)
+#define COPY_CHUNK_SIZE                             (64UL * 1024UL)
+
+typedef struct
+{
+    int fd;
+    uint8_t *erased_block;
+    uint8_t *touched;          /* One flag per block: erased or programmed */
+} image_t;
+
+typedef struct
+{
+    uint32_t files;
+    uint32_t dirs;
+    uint64_t bytes;
+} totals_t;
+
+static int _image_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    const image_t *image = lfs_cfg->context;
+    ssize_t res = pread(image->fd, buffer, size, ((off_t)block * lfs_cfg->block_size) + off);
+
+    if(res < 0)
+    {
+        return LFS_ERR_IO;
+    }
+
+    /* Past the end of the file the memory is erased */
+    memset((uint8_t *)buffer + res, ERASED_VALUE, size - (lfs_size_t)res);
+    return 0;
+}
+
+static int _image_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    image_t *image = lfs_cfg->context;
+    ssize_t res = pwrite(image->fd, buffer, size, ((off_t)block * lfs_cfg->block_size) + off);
+
+    image->touched[block] = 1U;
+    return ((ssize_t)size == res) ? 0 : LFS_ERR_IO;
+}
+
+static int _image_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    image_t *image = lfs_cfg->context;
+    ssize_t res = pwrite(image->fd, image->erased_block, lfs_cfg->block_size,
+                         (off_t)block * lfs_cfg->block_size);
+
+    image->touched[block] = 1U;
+    return ((ssize_t)lfs_cfg->block_size == res) ? 0 : LFS_ERR_IO;
+}
+
+static int _image_sync(const struct lfs_config *lfs_cfg)
+{
+    (void)lfs_cfg;
+    return 0;
+}
+
+static int _find_last_block(void *data, lfs_block_t block)
+{
+    lfs_block_t *last = data;
+
+    if(block > *last)
+    {
+        *last = block;
+    }
+    return 0;
+}
+
+/* littlefs starts the block allocator at a pseudo-random block on mount, to
+ * spread the wear across boots. For an image, the allocator is moved back to
+ * block 0 and its lookahead window dropped, so the next allocation scans from
+ * the start of the region and the content is packed at the front. The fields
+ * are internal to littlefs and were renamed in v2.9.
+ */
+static void _allocate_from_start(lfs_t *lfs)
+{
+#if (LFS_VERSION >= 0x00020009)
+    lfs->lookahead.start   = 0U;
+    lfs->lookahead.size    = 0U;
+    lfs->lookahead.next    = 0U;
+    lfs->lookahead.ckpoint = lfs->cfg->block_count;
+#else
+    lfs->free.off  = 0U;
+    lfs->free.size = 0U;
+    lfs->free.i    = 0U;
+    lfs->free.ack  = lfs->cfg->block_count;
+#endif /* #if (LFS_VERSION >= 0x00020009) */
+}
+
+static int _copy_file(lfs_t *lfs, const char *host_path, const char *lfs_path, totals_t *totals)
+{
+    static uint8_t chunk[COPY_CHUNK_SIZE];
+    lfs_file_t file;
+    int err;
+    int fd = open(host_path, O_RDONLY);
+
+    if(fd < 0)
+    {
+        fprintf(stderr, "%s: %s\n", host_path, strerror(errno));
+        return LFS_ERR_IO;
+    }
+
+    err = lfs_file_open(lfs, &file, lfs_path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_EXCL);
+    while(0 == err)
+    {
+        ssize_t count = read(fd, chunk, sizeof(chunk));
+
+        if(count <= 0)
+        {
+            err = (count < 0) ? LFS_ERR_IO : 0;
+            break;
+        }
+
+        lfs_ssize_t written = lfs_file_write(lfs, &file, chunk, (lfs_size_t)count);
+        if(written != count)
+        {
+            err = (written < 0) ? (int)written : LFS_ERR_NOSPC;
+        }
+        totals->bytes += (uint64_t)count;
+    }
+
+    if(0 == err)
+    {
+        err = lfs_file_close(lfs, &file);
+        totals->files++;
+    }
+    (void)close(fd);
+
+    if(0 != err)
+    {
+        fprintf(stderr, "%s: littlefs error %d\n", lfs_path, err);
+    }
+    return err;
+}
+
+/* Adds the entries of a directory in name order, so the image is
+ * reproducible.
+ */
+static int _add_dir(lfs_t *lfs, const char *host_dir, const char *lfs_dir, totals_t *totals)
+{
+    struct dirent **entries;
+    int err = 0;
+    int count = scandir(host_dir, &entries, NULL, alphasort);
+
+    if(count < 0)
+    {
+        fprintf(stderr, "%s: %s\n", host_dir, strerror(errno));
+        return LFS_ERR_IO;
+    }
+
+    for(int i = 0; i < count; i++)
+    {
+        const char *name = entries[i]->d_name;
+        char host_path[4096];
+        char lfs_path[4096];
+        struct stat st;
+
+        if((0 == err) && (0 != strcmp(name, ".")) && (0 != strcmp(name, "..")))
+        {
+            (void)snprintf(host_path, sizeof(host_path), "%s/%s", host_dir, name);
+            (void)snprintf(lfs_path, sizeof(lfs_path), "%s/%s", lfs_dir, name);
+
+            if(strlen(name) > LFS_NAME_MAX)
+            {
+                fprintf(stderr, "%s: name longer than %d characters\n", host_path, LFS_NAME_MAX);
+                err = LFS_ERR_NAMETOOLONG;
+            }
+            else if(0 != lstat(host_path, &st))
+            {
+                fprintf(stderr, "%s: %s\n", host_path, strerror(errno));
+                err = LFS_ERR_IO;
+            }
+            else if(S_ISDIR(st.st_mode))
+            {
+                err = lfs_mkdir(lfs, lfs_path);
+                if(0 == err)
+                {
+                    totals->dirs++;
+                    err = _add_dir(lfs, host_path, lfs_path, totals);
+                }
+            }
+            else if(S_ISREG(st.st_mode))
+            {
+                err = _copy_file(lfs, host_path, lfs_path, totals);
+            }
+            else
+            {
+                fprintf(stderr, "%s: skipped, not a regular file or directory\n", host_path);
+            }
+        }
+        free(entries[i]);
+    }
+    free(entries);
+
+    return err;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options] <source-dir> <image-file>\n"
+        "\n"
+        "Geometry of lfs_spi_flash_bd_create() (default):\n"
+        "  --prog-size N     program (page) size of the memory in bytes\n"
+        "  --erase-size N    erase (sector) size of the memory in bytes\n"
+        "  --size N          size of the region used by littlefs in bytes\n"
+        "\n"
+        "Geometry of lfs_sd_bd_create():\n"
+        "  --sd-blocks N     number of 512-byte blocks of the card\n"
+        "\n"
+        "  --trim            end the image after the last used block\n"
+        "\n"
+        "Numbers can be given in decimal or with a 0x prefix.\n", name);
+}
+
+static int _parse_size(const char *text, lfs_size_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 0);
+
+    if((end == text) || ('\0' != *end) || (0ULL == parsed) || (parsed > 0xFFFFFFFFULL))
+    {
+        fprintf(stderr, "invalid number: %s\n", text);
+        return -1;
+    }
+    *value = (lfs_size_t)parsed;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option options[] =
+    {
+        { "prog-size",  required_argument, NULL, 'p' },
+        { "erase-size", required_argument, NULL, 'e' },
+        { "size",       required_argument, NULL, 's' },
+        { "sd-blocks",  required_argument, NULL, 'd' },
+        { "trim",       no_argument,       NULL, 't' },
+        { NULL,         0,                 NULL, 0   }
+    };
+    lfs_size_t prog_size = 0U;
+    lfs_size_t erase_size = 0U;
+    lfs_size_t region_size = 0U;
+    lfs_size_t sd_blocks = 0U;
+    int trim = 0;
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", options, NULL)))
+    {
+        int res = 0;
+
+        switch(opt)
+        {
+            case 'p': res = _parse_size(optarg, &prog_size); break;
+            case 'e': res = _parse_size(optarg, &erase_size); break;
+            case 's': res = _parse_size(optarg, &region_size); break;
+            case 'd': res = _parse_size(optarg, &sd_blocks); break;
+            case 't': trim = 1; break;
+            default: res = -1; break;
+        }
+        if(0 != res)
+        {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if((argc - optind) != 2)
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct lfs_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+
+    if(0U != sd_blocks)
+    {
+        lfs_sd_bd_set_geometry(&cfg, sd_blocks);
+    }
+    else if((0U != prog_size) && (0U != erase_size) && (0U != region_size) &&
+            (0U == (erase_size % prog_size)) && (0U == (region_size % erase_size)))
+    {
+        lfs_spi_flash_bd_set_geometry(&cfg, prog_size, erase_size, region_size / erase_size);
+    }
+    else
+    {
+        fprintf(stderr, "SPI flash geometry requires --prog-size, --erase-size and --size;\n"
+                        "the erase size must be a multiple of the program size and the size\n"
+                        "a multiple of the erase size\n");
+        return EXIT_FAILURE;
+    }
+
+    image_t image;
+    image.fd = open(argv[optind + 1], O_RDWR | O_CREAT | O_TRUNC, 0644);
+    image.erased_block = malloc(cfg.block_size);
+    image.touched = calloc(cfg.block_count, 1U);
+    if((image.fd < 0) || (NULL == image.erased_block) || (NULL == image.touched))
+    {
+        fprintf(stderr, "%s: %s\n", argv[optind + 1], strerror(errno));
+        return EXIT_FAILURE;
+    }
+    memset(image.erased_block, ERASED_VALUE, cfg.block_size);
+
+    cfg.context = &image;
+    cfg.read    = _image_read;
+    cfg.prog    = _image_prog;
+    cfg.erase   = _image_erase;
+    cfg.sync    = _image_sync;
+
+    lfs_t lfs;
+    totals_t totals = { 0U, 0U, 0U };
+    lfs_block_t last_block = 0U;
+    int err = lfs_format(&lfs, &cfg);
+
+    if(0 == err)
+    {
+        err = lfs_mount(&lfs, &cfg);
+    }
+    if(0 == err)
+    {
+        _allocate_from_start(&lfs);
+        err = _add_dir(&lfs, argv[optind], "", &totals);
+        if(0 == err)
+        {
+            err = lfs_fs_traverse(&lfs, _find_last_block, &last_block);
+        }
+        int unmount_err = lfs_unmount(&lfs);
+        err = (0 == err) ? unmount_err : err;
+    }
+
+    /* The image covers the whole region unless trimmed. Blocks that littlefs
+     * did not touch are filled with the erased value, so the image programs
+     * the same content as erased memory.
+     */
+    lfs_block_t image_blocks = trim ? (last_block + 1U) : cfg.block_count;
+    for(lfs_block_t block = 0U; (0 == err) && (block < image_blocks); block++)
+    {
+        if(0U == image.touched[block])
+        {
+            err = _image_erase(&cfg, block);
+        }
+    }
+    if((0 == err) && (0 != ftruncate(image.fd, (off_t)image_blocks * cfg.block_size)))
+    {
+        err = LFS_ERR_IO;
+    }
+    (void)close(image.fd);
+
+    if(0 != err)
+    {
+        fprintf(stderr, "failed with littlefs error %d\n", err);
+        return EXIT_FAILURE;
+    }
+
+    printf("geometry: read_size %u, prog_size %u, block_size %u, block_count %u,\n"
+           "          block_cycles %d, cache_size %u, lookahead_size %u\n",
+           (unsigned)cfg.read_size, (unsigned)cfg.prog_size, (unsigned)cfg.block_size,
+           (unsigned)cfg.block_count, (int)cfg.block_cycles, (unsigned)cfg.cache_size,
+           (unsigned)cfg.lookahead_size);
+    printf("content:  %u files, %u directories, %llu bytes\n",
+           (unsigned)totals.files, (unsigned)totals.dirs, (unsigned long long)totals.bytes);
+    printf("image:    %u of %u blocks, %llu bytes\n", (unsigned)image_blocks, (unsigned)cfg.block_count,
+           (unsigned long long)image_blocks * cfg.block_size);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,547 @@
+/***************************************************************************//**
+ * \file lfs_powercut.c
+ *
+ * \brief
+ * Host tool that checks littlefs recovery after injected power losses
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Cuts the power of a littlefs filesystem on lfs_ram_bd at pseudo-random
+ * points with lfs_powercut_bd, mounts it again after each cut and checks the
+ * contents of every file. A mount failure or a file that holds neither its
+ * last committed nor its interrupted contents fails the run. The mount time
+ * and the number of block device calls of each recovery are recorded.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_ram_bd.h"
+#include "lfs_powercut_bd.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEADER_SIZE                                 (12U)
+#define MAX_FILES                                   (256U)
+#define NAME_SIZE                                   (16U)
+#define HISTOGRAM_BUCKETS                           (24U)
+#define MAX_REWRITES                                (100000U)
+
+/* Expected contents of one file. The rewrite that was running when the power
+ * was cut may or may not have been committed, so both are accepted.
+ */
+typedef struct
+{
+    uint32_t committed;     /* Generation last closed, 0 if never created */
+    uint32_t pending;       /* Generation interrupted by the cut, 0 if none */
+} file_state_t;
+
+/* Power-of-two distribution: bucket n counts values below 2^n */
+typedef struct
+{
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[HISTOGRAM_BUCKETS];
+} histogram_t;
+
+typedef struct
+{
+    uint64_t prog_size;
+    uint64_t block_size;
+    uint64_t block_count;
+    uint64_t cycles;
+    uint64_t max_ops;
+    uint64_t files;
+    uint64_t max_file_size;
+    uint64_t seed;
+    bool tear_prog;
+} options_t;
+
+static uint32_t rand_state;
+static struct timespec start_time;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, so a run is reproduced from its seed */
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static uint32_t _time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(((uint64_t)(now.tv_sec - start_time.tv_sec) * 1000000U) +
+                      (uint64_t)((now.tv_nsec - start_time.tv_nsec) / 1000));
+}
+
+static void _put_le32(uint8_t *dest, uint32_t value)
+{
+    dest[0] = (uint8_t)value;
+    dest[1] = (uint8_t)(value >> 8);
+    dest[2] = (uint8_t)(value >> 16);
+    dest[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t _get_le32(const uint8_t *src)
+{
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+           ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+/* Builds the contents of a generation of a file: its index, generation and
+ * size, followed by bytes derived from them. Returns the size.
+ */
+static uint32_t _fill(uint8_t *buffer, uint32_t index, uint32_t generation,
+        uint32_t max_file_size)
+{
+    uint32_t state = (index * 0x9E3779B9U) ^ (generation * 0x85EBCA6BU) ^ 0x5BD1E995U;
+    uint32_t size;
+
+    state = (0U == state) ? 1U : state;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    size = HEADER_SIZE + (state % (max_file_size - HEADER_SIZE + 1U));
+
+    _put_le32(buffer, index);
+    _put_le32(&buffer[4], generation);
+    _put_le32(&buffer[8], size);
+    for(uint32_t i = HEADER_SIZE; i < size; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        buffer[i] = (uint8_t)state;
+    }
+
+    return size;
+}
+
+static void _name(char *name, uint32_t index)
+{
+    snprintf(name, NAME_SIZE, "f%03u", (unsigned)index);
+}
+
+static void _histogram_add(histogram_t *histogram, uint32_t value, uint32_t count)
+{
+    uint32_t bucket = 0U;
+
+    while((bucket < (HISTOGRAM_BUCKETS - 1U)) && (value >= (1UL << bucket)))
+    {
+        bucket++;
+    }
+    histogram->buckets[bucket]++;
+    histogram->total += value;
+    histogram->min = (1U == count) ? value : lfs_min(histogram->min, value);
+    histogram->max = (1U == count) ? value : lfs_max(histogram->max, value);
+}
+
+static void _histogram_print(const char *name, const histogram_t *histogram, uint32_t count)
+{
+    printf("# %s: min %u mean %.1f max %u\n", name, (unsigned)histogram->min,
+           (double)histogram->total / count, (unsigned)histogram->max);
+    for(uint32_t i = 0U; i < HISTOGRAM_BUCKETS; i++)
+    {
+        if(0U != histogram->buckets[i])
+        {
+            printf("#   < %-10lu %u\n", 1UL << i, (unsigned)histogram->buckets[i]);
+        }
+    }
+}
+
+/* Checks that each file holds the contents of its last committed generation
+ * or of the interrupted one, and records which one it is.
+ */
+static int _check_files(lfs_t *lfs, file_state_t *files, const options_t *options,
+        uint8_t *expected, uint8_t *actual)
+{
+    for(uint32_t i = 0U; i < options->files; i++)
+    {
+        char name[NAME_SIZE];
+        lfs_file_t file;
+        file_state_t *state = &files[i];
+
+        _name(name, i);
+        int err = lfs_file_open(lfs, &file, name, LFS_O_RDONLY);
+        if(LFS_ERR_NOENT == err)
+        {
+            if(0U != state->committed)
+            {
+                fprintf(stderr, "%s: missing, generation %u was committed\n",
+                        name, (unsigned)state->committed);
+                return -1;
+            }
+            state->pending = 0U;
+            continue;
+        }
+        if(0 != err)
+        {
+            fprintf(stderr, "%s: open failed with %d\n", name, err);
+            return -1;
+        }
+
+        lfs_ssize_t size = lfs_file_read(lfs, &file, actual, (lfs_size_t)options->max_file_size + 1U);
+        err = lfs_file_close(lfs, &file);
+        if((size < 0) || (0 != err))
+        {
+            fprintf(stderr, "%s: read failed with %d\n", name, (size < 0) ? (int)size : err);
+            return -1;
+        }
+
+        /* A file created by the interrupted rewrite exists but is empty */
+        if((0 == size) && (0U == state->committed))
+        {
+            state->pending = 0U;
+            continue;
+        }
+
+        uint32_t generation = ((lfs_size_t)size >= HEADER_SIZE) ? _get_le32(&actual[4]) : 0U;
+        if((0U == generation) ||
+           ((generation != state->committed) && (generation != state->pending)))
+        {
+            fprintf(stderr, "%s: holds generation %u, expected %u or %u\n", name,
+                    (unsigned)generation, (unsigned)state->committed, (unsigned)state->pending);
+            return -1;
+        }
+
+        uint32_t expected_size = _fill(expected, i, generation, (uint32_t)options->max_file_size);
+        if(((lfs_size_t)size != expected_size) || (0 != memcmp(expected, actual, expected_size)))
+        {
+            fprintf(stderr, "%s: contents of generation %u are corrupted\n",
+                    name, (unsigned)generation);
+            return -1;
+        }
+
+        state->committed = generation;
+        state->pending = 0U;
+    }
+
+    return 0;
+}
+
+/* Rewrites random files until the power is cut. Returns the number of
+ * completed rewrites, or -1 if an operation failed while the power was on.
+ */
+static long _run_workload(lfs_t *lfs, const struct lfs_config *cut_cfg, file_state_t *files,
+        const options_t *options, uint8_t *buffer)
+{
+    long rewrites = 0;
+
+    while((rewrites < (long)MAX_REWRITES) && !lfs_powercut_bd_is_cut(cut_cfg))
+    {
+        uint32_t index = _rand() % (uint32_t)options->files;
+        file_state_t *state = &files[index];
+        uint32_t generation = state->committed + 1U;
+        uint32_t size = _fill(buffer, index, generation, (uint32_t)options->max_file_size);
+        char name[NAME_SIZE];
+        lfs_file_t file;
+
+        _name(name, index);
+        state->pending = generation;
+
+        int err = lfs_file_open(lfs, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+        if(0 == err)
+        {
+            lfs_ssize_t written = lfs_file_write(lfs, &file, buffer, size);
+            if(written < 0)
+            {
+                err = (int)written;
+            }
+            else
+            {
+                err = lfs_file_close(lfs, &file);
+            }
+        }
+
+        if(0 == err)
+        {
+            state->committed = generation;
+            state->pending = 0U;
+            rewrites++;
+        }
+        else if(!lfs_powercut_bd_is_cut(cut_cfg))
+        {
+            fprintf(stderr, "%s: rewrite failed with %d while powered\n", name, err);
+            return -1;
+        }
+        else
+        {
+            /* Power cut: the open file is abandoned */
+        }
+    }
+
+    return rewrites;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "\n"
+        "Memory:\n"
+        "  --prog-size N          program size in bytes (default 16)\n"
+        "  --block-size N         erase size in bytes (default 4096)\n"
+        "  --block-count N        number of blocks (default 64)\n"
+        "\n"
+        "Test:\n"
+        "  --cycles N             number of power cuts (default 1000)\n"
+        "  --max-ops N            upper bound of program and erase operations\n"
+        "                         before a cut (default 64)\n"
+        "  --no-tear              complete the interrupted program instead of\n"
+        "                         programming a random prefix of it\n"
+        "  --files N              number of files rewritten (default 8, max %u)\n"
+        "  --max-file-size N      largest file in bytes (default 2048)\n"
+        "  --seed N               seed of the cut points and of the workload\n"
+        "                         (default 1)\n"
+        "\n"
+        "Numbers can be given in decimal or with a 0x prefix.\n", name, MAX_FILES);
+}
+
+static int _parse_u64(const char *text, uint64_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 0);
+
+    if((end == text) || ('\0' != *end))
+    {
+        fprintf(stderr, "invalid number: %s\n", text);
+        return -1;
+    }
+    *value = parsed;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        { "prog-size",     required_argument, NULL, 'p' },
+        { "block-size",    required_argument, NULL, 'b' },
+        { "block-count",   required_argument, NULL, 'n' },
+        { "cycles",        required_argument, NULL, 'c' },
+        { "max-ops",       required_argument, NULL, 'o' },
+        { "no-tear",       no_argument,       NULL, 't' },
+        { "files",         required_argument, NULL, 'f' },
+        { "max-file-size", required_argument, NULL, 'm' },
+        { "seed",          required_argument, NULL, 'd' },
+        { "help",          no_argument,       NULL, 'h' },
+        { NULL,            0,                 NULL, 0   }
+    };
+    options_t options = { 16U, 4096U, 64U, 1000U, 64U, 8U, 2048U, 1U, true };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", long_options, NULL)))
+    {
+        int res = 0;
+
+        switch(opt)
+        {
+            case 'p': res = _parse_u64(optarg, &options.prog_size); break;
+            case 'b': res = _parse_u64(optarg, &options.block_size); break;
+            case 'n': res = _parse_u64(optarg, &options.block_count); break;
+            case 'c': res = _parse_u64(optarg, &options.cycles); break;
+            case 'o': res = _parse_u64(optarg, &options.max_ops); break;
+            case 't': options.tear_prog = false; break;
+            case 'f': res = _parse_u64(optarg, &options.files); break;
+            case 'm': res = _parse_u64(optarg, &options.max_file_size); break;
+            case 'd': res = _parse_u64(optarg, &options.seed); break;
+            case 'h': _usage(argv[0]); return EXIT_SUCCESS;
+            default: res = -1; break;
+        }
+        if(0 != res)
+        {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if((optind != argc) || (0U == options.cycles) || (0U == options.max_ops) || (0U == options.files) ||
+       (options.files > MAX_FILES) || (options.max_file_size < HEADER_SIZE) ||
+       (options.max_file_size > 0x100000U) || (0U == (uint32_t)options.seed) ||
+       ((options.block_size * options.block_count) > 0x40000000U))
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* Two generations of every file must fit, with room for the metadata */
+    if((2U * options.files * (options.max_file_size + options.block_size)) >
+       (options.block_size * options.block_count / 2U))
+    {
+        fprintf(stderr, "the files do not fit: use fewer or smaller files, or more blocks\n");
+        return EXIT_FAILURE;
+    }
+
+    uint8_t *memory = malloc(options.block_size * options.block_count);
+    uint8_t *expected = malloc(options.max_file_size + 1U);
+    uint8_t *actual = malloc(options.max_file_size + 1U);
+    file_state_t *files = calloc(options.files, sizeof(file_state_t));
+    if((NULL == memory) || (NULL == expected) || (NULL == actual) || (NULL == files))
+    {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    /* The RAM is not cleared between cycles, as a flash memory keeps its
+     * contents over a power loss, and it fails programs of bytes that are not
+     * erased, as a NOR flash would corrupt them.
+     */
+    lfs_ram_bd_config_t ram_config =
+    {
+        .buffer = memory, .prog_size = (lfs_size_t)options.prog_size,
+        .block_size = (lfs_size_t)options.block_size,
+        .block_count = (lfs_size_t)options.block_count, .retained = false, .check_nor = true
+    };
+    struct lfs_config ram_cfg;
+    lfs_ram_bd_t ram;
+    memset(&ram_cfg, 0, sizeof(ram_cfg));
+    if(CY_RSLT_SUCCESS != lfs_ram_bd_create(&ram_cfg, &ram, &ram_config))
+    {
+        fprintf(stderr, "invalid geometry\n");
+        return EXIT_FAILURE;
+    }
+
+    lfs_powercut_bd_config_t cut_config =
+    {
+        .backing = &ram_cfg, .seed = (uint32_t)options.seed,
+        .max_ops = (uint32_t)options.max_ops, .tear_prog = options.tear_prog,
+        .get_time = _time_us
+    };
+    struct lfs_config cut_cfg;
+    lfs_powercut_bd_t cut;
+    memset(&cut_cfg, 0, sizeof(cut_cfg));
+    (void)lfs_powercut_bd_create(&cut_cfg, &cut, &cut_config);
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    rand_state = (uint32_t)options.seed;
+
+    lfs_t lfs;
+    int err = lfs_format(&lfs, &cut_cfg);
+    if(0 == err)
+    {
+        err = lfs_mount(&lfs, &cut_cfg);
+    }
+    if(0 != err)
+    {
+        fprintf(stderr, "format failed with %d\n", err);
+        return EXIT_FAILURE;
+    }
+
+    printf("cycle,rewrites,mount_us,read_count,read_bytes,prog_count,erase_count\n");
+
+    histogram_t time_histogram;
+    histogram_t read_histogram;
+    memset(&time_histogram, 0, sizeof(time_histogram));
+    memset(&read_histogram, 0, sizeof(read_histogram));
+
+    int failed = 0;
+    uint32_t cycle;
+    for(cycle = 1U; (cycle <= options.cycles) && (0 == failed); cycle++)
+    {
+        lfs_powercut_bd_arm(&cut_cfg);
+        long rewrites = _run_workload(&lfs, &cut_cfg, files, &options, expected);
+        if(rewrites < 0)
+        {
+            failed = 1;
+            break;
+        }
+
+        /* The state of littlefs in RAM is lost with the power. lfs_unmount()
+         * only frees the buffers.
+         */
+        (void)lfs_unmount(&lfs);
+
+        lfs_powercut_bd_power_on(&cut_cfg);
+        err = lfs_mount(&lfs, &cut_cfg);
+        lfs_powercut_bd_recovery_done(&cut_cfg);
+        if(0 != err)
+        {
+            fprintf(stderr, "mount failed with %d\n", err);
+            failed = 1;
+            break;
+        }
+
+        lfs_powercut_bd_stats_t stats;
+        lfs_powercut_bd_get_stats(&cut_cfg, &stats);
+        /* The statistics hold the sum of the recovery times; the histogram
+         * holds the sum of the earlier ones.
+         */
+        uint32_t elapsed = (uint32_t)(stats.time_total - time_histogram.total);
+        _histogram_add(&time_histogram, elapsed, cycle);
+        _histogram_add(&read_histogram, stats.last.read_count, cycle);
+        printf("%u,%ld,%u,%u,%u,%u,%u\n", (unsigned)cycle, rewrites, (unsigned)elapsed,
+               (unsigned)stats.last.read_count, (unsigned)stats.last.read_bytes,
+               (unsigned)stats.last.prog_count, (unsigned)stats.last.erase_count);
+
+        if((0 != _check_files(&lfs, files, &options, expected, actual)) ||
+           (0U != lfs_ram_bd_get_violations(&ram_cfg)))
+        {
+            if(0U != lfs_ram_bd_get_violations(&ram_cfg))
+            {
+                fprintf(stderr, "%u programs of bytes that were not erased\n",
+                        (unsigned)lfs_ram_bd_get_violations(&ram_cfg));
+            }
+            failed = 1;
+            break;
+        }
+    }
+
+    if(0 != failed)
+    {
+        fprintf(stderr, "FAILED at cycle %u, seed %u\n", (unsigned)cycle, (unsigned)options.seed);
+    }
+    else
+    {
+        (void)lfs_unmount(&lfs);
+        _histogram_print("mount time (us)", &time_histogram, (uint32_t)options.cycles);
+        _histogram_print("mount read calls", &read_histogram, (uint32_t)options.cycles);
+    }
+
+    free(files);
+    free(actual);
+    free(expected);
+    free(memory);
+    return (0 == failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,267 @@
+/***************************************************************************//**
+ * \file lfs_restore.c
+ *
+ * \brief
+ * Host tool that restores a raw littlefs image from a snapshot
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Restores a raw image of the littlefs region from a snapshot streamed by
+ * lfs_snapshot_export(). The blocks that were free on the device are filled
+ * with the erased value. The image can be programmed with the raw memory
+ * programmer, or compared with a read-out of the memory.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_snapshot.h"
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ERASED_VALUE                                (0xFFU)
+
+typedef struct
+{
+    FILE *in;
+    uint32_t crc;
+} stream_t;
+
+static int _read(stream_t *stream, void *data, size_t size)
+{
+    if(size != fread(data, 1U, size, stream->in))
+    {
+        fprintf(stderr, "snapshot: %s\n", ferror(stream->in) ? strerror(errno) : "truncated");
+        return -1;
+    }
+    stream->crc = lfs_crc(stream->crc, data, size);
+    return 0;
+}
+
+static int _read_le32(stream_t *stream, uint32_t *value)
+{
+    uint32_t le;
+
+    if(0 != _read(stream, &le, sizeof(le)))
+    {
+        return -1;
+    }
+    *value = lfs_fromle32(le);
+    return 0;
+}
+
+/* Writes count erased blocks to the image. */
+static int _write_erased(FILE *out, const uint8_t *erased_block, uint32_t block_size, uint32_t count)
+{
+    for(uint32_t i = 0U; i < count; i++)
+    {
+        if(block_size != fwrite(erased_block, 1U, block_size, out))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options] <snapshot-file> <image-file>\n"
+        "\n"
+        "  --trim            end the image after the last block in use\n"
+        "  --help            show this help\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option options[] =
+    {
+        { "trim", no_argument, NULL, 't' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL,   0,           NULL, 0   }
+    };
+    int trim = 0;
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", options, NULL)))
+    {
+        switch(opt)
+        {
+            case 't': trim = 1; break;
+            case 'h': _usage(argv[0]); return EXIT_SUCCESS;
+            default: _usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if((argc - optind) != 2)
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    stream_t stream;
+    stream.in = fopen(argv[optind], "rb");
+    stream.crc = 0xFFFFFFFFUL;
+    if(NULL == stream.in)
+    {
+        fprintf(stderr, "%s: %s\n", argv[optind], strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    uint32_t magic, version, block_size, block_count, used_blocks;
+    if((0 != _read_le32(&stream, &magic)) || (0 != _read_le32(&stream, &version)) ||
+       (0 != _read_le32(&stream, &block_size)) || (0 != _read_le32(&stream, &block_count)) ||
+       (0 != _read_le32(&stream, &used_blocks)))
+    {
+        return EXIT_FAILURE;
+    }
+    if((LFS_SNAPSHOT_MAGIC != magic) || (LFS_SNAPSHOT_VERSION != version) ||
+       (0U == block_size) || (0U == block_count) || (used_blocks > block_count))
+    {
+        fprintf(stderr, "%s: not a snapshot of version %lu\n", argv[optind],
+                (unsigned long)LFS_SNAPSHOT_VERSION);
+        return EXIT_FAILURE;
+    }
+
+    FILE *out = fopen(argv[optind + 1], "wb");
+    uint8_t *block = malloc(block_size);
+    uint8_t *erased_block = malloc(block_size);
+    if((NULL == out) || (NULL == block) || (NULL == erased_block))
+    {
+        fprintf(stderr, "%s: %s\n", argv[optind + 1], strerror(errno));
+        return EXIT_FAILURE;
+    }
+    memset(erased_block, ERASED_VALUE, block_size);
+
+    /* The runs are in increasing block order, so the image is written in one
+     * pass: the gaps before each run are the free blocks.
+     */
+    uint32_t next = 0U;
+    uint32_t restored = 0U;
+    uint32_t runs = 0U;
+    int err = 0;
+
+    for(;;)
+    {
+        uint32_t first, count;
+
+        err = _read_le32(&stream, &first);
+        if((0 != err) || (LFS_SNAPSHOT_END == first))
+        {
+            break;
+        }
+        err = _read_le32(&stream, &count);
+        /* first is checked against block_count first, so the subtraction
+         * cannot wrap.
+         */
+        if((0 == err) && ((first < next) || (first >= block_count) || (0U == count) ||
+                          (count > (block_count - first))))
+        {
+            fprintf(stderr, "snapshot: invalid run of %lu blocks at block %lu\n",
+                    (unsigned long)count, (unsigned long)first);
+            err = -1;
+        }
+        if((0 == err) && (0 != _write_erased(out, erased_block, block_size, first - next)))
+        {
+            err = -1;
+        }
+        for(uint32_t i = 0U; (0 == err) && (i < count); i++)
+        {
+            err = _read(&stream, block, block_size);
+            if((0 == err) && (block_size != fwrite(block, 1U, block_size, out)))
+            {
+                err = -1;
+            }
+        }
+        if(0 != err)
+        {
+            break;
+        }
+        next = first + count;
+        restored += count;
+        runs++;
+    }
+
+    if(0 == err)
+    {
+        /* The CRC covers everything before it, up to the end marker. */
+        uint32_t expected = stream.crc;
+        uint32_t crc;
+
+        err = _read_le32(&stream, &crc);
+        if((0 == err) && (crc != expected))
+        {
+            fprintf(stderr, "snapshot: CRC mismatch\n");
+            err = -1;
+        }
+        else if((0 == err) && (restored != used_blocks))
+        {
+            fprintf(stderr, "snapshot: %lu blocks in the runs, %lu in the header\n",
+                    (unsigned long)restored, (unsigned long)used_blocks);
+            err = -1;
+        }
+    }
+
+    uint32_t image_blocks = trim ? next : block_count;
+    if((0 == err) && (0 != _write_erased(out, erased_block, block_size, image_blocks - next)))
+    {
+        err = -1;
+    }
+    if((0 != fclose(out)) && (0 == err))
+    {
+        err = -1;
+    }
+    (void)fclose(stream.in);
+
+    if(0 != err)
+    {
+        fprintf(stderr, "%s: not restored\n", argv[optind + 1]);
+        (void)remove(argv[optind + 1]);
+        return EXIT_FAILURE;
+    }
+
+    printf("snapshot: block_size %lu, block_count %lu, %lu blocks in use in %lu runs\n",
+           (unsigned long)block_size, (unsigned long)block_count,
+           (unsigned long)restored, (unsigned long)runs);
+    printf("image:    %lu of %lu blocks, %llu bytes\n", (unsigned long)image_blocks,
+           (unsigned long)block_count, (unsigned long long)image_blocks * block_size);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ * \file cyabs_rtos.h
+ *
+ * \brief
+ * Host subset of the RTOS abstraction used by lfs_rw_bench
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Host replacement of the RTOS abstraction for lfs_rw_bench. It declares only
+ * the types and functions that lfs_rw.c uses, implemented with POSIX threads
+ * in lfs_rw_bench.c. It is found before the one of abstraction-rtos because
+ * this directory is first in the include path.
+ */
+
+#ifndef CYABS_RTOS_H            /* Guard against multiple inclusion */
+#define CYABS_RTOS_H
+
+#include "cy_result.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CY_RTOS_NEVER_TIMEOUT                       (0xFFFFFFFFUL)
+
+typedef uint32_t cy_time_t;
+
+typedef pthread_mutex_t cy_mutex_t;
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max_count;
+} cy_semaphore_t;
+
+cy_rslt_t cy_rtos_init_mutex(cy_mutex_t *mutex);
+cy_rslt_t cy_rtos_get_mutex(cy_mutex_t *mutex, cy_time_t timeout_ms);
+cy_rslt_t cy_rtos_set_mutex(cy_mutex_t *mutex);
+cy_rslt_t cy_rtos_deinit_mutex(cy_mutex_t *mutex);
+
+cy_rslt_t cy_rtos_init_semaphore(cy_semaphore_t *sema, uint32_t max_count, uint32_t init_count);
+cy_rslt_t cy_rtos_get_semaphore(cy_semaphore_t *sema, cy_time_t timeout_ms, bool in_isr);
+cy_rslt_t cy_rtos_set_semaphore(cy_semaphore_t *sema, bool in_isr);
+cy_rslt_t cy_rtos_deinit_semaphore(cy_semaphore_t *sema);
+
+#endif                      /* Avoid multiple inclusion */
@@ -0,0 +1,640 @@
+/***************************************************************************//**
+ * \file lfs_rw_bench.c
+ *
+ * \brief
+ * Host tool that measures the reader scaling of lfs_rw
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Measures how the read throughput of lfs_rw scales with the number of reader
+ * threads. The same workload, reader threads that read small configuration
+ * files in a loop, runs first on one lfs_t behind a single mutex, as with the
+ * lock of the block device drivers, then through lfs_rw with a pool of one
+ * reader instance per thread. An optional writer rewrites one of the files
+ * periodically.
+ *
+ * The memory is simulated in RAM with a delay per read call, so the reads of
+ * the threads contend for the device as on the target. The RTOS abstraction
+ * is replaced by POSIX threads, see cyabs_rtos.h in this directory.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_rw.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ERASED_VALUE                                (0xFFU)
+#define MAX_THREADS                                 (64U)
+#define MAX_VALUES                                  (16U)
+#define PROG_SIZE                                   (256U)
+#define BLOCK_SIZE                                  (4096U)
+#define BLOCK_COUNT                                 (256U)
+#define NAME_SIZE                                   (32U)
+#define MAX_FILE_SIZE                               (4096U)
+
+typedef enum
+{
+    MODE_MUTEX,     /* One lfs_t, every operation under one mutex */
+    MODE_RW,        /* lfs_rw with one reader instance per thread */
+} bench_mode_t;
+
+typedef struct
+{
+    uint64_t read_setup_ns;    /* Per read call */
+    uint64_t read_byte_ns;     /* Per byte read */
+    uint32_t files;
+    uint32_t file_size;
+    uint32_t duration_ms;
+    uint32_t write_interval_ms;
+} options_t;
+
+/* State shared by the threads of one run */
+typedef struct
+{
+    const options_t *options;
+    bench_mode_t mode;
+    lfs_t lfs;
+    pthread_mutex_t lfs_mutex;
+    lfs_rw_t rw;
+    bool stop;                  /* Accessed with atomic built-ins */
+    uint32_t errors;
+    pthread_mutex_t errors_mutex;
+} run_t;
+
+typedef struct
+{
+    run_t *run;
+    uint32_t seed;
+    uint64_t ops;
+} thread_t;
+
+static uint8_t memory[BLOCK_SIZE * BLOCK_COUNT];
+static uint64_t read_setup_ns;
+static uint64_t read_byte_ns;
+
+
+/*******************************************************************************
+*                      RTOS abstraction on POSIX threads
+*******************************************************************************/
+
+cy_rslt_t cy_rtos_init_mutex(cy_mutex_t *mutex)
+{
+    pthread_mutexattr_t attr;
+
+    /* The mutexes of the RTOS abstraction are recursive */
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    return (0 == pthread_mutex_init(mutex, &attr)) ? CY_RSLT_SUCCESS : (cy_rslt_t)1U;
+}
+
+cy_rslt_t cy_rtos_get_mutex(cy_mutex_t *mutex, cy_time_t timeout_ms)
+{
+    (void)timeout_ms;
+    return (0 == pthread_mutex_lock(mutex)) ? CY_RSLT_SUCCESS : (cy_rslt_t)1U;
+}
+
+cy_rslt_t cy_rtos_set_mutex(cy_mutex_t *mutex)
+{
+    return (0 == pthread_mutex_unlock(mutex)) ? CY_RSLT_SUCCESS : (cy_rslt_t)1U;
+}
+
+cy_rslt_t cy_rtos_deinit_mutex(cy_mutex_t *mutex)
+{
+    return (0 == pthread_mutex_destroy(mutex)) ? CY_RSLT_SUCCESS : (cy_rslt_t)1U;
+}
+
+cy_rslt_t cy_rtos_init_semaphore(cy_semaphore_t *sema, uint32_t max_count, uint32_t init_count)
+{
+    pthread_mutex_init(&sema->mutex, NULL);
+    pthread_cond_init(&sema->cond, NULL);
+    sema->count = init_count;
+    sema->max_count = max_count;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_get_semaphore(cy_semaphore_t *sema, cy_time_t timeout_ms, bool in_isr)
+{
+    (void)timeout_ms;
+    (void)in_isr;
+
+    /* lfs_rw waits without a timeout */
+    pthread_mutex_lock(&sema->mutex);
+    while(0U == sema->count)
+    {
+        pthread_cond_wait(&sema->cond, &sema->mutex);
+    }
+    sema->count--;
+    pthread_mutex_unlock(&sema->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_set_semaphore(cy_semaphore_t *sema, bool in_isr)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    (void)in_isr;
+    pthread_mutex_lock(&sema->mutex);
+    if(sema->count < sema->max_count)
+    {
+        sema->count++;
+        pthread_cond_signal(&sema->cond);
+    }
+    else
+    {
+        result = (cy_rslt_t)1U;
+    }
+    pthread_mutex_unlock(&sema->mutex);
+    return result;
+}
+
+cy_rslt_t cy_rtos_deinit_semaphore(cy_semaphore_t *sema)
+{
+    pthread_cond_destroy(&sema->cond);
+    pthread_mutex_destroy(&sema->mutex);
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+*                              Simulated memory
+*******************************************************************************/
+
+static uint64_t _now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static void _wait_ns(uint64_t duration_ns)
+{
+    /* Busy-waits, as the CPU does while a SMIF or SDHC transfer completes;
+     * sleeping would be rounded up to the timer resolution.
+     */
+    uint64_t end = _now_ns() + duration_ns;
+
+    while(_now_ns() < end)
+    {
+    }
+}
+
+static int _sim_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    memcpy(buffer, &memory[(size_t)block * lfs_cfg->block_size + off], size);
+    _wait_ns(read_setup_ns + (read_byte_ns * size));
+    return 0;
+}
+
+static int _sim_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    uint8_t *dest = &memory[(size_t)block * lfs_cfg->block_size + off];
+    const uint8_t *src = buffer;
+
+    for(lfs_size_t i = 0U; i < size; i++)
+    {
+        dest[i] &= src[i];
+    }
+    return 0;
+}
+
+static int _sim_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    memset(&memory[(size_t)block * lfs_cfg->block_size], ERASED_VALUE, lfs_cfg->block_size);
+    return 0;
+}
+
+static int _sim_sync(const struct lfs_config *lfs_cfg)
+{
+    (void)lfs_cfg;
+    return 0;
+}
+
+
+/*******************************************************************************
+*                                  Workload
+*******************************************************************************/
+
+static void _name(char *name, uint32_t index)
+{
+    snprintf(name, NAME_SIZE, "/config/c%03u.bin", (unsigned)index);
+}
+
+static uint32_t _rand(uint32_t *state)
+{
+    /* xorshift32 */
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void _count_error(run_t *run)
+{
+    pthread_mutex_lock(&run->errors_mutex);
+    run->errors++;
+    pthread_mutex_unlock(&run->errors_mutex);
+}
+
+static lfs_ssize_t _read_file(run_t *run, const char *name, uint8_t *buffer)
+{
+    lfs_ssize_t result;
+
+    if(MODE_RW == run->mode)
+    {
+        result = lfs_rw_read_file(&run->rw, name, buffer, run->options->file_size);
+    }
+    else
+    {
+        lfs_file_t file;
+
+        pthread_mutex_lock(&run->lfs_mutex);
+        result = lfs_file_open(&run->lfs, &file, name, LFS_O_RDONLY);
+        if(0 == result)
+        {
+            result = lfs_file_read(&run->lfs, &file, buffer, run->options->file_size);
+            int err = lfs_file_close(&run->lfs, &file);
+            result = (result < 0) ? result : ((0 != err) ? err : result);
+        }
+        pthread_mutex_unlock(&run->lfs_mutex);
+    }
+
+    return result;
+}
+
+static void *_reader(void *arg)
+{
+    thread_t *thread = arg;
+    run_t *run = thread->run;
+    uint8_t buffer[MAX_FILE_SIZE];
+    char name[NAME_SIZE];
+
+    while(!__atomic_load_n(&run->stop, __ATOMIC_RELAXED))
+    {
+        _name(name, _rand(&thread->seed) % run->options->files);
+        if(_read_file(run, name, buffer) != (lfs_ssize_t)run->options->file_size)
+        {
+            _count_error(run);
+        }
+        thread->ops++;
+    }
+
+    return NULL;
+}
+
+static void *_writer(void *arg)
+{
+    thread_t *thread = arg;
+    run_t *run = thread->run;
+    uint8_t buffer[MAX_FILE_SIZE];
+    char name[NAME_SIZE];
+
+    memset(buffer, 0x5A, sizeof(buffer));
+    while(!__atomic_load_n(&run->stop, __ATOMIC_RELAXED))
+    {
+        struct timespec interval =
+        {
+            (time_t)(run->options->write_interval_ms / 1000U),
+            (long)(run->options->write_interval_ms % 1000U) * 1000000L
+        };
+        nanosleep(&interval, NULL);
+
+        _name(name, _rand(&thread->seed) % run->options->files);
+        lfs_ssize_t written;
+        if(MODE_RW == run->mode)
+        {
+            written = lfs_rw_write_file(&run->rw, name, buffer, run->options->file_size);
+        }
+        else
+        {
+            lfs_file_t file;
+
+            pthread_mutex_lock(&run->lfs_mutex);
+            written = lfs_file_open(&run->lfs, &file, name, LFS_O_WRONLY | LFS_O_TRUNC);
+            if(0 == written)
+            {
+                written = lfs_file_write(&run->lfs, &file, buffer, run->options->file_size);
+                int err = lfs_file_close(&run->lfs, &file);
+                written = (written < 0) ? written : ((0 != err) ? err : written);
+            }
+            pthread_mutex_unlock(&run->lfs_mutex);
+        }
+        if(written != (lfs_ssize_t)run->options->file_size)
+        {
+            _count_error(run);
+        }
+        thread->ops++;
+    }
+
+    return NULL;
+}
+
+/* Runs the readers, and the writer if enabled, for the duration of the test.
+ * Returns the number of completed reads, or -1 on an error.
+ */
+static int64_t _run(const struct lfs_config *cfg, const options_t *options, bench_mode_t mode,
+        uint32_t thread_count, uint64_t *writes)
+{
+    static lfs_rw_reader_t readers[MAX_THREADS];
+    static thread_t threads[MAX_THREADS + 1U];
+    pthread_t ids[MAX_THREADS + 1U];
+    run_t run;
+    uint32_t count = thread_count + ((0U != options->write_interval_ms) ? 1U : 0U);
+    int err;
+
+    memset(&run, 0, sizeof(run));
+    run.options = options;
+    run.mode = mode;
+    pthread_mutex_init(&run.lfs_mutex, NULL);
+    pthread_mutex_init(&run.errors_mutex, NULL);
+
+    err = (MODE_RW == mode) ? lfs_rw_mount(&run.rw, cfg, readers, thread_count) :
+                              lfs_mount(&run.lfs, cfg);
+    if(0 != err)
+    {
+        fprintf(stderr, "mount failed with %d\n", err);
+        return -1;
+    }
+
+    for(uint32_t i = 0U; i < count; i++)
+    {
+        threads[i].run = &run;
+        threads[i].seed = 0x9E3779B9U * (i + 1U);
+        threads[i].ops = 0U;
+        pthread_create(&ids[i], NULL, (i < thread_count) ? _reader : _writer, &threads[i]);
+    }
+
+    struct timespec duration =
+    {
+        (time_t)(options->duration_ms / 1000U), (long)(options->duration_ms % 1000U) * 1000000L
+    };
+    nanosleep(&duration, NULL);
+    __atomic_store_n(&run.stop, true, __ATOMIC_RELAXED);
+
+    uint64_t reads = 0U;
+    for(uint32_t i = 0U; i < count; i++)
+    {
+        pthread_join(ids[i], NULL);
+        if(i < thread_count)
+        {
+            reads += threads[i].ops;
+        }
+    }
+    *writes = (count > thread_count) ? threads[thread_count].ops : 0U;
+
+    err = (MODE_RW == mode) ? lfs_rw_unmount(&run.rw) : lfs_unmount(&run.lfs);
+    pthread_mutex_destroy(&run.errors_mutex);
+    pthread_mutex_destroy(&run.lfs_mutex);
+
+    if((0 != err) || (0U != run.errors))
+    {
+        fprintf(stderr, "%u operations failed\n", (unsigned)run.errors);
+        return -1;
+    }
+
+    return (int64_t)reads;
+}
+
+static int _create_files(const struct lfs_config *cfg, const options_t *options)
+{
+    uint8_t data[MAX_FILE_SIZE];
+    lfs_t lfs;
+
+    memset(memory, ERASED_VALUE, sizeof(memory));
+    memset(data, 0xA5, sizeof(data));
+
+    int err = lfs_format(&lfs, cfg);
+    if(0 == err)
+    {
+        err = lfs_mount(&lfs, cfg);
+    }
+    if(0 == err)
+    {
+        err = lfs_mkdir(&lfs, "/config");
+        for(uint32_t i = 0U; (i < options->files) && (0 == err); i++)
+        {
+            char name[NAME_SIZE];
+            lfs_file_t file;
+
+            _name(name, i);
+            err = lfs_file_open(&lfs, &file, name, LFS_O_WRONLY | LFS_O_CREAT);
+            if(0 == err)
+            {
+                lfs_ssize_t written = lfs_file_write(&lfs, &file, data, options->file_size);
+                int close_err = lfs_file_close(&lfs, &file);
+                err = (written < 0) ? (int)written : close_err;
+            }
+        }
+        int unmount_err = lfs_unmount(&lfs);
+        err = (0 == err) ? unmount_err : err;
+    }
+
+    return err;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "\n"
+        "  --threads L            comma-separated numbers of reader threads\n"
+        "                         (default 1,2,4,8, max %u)\n"
+        "  --files N              number of configuration files (default 8)\n"
+        "  --file-size N          size of each file in bytes (default 128, max %u)\n"
+        "  --read-setup-ns N      time of a read call of the memory (default 2000)\n"
+        "  --read-byte-ns N       time per byte read (default 20)\n"
+        "  --duration-ms N        time of each measurement (default 2000)\n"
+        "  --write-interval-ms N  period of a writer thread that rewrites a file;\n"
+        "                         0 disables it (default 0)\n"
+        "\n"
+        "Numbers can be given in decimal or with a 0x prefix.\n",
+        name, MAX_THREADS, MAX_FILE_SIZE);
+}
+
+static int _parse_u64(const char *text, uint64_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 0);
+
+    if((end == text) || ('\0' != *end))
+    {
+        fprintf(stderr, "invalid number: %s\n", text);
+        return -1;
+    }
+    *value = parsed;
+    return 0;
+}
+
+static int _parse_threads(const char *text, uint32_t *values, uint32_t *count)
+{
+    const char *p = text;
+
+    *count = 0U;
+    while('\0' != *p)
+    {
+        char *end;
+        unsigned long value = strtoul(p, &end, 0);
+
+        if((end == p) || (*count == MAX_VALUES) || ((',' != *end) && ('\0' != *end)) ||
+           (0U == value) || (value > MAX_THREADS))
+        {
+            fprintf(stderr, "invalid list: %s\n", text);
+            return -1;
+        }
+        values[(*count)++] = (uint32_t)value;
+        p = (',' == *end) ? (end + 1) : end;
+    }
+    return (0U == *count) ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        { "threads",           required_argument, NULL, 't' },
+        { "files",             required_argument, NULL, 'f' },
+        { "file-size",         required_argument, NULL, 's' },
+        { "read-setup-ns",     required_argument, NULL, 'r' },
+        { "read-byte-ns",      required_argument, NULL, 'b' },
+        { "duration-ms",       required_argument, NULL, 'd' },
+        { "write-interval-ms", required_argument, NULL, 'w' },
+        { "help",              no_argument,       NULL, 'h' },
+        { NULL,                0,                 NULL, 0   }
+    };
+    uint32_t thread_counts[MAX_VALUES] = { 1U, 2U, 4U, 8U };
+    uint32_t thread_count_count = 4U;
+    uint64_t files = 8U;
+    uint64_t file_size = 128U;
+    uint64_t duration_ms = 2000U;
+    uint64_t write_interval_ms = 0U;
+    int opt;
+
+    read_setup_ns = 2000U;
+    read_byte_ns = 20U;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", long_options, NULL)))
+    {
+        int res = 0;
+
+        switch(opt)
+        {
+            case 't': res = _parse_threads(optarg, thread_counts, &thread_count_count); break;
+            case 'f': res = _parse_u64(optarg, &files); break;
+            case 's': res = _parse_u64(optarg, &file_size); break;
+            case 'r': res = _parse_u64(optarg, &read_setup_ns); break;
+            case 'b': res = _parse_u64(optarg, &read_byte_ns); break;
+            case 'd': res = _parse_u64(optarg, &duration_ms); break;
+            case 'w': res = _parse_u64(optarg, &write_interval_ms); break;
+            case 'h': _usage(argv[0]); return EXIT_SUCCESS;
+            default: res = -1; break;
+        }
+        if(0 != res)
+        {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if((optind != argc) || (0U == files) || (files > 1000U) || (0U == file_size) ||
+       (file_size > MAX_FILE_SIZE) || (0U == duration_ms) || (duration_ms > 3600000U) ||
+       (write_interval_ms > 3600000U))
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    options_t options =
+    {
+        read_setup_ns, read_byte_ns, (uint32_t)files, (uint32_t)file_size,
+        (uint32_t)duration_ms, (uint32_t)write_interval_ms
+    };
+
+    /* The tuning of lfs_spi_flash_bd_create() for a 256-byte page */
+    struct lfs_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.read           = _sim_read;
+    cfg.prog           = _sim_prog;
+    cfg.erase          = _sim_erase;
+    cfg.sync           = _sim_sync;
+    cfg.read_size      = 1U;
+    cfg.prog_size      = PROG_SIZE;
+    cfg.block_size     = BLOCK_SIZE;
+    cfg.block_count    = BLOCK_COUNT;
+    cfg.block_cycles   = 512;
+    cfg.cache_size     = PROG_SIZE;
+    cfg.lookahead_size = 64U;
+
+    int err = _create_files(&cfg, &options);
+    if(0 != err)
+    {
+        fprintf(stderr, "creating the files failed with %d\n", err);
+        return EXIT_FAILURE;
+    }
+
+    printf("mode,threads,reads,reads_per_s,speedup,writes\n");
+
+    for(uint32_t m = 0U; m < 2U; m++)
+    {
+        bench_mode_t mode = (0U == m) ? MODE_MUTEX : MODE_RW;
+        double base = 0.0;
+
+        for(uint32_t t = 0U; t < thread_count_count; t++)
+        {
+            uint64_t writes = 0U;
+            int64_t reads = _run(&cfg, &options, mode, thread_counts[t], &writes);
+            if(reads < 0)
+            {
+                return EXIT_FAILURE;
+            }
+
+            double rate = (double)reads * 1000.0 / (double)options.duration_ms;
+            base = (0U == t) ? rate : base;
+            printf("%s,%u,%lld,%.0f,%.2f,%llu\n", (MODE_RW == mode) ? "lfs_rw" : "mutex",
+                   (unsigned)thread_counts[t], (long long)reads, rate,
+                   (base > 0.0) ? (rate / base) : 0.0, (unsigned long long)writes);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,595 @@
+/***************************************************************************//**
+ * \file lfs_stats_bench.c
+ *
+ * \brief
+ * Host tool that measures the mount and first-open cost of littlefs
+ *
+ *******************************************************************************
+ * \copyright
+ * (c) (2026), Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+/* Measures the cost of lfs_mount() and of the first lfs_file_open() as a
+ * function of the fill level, the number of files and the directory depth,
+ * for the geometry and tuning of lfs_spi_flash_bd_create() and of
+ * lfs_sd_bd_create(). The filesystem runs on a simulated memory behind
+ * lfs_stats_bd, which counts the block device calls of each phase. The CRC
+ * work is counted by this tool's own lfs_crc(), which replaces the one of
+ * lfs_util.c.
+ *
+ * The tool runs on Linux and is not part of the ModusToolbox build. See
+ * README.md in this directory.
+ */
+
+#include "lfs.h"
+#include "lfs_util.h"
+#include "lfs_bd_geometry.h"
+#include "lfs_stats_bd.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ERASED_VALUE                                (0xFFU)
+#define MAX_VALUES                                  (16U)
+#define PHASE_MOUNT                                 (0U)
+#define PHASE_OPEN                                  (1U)
+#define PHASE_COUNT                                 (2U)
+#define SPI_PROG_SIZE                               (256U)
+#define SPI_BLOCK_SIZE                              (4096U)
+#define FILE_SIZE                                   (64U)
+#define FILL_CHUNK_SIZE                             (4096U)
+#define PATH_SIZE                                   (128U)
+
+/* Timing model of a memory, in nanoseconds */
+typedef struct
+{
+    uint64_t read_setup_ns;    /* Per read command */
+    uint64_t read_byte_ns;     /* Per byte read */
+    uint64_t prog_setup_ns;    /* Per program command */
+    uint64_t prog_byte_ns;     /* Per byte programmed */
+    uint64_t erase_ns;         /* Per erase */
+} timing_t;
+
+typedef struct
+{
+    const char *name;
+    timing_t timing;
+    uint64_t default_size;
+} driver_t;
+
+/* Simulated memory */
+typedef struct
+{
+    uint8_t *mem;
+    const timing_t *timing;
+    uint64_t time_ns;
+} sim_t;
+
+typedef struct
+{
+    long values[MAX_VALUES];
+    uint32_t count;
+} list_t;
+
+/* The serial NOR flash model approximates a quad SPI memory at 50 MHz, the
+ * SD card model a card in 4-bit mode at 25 MHz.
+ */
+static const driver_t drivers[] =
+{
+    { "spi", { 1000U, 20U, 2000U, 1600U, 45000000U }, 0x800000U },
+    { "sd",  { 150000U, 80U, 250000U, 80U, 0U }, 0x1000000U },
+};
+#define DRIVER_COUNT                                (sizeof(drivers) / sizeof(drivers[0]))
+
+static uint32_t rand_state;
+static uint64_t crc_calls;
+static uint64_t crc_bytes;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, so every configuration gets the same data */
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+/* Replaces lfs_crc() of lfs_util.c to count the CRC work of littlefs */
+uint32_t lfs_crc(uint32_t crc, const void *buffer, size_t size)
+{
+    static const uint32_t rtable[16] =
+    {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+        0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+        0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+    };
+    const uint8_t *data = buffer;
+
+    for(size_t i = 0U; i < size; i++)
+    {
+        crc = (crc >> 4) ^ rtable[(crc ^ (data[i] >> 0)) & 0xf];
+        crc = (crc >> 4) ^ rtable[(crc ^ (data[i] >> 4)) & 0xf];
+    }
+
+    crc_calls++;
+    crc_bytes += size;
+    return crc;
+}
+
+static int _sim_read(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    sim_t *sim = lfs_cfg->context;
+
+    memcpy(buffer, &sim->mem[(size_t)block * lfs_cfg->block_size + off], size);
+    sim->time_ns += sim->timing->read_setup_ns + (sim->timing->read_byte_ns * size);
+    return 0;
+}
+
+static int _sim_prog(const struct lfs_config *lfs_cfg, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    sim_t *sim = lfs_cfg->context;
+
+    memcpy(&sim->mem[(size_t)block * lfs_cfg->block_size + off], buffer, size);
+    sim->time_ns += sim->timing->prog_setup_ns + (sim->timing->prog_byte_ns * size);
+    return 0;
+}
+
+static int _sim_erase(const struct lfs_config *lfs_cfg, lfs_block_t block)
+{
+    sim_t *sim = lfs_cfg->context;
+
+    /* An SD card has no erase time: lfs_sd_bd_create() installs an erase
+     * that does nothing.
+     */
+    if(0U != sim->timing->erase_ns)
+    {
+        memset(&sim->mem[(size_t)block * lfs_cfg->block_size], ERASED_VALUE, lfs_cfg->block_size);
+        sim->time_ns += sim->timing->erase_ns;
+    }
+    return 0;
+}
+
+static int _sim_sync(const struct lfs_config *lfs_cfg)
+{
+    (void)lfs_cfg;
+    return 0;
+}
+
+static void _dir_path(char *path, uint32_t depth)
+{
+    size_t length = 0U;
+
+    path[0] = '\0';
+    for(uint32_t i = 0U; i < depth; i++)
+    {
+        length += (size_t)snprintf(&path[length], PATH_SIZE - length, "/d%u", (unsigned)i);
+    }
+}
+
+/* Creates the directories and the files, then adds a file of random data until
+ * the filesystem reaches the fill level.
+ */
+static int _populate(lfs_t *lfs, const struct lfs_config *cfg, uint32_t fill_pct,
+        uint32_t files, uint32_t depth, char *first_file)
+{
+    static uint8_t data[FILL_CHUNK_SIZE];
+    char path[PATH_SIZE];
+    lfs_file_t file;
+    int err = 0;
+
+    for(size_t i = 0U; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)_rand();
+    }
+
+    for(uint32_t d = 1U; (d <= depth) && (0 == err); d++)
+    {
+        _dir_path(path, d);
+        err = lfs_mkdir(lfs, path);
+    }
+
+    _dir_path(path, depth);
+    for(uint32_t f = 0U; (f < files) && (0 == err); f++)
+    {
+        char name[PATH_SIZE];
+
+        snprintf(name, sizeof(name), "%s/f%05u", path, (unsigned)f);
+        if(0U == f)
+        {
+            strcpy(first_file, name);
+        }
+        err = lfs_file_open(lfs, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+        if(0 == err)
+        {
+            lfs_ssize_t written = lfs_file_write(lfs, &file, data, FILE_SIZE);
+            int close_err = lfs_file_close(lfs, &file);
+            err = (written < 0) ? (int)written : close_err;
+        }
+    }
+
+    if((0 == err) && (0U != fill_pct))
+    {
+        err = lfs_file_open(lfs, &file, "/fill.bin", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+        if(0 == err)
+        {
+            /* Each pass writes the missing blocks; the blocks of the file
+             * structure make a few passes necessary.
+             */
+            uint64_t target = ((uint64_t)cfg->block_count * fill_pct) / 100U;
+            lfs_ssize_t used = lfs_fs_size(lfs);
+            while((0 == err) && (used >= 0) && ((uint64_t)used < target))
+            {
+                uint64_t remaining = (target - (uint64_t)used) * cfg->block_size;
+                for(uint64_t written = 0U; (written < remaining) && (0 == err);
+                    written += sizeof(data))
+                {
+                    lfs_ssize_t res = lfs_file_write(lfs, &file, data, sizeof(data));
+                    err = (res < 0) ? (int)res : 0;
+                }
+                err = (0 == err) ? lfs_file_sync(lfs, &file) : err;
+                used = lfs_fs_size(lfs);
+            }
+            int close_err = lfs_file_close(lfs, &file);
+            err = (0 == err) ? ((used < 0) ? (int)used : close_err) : err;
+        }
+    }
+
+    return err;
+}
+
+static int _run(const driver_t *driver, sim_t *sim, uint64_t size, long cache_size,
+        long lookahead_size, uint32_t fill_pct, uint32_t files, uint32_t depth, uint32_t seed)
+{
+    struct lfs_config sim_cfg;
+    struct lfs_config cfg;
+    lfs_stats_bd_t stats;
+    lfs_t lfs;
+    char first_file[PATH_SIZE] = "/";
+
+    memset(&sim_cfg, 0, sizeof(sim_cfg));
+    if(0 == strcmp(driver->name, "spi"))
+    {
+        lfs_spi_flash_bd_set_geometry(&sim_cfg, SPI_PROG_SIZE, SPI_BLOCK_SIZE,
+                                      (lfs_size_t)(size / SPI_BLOCK_SIZE));
+    }
+    else
+    {
+        lfs_sd_bd_set_geometry(&sim_cfg, (lfs_size_t)(size / LFS_SD_BD_BLOCK_SIZE));
+    }
+    sim_cfg.context = sim;
+    sim_cfg.read    = _sim_read;
+    sim_cfg.prog    = _sim_prog;
+    sim_cfg.erase   = _sim_erase;
+    sim_cfg.sync    = _sim_sync;
+
+    /* Zero keeps the value of the create function */
+    if(cache_size > 0)
+    {
+        sim_cfg.cache_size = (lfs_size_t)cache_size;
+    }
+    if(lookahead_size > 0)
+    {
+        sim_cfg.lookahead_size = (lfs_size_t)lookahead_size;
+    }
+    if((0U != (sim_cfg.cache_size % sim_cfg.prog_size)) ||
+       (0U != (sim_cfg.block_size % sim_cfg.cache_size)) ||
+       (0U != (sim_cfg.lookahead_size % 8U)))
+    {
+        fprintf(stderr, "skipped %s with cache size %ld and lookahead size %ld: not valid "
+                        "for the geometry\n", driver->name, cache_size, lookahead_size);
+        return 0;
+    }
+
+    memset(&cfg, 0, sizeof(cfg));
+    (void)lfs_stats_bd_create(&cfg, &stats, &sim_cfg, NULL);
+
+    sim->timing = &driver->timing;
+    memset(sim->mem, ERASED_VALUE, (size_t)size);
+    rand_state = seed;
+
+    int err = lfs_format(&lfs, &cfg);
+    if(0 == err)
+    {
+        err = lfs_mount(&lfs, &cfg);
+    }
+    if(0 == err)
+    {
+        err = _populate(&lfs, &cfg, fill_pct, files, depth, first_file);
+        int unmount_err = lfs_unmount(&lfs);
+        err = (0 == err) ? unmount_err : err;
+    }
+    if(0 != err)
+    {
+        fprintf(stderr, "%s: populating %u%% with %u files at depth %u failed with %d\n",
+                driver->name, (unsigned)fill_pct, (unsigned)files, (unsigned)depth, err);
+        return err;
+    }
+
+    /* The phases measured at boot. The driver is already created: its create
+     * function does not go through the block device interface.
+     */
+    uint64_t time_ns[PHASE_COUNT];
+    uint64_t crcs[PHASE_COUNT];
+    uint64_t crc_sizes[PHASE_COUNT];
+    lfs_file_t file;
+
+    lfs_stats_bd_reset(&cfg);
+    for(uint32_t phase = 0U; (phase < PHASE_COUNT) && (0 == err); phase++)
+    {
+        uint64_t start_ns = sim->time_ns;
+        uint64_t start_calls = crc_calls;
+        uint64_t start_bytes = crc_bytes;
+
+        lfs_stats_bd_set_phase(&cfg, phase);
+        if(PHASE_MOUNT == phase)
+        {
+            err = lfs_mount(&lfs, &cfg);
+        }
+        else if(0U != files)
+        {
+            err = lfs_file_open(&lfs, &file, first_file, LFS_O_RDONLY);
+            if(0 == err)
+            {
+                err = lfs_file_close(&lfs, &file);
+            }
+        }
+        else
+        {
+            /* No file to open */
+        }
+        lfs_stats_bd_set_phase(&cfg, LFS_STATS_BD_NO_PHASE);
+
+        time_ns[phase] = sim->time_ns - start_ns;
+        crcs[phase] = crc_calls - start_calls;
+        crc_sizes[phase] = crc_bytes - start_bytes;
+    }
+    if(0 == err)
+    {
+        err = lfs_unmount(&lfs);
+    }
+
+    for(uint32_t phase = 0U; phase < PHASE_COUNT; phase++)
+    {
+        lfs_stats_bd_counters_t counters;
+
+        lfs_stats_bd_get_phase(&cfg, phase, &counters);
+        printf("%s,%u,%u,%u,%u,%u,%u,%u,%s,%u,%u,%u,%llu,%llu,%.1f,%.3f,%d\n",
+               driver->name, (unsigned)cfg.block_size, (unsigned)cfg.block_count,
+               (unsigned)cfg.cache_size, (unsigned)cfg.lookahead_size, (unsigned)fill_pct,
+               (unsigned)files, (unsigned)depth, (PHASE_MOUNT == phase) ? "mount" : "first-open",
+               (unsigned)counters.read_count, (unsigned)counters.read_bytes,
+               (unsigned)counters.block_scans, (unsigned long long)crcs[phase],
+               (unsigned long long)crc_sizes[phase],
+               (double)crc_sizes[phase] / (double)cfg.block_size,
+               (double)time_ns[phase] / 1e6, err);
+    }
+
+    lfs_stats_bd_destroy(&cfg);
+    return err;
+}
+
+static void _usage(const char *name)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "\n"
+        "  --drivers L            subset of spi,sd (default spi,sd)\n"
+        "  --spi-size N           size of the serial flash region in bytes\n"
+        "                         (default 0x800000)\n"
+        "  --sd-size N            size of the SD card region in bytes\n"
+        "                         (default 0x1000000)\n"
+        "\n"
+        "Sweep, as comma-separated lists:\n"
+        "  --fills L              fill levels in percent (default 0,25,50,75,90)\n"
+        "  --files L              numbers of %u-byte files (default 1,10,100,1000)\n"
+        "  --depths L             directory depths of the files (default 0,2,8)\n"
+        "  --cache-sizes L        cache sizes in bytes, 0 for the value of the create\n"
+        "                         function (default 0)\n"
+        "  --lookahead-sizes L    lookahead sizes in bytes, 0 for the value of the\n"
+        "                         create function (default 0)\n"
+        "\n"
+        "  --seed N               seed of the random data (default 1)\n"
+        "\n"
+        "Numbers can be given in decimal or with a 0x prefix.\n", name, FILE_SIZE);
+}
+
+static int _parse_list(const char *text, list_t *list)
+{
+    const char *p = text;
+
+    list->count = 0U;
+    while('\0' != *p)
+    {
+        char *end;
+        long value = strtol(p, &end, 0);
+
+        if((end == p) || (list->count == MAX_VALUES) || ((',' != *end) && ('\0' != *end)) ||
+           (value < 0))
+        {
+            fprintf(stderr, "invalid list: %s\n", text);
+            return -1;
+        }
+        list->values[list->count++] = value;
+        p = (',' == *end) ? (end + 1) : end;
+    }
+    return (0U == list->count) ? -1 : 0;
+}
+
+static int _parse_u64(const char *text, uint64_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 0);
+
+    if((end == text) || ('\0' != *end))
+    {
+        fprintf(stderr, "invalid number: %s\n", text);
+        return -1;
+    }
+    *value = parsed;
+    return 0;
+}
+
+static uint32_t _select_drivers(const char *text)
+{
+    uint32_t selected = 0U;
+    char copy[64];
+
+    snprintf(copy, sizeof(copy), "%s", text);
+    for(char *name = strtok(copy, ","); NULL != name; name = strtok(NULL, ","))
+    {
+        uint32_t d;
+        for(d = 0U; (d < DRIVER_COUNT) && (0 != strcmp(name, drivers[d].name)); d++)
+        {
+        }
+        if(d == DRIVER_COUNT)
+        {
+            fprintf(stderr, "unknown driver: %s\n", name);
+            return 0U;
+        }
+        selected |= 1UL << d;
+    }
+    return selected;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct option options[] =
+    {
+        { "drivers",         required_argument, NULL, 'D' },
+        { "spi-size",        required_argument, NULL, 'S' },
+        { "sd-size",         required_argument, NULL, 's' },
+        { "fills",           required_argument, NULL, 'F' },
+        { "files",           required_argument, NULL, 'f' },
+        { "depths",          required_argument, NULL, 'p' },
+        { "cache-sizes",     required_argument, NULL, 'C' },
+        { "lookahead-sizes", required_argument, NULL, 'L' },
+        { "seed",            required_argument, NULL, 'd' },
+        { "help",            no_argument,       NULL, 'h' },
+        { NULL,              0,                 NULL, 0   }
+    };
+    uint64_t sizes[DRIVER_COUNT] = { drivers[0].default_size, drivers[1].default_size };
+    uint64_t seed = 1U;
+    uint32_t selected = (1UL << DRIVER_COUNT) - 1U;
+    list_t fills = { { 0, 25, 50, 75, 90 }, 5U };
+    list_t file_counts = { { 1, 10, 100, 1000 }, 4U };
+    list_t depths = { { 0, 2, 8 }, 3U };
+    list_t cache_sizes = { { 0 }, 1U };
+    list_t lookahead_sizes = { { 0 }, 1U };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "", options, NULL)))
+    {
+        int res = 0;
+
+        switch(opt)
+        {
+            case 'D': selected = _select_drivers(optarg); res = (0U == selected) ? -1 : 0; break;
+            case 'S': res = _parse_u64(optarg, &sizes[0]); break;
+            case 's': res = _parse_u64(optarg, &sizes[1]); break;
+            case 'F': res = _parse_list(optarg, &fills); break;
+            case 'f': res = _parse_list(optarg, &file_counts); break;
+            case 'p': res = _parse_list(optarg, &depths); break;
+            case 'C': res = _parse_list(optarg, &cache_sizes); break;
+            case 'L': res = _parse_list(optarg, &lookahead_sizes); break;
+            case 'd': res = _parse_u64(optarg, &seed); break;
+            case 'h': _usage(argv[0]); return EXIT_SUCCESS;
+            default: res = -1; break;
+        }
+        if(0 != res)
+        {
+            _usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if((optind != argc) || (0U == (uint32_t)seed) ||
+       (0U != (sizes[0] % SPI_BLOCK_SIZE)) || (0U != (sizes[1] % LFS_SD_BD_BLOCK_SIZE)) ||
+       (sizes[0] < (16U * SPI_BLOCK_SIZE)) || (sizes[1] < (16U * LFS_SD_BD_BLOCK_SIZE)) ||
+       (sizes[0] > 0x40000000U) || (sizes[1] > 0x40000000U))
+    {
+        _usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("driver,block_size,block_count,cache_size,lookahead_size,fill_pct,files,depth,"
+           "phase,read_count,read_bytes,block_scans,crc_calls,crc_bytes,crc_blocks,"
+           "device_ms,error\n");
+
+    int failures = 0;
+    for(uint32_t d = 0U; d < DRIVER_COUNT; d++)
+    {
+        if(0U == (selected & (1UL << d)))
+        {
+            continue;
+        }
+
+        sim_t sim;
+        memset(&sim, 0, sizeof(sim));
+        sim.mem = malloc((size_t)sizes[d]);
+        if(NULL == sim.mem)
+        {
+            fprintf(stderr, "out of memory\n");
+            return EXIT_FAILURE;
+        }
+
+        for(uint32_t c = 0U; c < cache_sizes.count; c++)
+        {
+            for(uint32_t l = 0U; l < lookahead_sizes.count; l++)
+            {
+                for(uint32_t fl = 0U; fl < fills.count; fl++)
+                {
+                    for(uint32_t fc = 0U; fc < file_counts.count; fc++)
+                    {
+                        for(uint32_t dp = 0U; dp < depths.count; dp++)
+                        {
+                            if(0 != _run(&drivers[d], &sim, sizes[d], cache_sizes.values[c],
+                                         lookahead_sizes.values[l], (uint32_t)fills.values[fl],
+                                         (uint32_t)file_counts.values[fc],
+                                         (uint32_t)depths.values[dp], (uint32_t)seed))
+                            {
+                                failures++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        free(sim.mem);
+    }
+
+    return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}